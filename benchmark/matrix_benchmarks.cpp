@@ -6,13 +6,19 @@
  */
 
 #include "make_test_data.hpp"
+#include <psst/math/affine_matrix.hpp>
+#include <psst/math/dynamic_matrix.hpp>
 #include <psst/math/matrix.hpp>
 #include <psst/math/matrix_io.hpp>
+#include <psst/math/matrix_solve.hpp>
+#include <psst/math/point_transform.hpp>
 #include <psst/math/vector.hpp>
 #include <psst/math/vector_io.hpp>
 
 #include <benchmark/benchmark.h>
 
+#include <vector>
+
 namespace psst {
 namespace math {
 namespace bench {
@@ -167,6 +173,507 @@ MatrixMultiply(benchmark::State& state)
     state.SetComplexityN(left_traits::size * right_traits::size);
 }
 
+/**
+ * Product of two matrices evaluated to a matrix
+ */
+template <typename LMatrix, typename RMatrix = LMatrix>
+void
+MatrixMultiplyEval(benchmark::State& state)
+{
+    using left_traits  = traits::matrix_traits<LMatrix>;
+    using right_traits = traits::matrix_traits<RMatrix>;
+    LMatrix lhs
+        = make_test_matrix<typename left_traits::value_type>(typename left_traits::size_type{});
+    RMatrix rhs
+        = make_test_matrix<typename right_traits::value_type>(typename right_traits::size_type{});
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(lhs);
+        auto res = eval(lhs * rhs);
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetComplexityN(left_traits::size * right_traits::size);
+}
+
+/**
+ * Accumulation of products to a matrix, m += a * b. With noalias the
+ * product elements are added in place, otherwise the product is evaluated
+ * to a temporary matrix first.
+ */
+template <typename Matrix, bool NoAlias>
+void
+MatrixMultiplyAdd(benchmark::State& state)
+{
+    using traits_type = traits::matrix_traits<Matrix>;
+    Matrix lhs
+        = make_test_matrix<typename traits_type::value_type>(typename traits_type::size_type{});
+    Matrix rhs
+        = make_test_matrix<typename traits_type::value_type>(typename traits_type::size_type{});
+    Matrix res;
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(lhs);
+        if constexpr (NoAlias) {
+            noalias(res) += lhs * rhs;
+        } else {
+            res += lhs * rhs;
+        }
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetComplexityN(traits_type::size);
+}
+
+/**
+ * Product of a matrix and column vectors evaluated to vectors, a buffer of
+ * points transformed by the same matrix
+ */
+template <typename Matrix>
+void
+MatrixColMultiplyEval(benchmark::State& state)
+{
+    using traits_type = traits::matrix_traits<Matrix>;
+    using value_type  = typename traits_type::value_type;
+    using vector_type = vector<value_type, traits_type::cols, components::xyzw>;
+    Matrix const m    = make_test_matrix<value_type>(typename traits_type::size_type{});
+    std::vector<vector_type> src(state.range(0),
+                                 make_test_vector<value_type>(dimension_count<traits_type::cols>{}));
+    std::vector<vector_type> dst(src.size());
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < src.size(); ++i) {
+            dst[i] = as_vector(m * src[i]);
+        }
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * src.size());
+}
+
+/**
+ * Points in a memory buffer transformed one by one with a matrix by vector
+ * product
+ */
+template <typename T>
+void
+TransformPointsLoop(benchmark::State& state)
+{
+    using vector_type = vector<T, 3>;
+    matrix<T, 4, 4> const    m = make_test_matrix<T>(traits::matrix_size<4, 4>{});
+    std::vector<vector_type> src(state.range(0), vector_type{1, 2, 3});
+    std::vector<vector_type> dst(src.size());
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < src.size(); ++i) {
+            vector<T, 4> const p = as_vector(m * vector<T, 4>{src[i][0], src[i][1], src[i][2], 1});
+            dst[i]               = vector_type{p[0], p[1], p[2]};
+        }
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * src.size());
+}
+
+/**
+ * Points in a memory buffer transformed with transform_points, the second
+ * argument is the number of threads
+ */
+template <typename T>
+void
+TransformPoints(benchmark::State& state)
+{
+    using vector_type = vector<T, 3>;
+    matrix<T, 4, 4> const    m = make_test_matrix<T>(traits::matrix_size<4, 4>{});
+    std::vector<vector_type> src(state.range(0), vector_type{1, 2, 3});
+    std::vector<vector_type> dst(src.size());
+    auto const in  = make_memory_vector_view<vector_type>(src.data()->data(), src.size() * 3);
+    auto const out = make_memory_vector_view<vector_type>(dst.data()->data(), dst.size() * 3);
+    while (state.KeepRunning()) {
+        transform_points(m, in, out, state.range(1));
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * src.size());
+}
+
+/**
+ * Fill a matrix with small values, the data is the same for fixed and dynamic
+ * matrices
+ */
+template <typename Matrix>
+void
+fill_gemm_matrix(Matrix& m, std::size_t rows, std::size_t cols)
+{
+    using value_type = std::decay_t<decltype(m[0][0])>;
+    for (std::size_t r = 0; r < rows; ++r) {
+        for (std::size_t c = 0; c < cols; ++c) {
+            m[r][c] = static_cast<value_type>((r * 7 + c * 3) % 17) / 16;
+        }
+    }
+}
+
+template <typename Matrix>
+void
+set_gemm_counters(benchmark::State& state, std::size_t n)
+{
+    state.counters["FLOPS"] = benchmark::Counter(
+        static_cast<double>(2 * n * n * n) * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+/**
+ * Reference for the matrix product, a triple loop of dot products of a row
+ * and a strided column
+ */
+template <typename T, typename Matrix>
+void
+naive_multiply(Matrix const& a, Matrix const& b, Matrix& res, std::size_t n)
+{
+    for (std::size_t r = 0; r < n; ++r) {
+        for (std::size_t c = 0; c < n; ++c) {
+            T sum{0};
+            for (std::size_t k = 0; k < n; ++k) {
+                sum += a[r][k] * b[k][c];
+            }
+            res[r][c] = sum;
+        }
+    }
+}
+
+/**
+ * Square matrix product evaluated to a matrix, large sizes are evaluated by
+ * the blocked multiply
+ */
+template <typename Matrix>
+void
+MatrixGemm(benchmark::State& state)
+{
+    constexpr auto n = Matrix::rows;
+    Matrix         a, b;
+    fill_gemm_matrix(a, n, n);
+    fill_gemm_matrix(b, n, n);
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(a);
+        Matrix res = a * b;
+        benchmark::DoNotOptimize(res);
+    }
+    set_gemm_counters<Matrix>(state, n);
+}
+
+template <typename Matrix>
+void
+MatrixGemmNaive(benchmark::State& state)
+{
+    constexpr auto n = Matrix::rows;
+    Matrix         a, b, res;
+    fill_gemm_matrix(a, n, n);
+    fill_gemm_matrix(b, n, n);
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(a);
+        naive_multiply<typename Matrix::value_type>(a, b, res, n);
+        benchmark::DoNotOptimize(res);
+    }
+    set_gemm_counters<Matrix>(state, n);
+}
+
+/**
+ * Element-wise expression evaluated to a matrix, unrolled or in a loop
+ * depending on the size. Build with different -DPSST_MATH_UNROLL_THRESHOLD
+ * values to compare.
+ */
+template <typename Matrix>
+void
+MatrixSweepAxpy(benchmark::State& state)
+{
+    Matrix a, b;
+    fill_gemm_matrix(a, Matrix::rows, Matrix::cols);
+    fill_gemm_matrix(b, Matrix::rows, Matrix::cols);
+    typename Matrix::value_type s{2};
+    while (state.KeepRunning()) {
+        // The values are not known to the compiler
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        benchmark::DoNotOptimize(s);
+        Matrix res = a * s + b;
+        benchmark::DoNotOptimize(res);
+    }
+}
+template <typename Matrix>
+void
+MatrixSweepEq(benchmark::State& state)
+{
+    Matrix a, b;
+    fill_gemm_matrix(a, Matrix::rows, Matrix::cols);
+    fill_gemm_matrix(b, Matrix::rows, Matrix::cols);
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        bool const eq = a == b;
+        benchmark::DoNotOptimize(eq);
+    }
+}
+
+template <typename T>
+void
+DynamicMatrixGemm(benchmark::State& state)
+{
+    auto const        n = static_cast<std::size_t>(state.range(0));
+    dynamic_matrix<T> a(n, n), b(n, n);
+    fill_gemm_matrix(a, n, n);
+    fill_gemm_matrix(b, n, n);
+    dynamic_matrix<T> res;
+    while (state.KeepRunning()) {
+        res = a * b;
+        benchmark::DoNotOptimize(res.data());
+    }
+    set_gemm_counters<dynamic_matrix<T>>(state, n);
+}
+
+template <typename T>
+void
+DynamicMatrixGemmNaive(benchmark::State& state)
+{
+    auto const        n = static_cast<std::size_t>(state.range(0));
+    dynamic_matrix<T> a(n, n), b(n, n), res(n, n);
+    fill_gemm_matrix(a, n, n);
+    fill_gemm_matrix(b, n, n);
+    while (state.KeepRunning()) {
+        naive_multiply<T>(a, b, res, n);
+        benchmark::DoNotOptimize(res.data());
+    }
+    set_gemm_counters<dynamic_matrix<T>>(state, n);
+}
+
+template <typename Matrix>
+void
+MatrixDeterminant(benchmark::State& state)
+{
+    using matrix_traits = traits::matrix_traits<Matrix>;
+    Matrix m = make_test_matrix<typename matrix_traits::value_type>(
+        typename matrix_traits::size_type{});
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(m);
+        typename matrix_traits::value_type res = det(m);
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetComplexityN(matrix_traits::size);
+}
+
+template <typename Matrix>
+void
+MatrixInverse(benchmark::State& state)
+{
+    using matrix_traits = traits::matrix_traits<Matrix>;
+    using value_type    = typename matrix_traits::value_type;
+    // The test matrices are singular, move them away from zero determinant
+    Matrix m = make_test_matrix<value_type>(typename matrix_traits::size_type{})
+             + Matrix::identity() * value_type{100};
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(m);
+        Matrix res = inverse(m);
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetComplexityN(matrix_traits::size);
+}
+
+template <typename Matrix>
+void
+MatrixRigidInverse(benchmark::State& state)
+{
+    using matrix_traits = traits::matrix_traits<Matrix>;
+    // clang-format off
+    Matrix m{
+        { 0, -1, 0, 1 },
+        { 1,  0, 0, 2 },
+        { 0,  0, 1, 3 },
+        { 0,  0, 0, 1 }
+    };
+    // clang-format on
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(m);
+        Matrix res = rigid_inverse(m);
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetComplexityN(matrix_traits::size);
+}
+
+/**
+ * Composition of affine transforms stored as 3x4 matrices, compare with
+ * MatrixMultiplyEval of 4x4 matrices
+ */
+template <typename T>
+void
+AffineMultiply(benchmark::State& state)
+{
+    using affine_type = affine_matrix<T>;
+    affine_type lhs{make_test_matrix<T>(traits::matrix_size<3, 4>{})};
+    affine_type rhs = lhs;
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(lhs);
+        affine_type res = lhs * rhs;
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+template <typename T>
+void
+AffineInverse(benchmark::State& state)
+{
+    using affine_type = affine_matrix<T>;
+    // clang-format off
+    affine_type m{
+        { 2, -1, 0, 1 },
+        { 1,  3, 0, 2 },
+        { 0,  0, 1, 3 }
+    };
+    // clang-format on
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(m);
+        affine_type res = inverse(m);
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+template <typename T>
+void
+AffineRigidInverse(benchmark::State& state)
+{
+    using affine_type = affine_matrix<T>;
+    // clang-format off
+    affine_type m{
+        { 0, -1, 0, 1 },
+        { 1,  0, 0, 2 },
+        { 0,  0, 1, 3 }
+    };
+    // clang-format on
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(m);
+        affine_type res = rigid_inverse(m);
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+/**
+ * Product of a diagonal (scaling) matrix and a matrix evaluated to a matrix,
+ * compare with MatrixMultiplyEval
+ */
+template <typename Matrix>
+void
+DiagonalMultiply(benchmark::State& state)
+{
+    using traits_type = traits::matrix_traits<Matrix>;
+    using value_type  = typename traits_type::value_type;
+    Matrix     rhs  = make_test_matrix<value_type>(typename traits_type::size_type{});
+    auto const diag = diagonal(typename Matrix::row_type{rhs[0]});
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(rhs);
+        Matrix res = diag * rhs;
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+/**
+ * Product of a lower triangular matrix and a matrix evaluated to a matrix
+ */
+template <typename Matrix>
+void
+TriangularMultiply(benchmark::State& state)
+{
+    using traits_type = traits::matrix_traits<Matrix>;
+    using value_type  = typename traits_type::value_type;
+    Matrix lhs        = make_test_matrix<value_type>(typename traits_type::size_type{});
+    Matrix rhs        = lhs;
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(lhs);
+        Matrix res = lower_triangular(lhs) * rhs;
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+/**
+ * Rows of a matrix permuted by a product with a permutation matrix
+ */
+template <typename Matrix>
+void
+PermutationMultiply(benchmark::State& state)
+{
+    using traits_type = traits::matrix_traits<Matrix>;
+    using value_type  = typename traits_type::value_type;
+    Matrix rhs        = make_test_matrix<value_type>(typename traits_type::size_type{});
+    typename expr::permutation_matrix<Matrix>::index_type cols;
+    for (std::size_t r = 0; r < Matrix::rows; ++r) {
+        cols[r] = Matrix::rows - r - 1;
+    }
+    auto const perm = expr::permutation<Matrix>(cols);
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(rhs);
+        Matrix res = perm * rhs;
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+/**
+ * Solve a buffer of systems one by one
+ */
+template <typename Matrix>
+void
+MatrixSolveLoop(benchmark::State& state)
+{
+    using matrix_traits = traits::matrix_traits<Matrix>;
+    using value_type    = typename matrix_traits::value_type;
+    using vector_type   = vector<value_type, matrix_traits::rows>;
+    std::vector<Matrix> a(state.range(0),
+                          make_test_matrix<value_type>(typename matrix_traits::size_type{})
+                              + Matrix::identity() * value_type{100});
+    std::vector<vector_type> b(a.size(), make_test_vector<value_type>(
+                                             dimension_count<matrix_traits::rows>{}));
+    std::vector<vector_type> out(a.size());
+
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            out[i] = solve(a[i], b[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+
+template <typename Matrix>
+void
+MatrixSolveBatch(benchmark::State& state)
+{
+    using matrix_traits = traits::matrix_traits<Matrix>;
+    using value_type    = typename matrix_traits::value_type;
+    using vector_type   = vector<value_type, matrix_traits::rows>;
+    std::vector<Matrix> a(state.range(0),
+                          make_test_matrix<value_type>(typename matrix_traits::size_type{})
+                              + Matrix::identity() * value_type{100});
+    std::vector<vector_type> b(a.size(), make_test_vector<value_type>(
+                                             dimension_count<matrix_traits::rows>{}));
+    std::vector<vector_type> out(a.size());
+    auto const buf_size = matrix_traits::rows * a.size();
+    auto b_view   = make_memory_vector_view<vector_type>(
+        static_cast<value_type const*>(b.data()->data()), buf_size);
+    auto out_view = make_memory_vector_view<vector_type>(out.data()->data(), buf_size);
+
+    while (state.KeepRunning()) {
+        solve(out_view, a, b_view);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+
+template <typename Matrix>
+void
+MatrixChainMultiply(benchmark::State& state)
+{
+    using matrix_traits = traits::matrix_traits<Matrix>;
+    Matrix a = make_test_matrix<typename matrix_traits::value_type>(
+        typename matrix_traits::size_type{});
+    Matrix b = a;
+    Matrix c = a;
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(a);
+        Matrix res = a * b * c;
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetComplexityN(matrix_traits::size);
+}
+
 //----------------------------------------------------------------------------
 // clang-format off
 BENCHMARK_TEMPLATE(MatrixEq,                    matrix<float,   3, 3>)->Complexity();
@@ -191,6 +698,18 @@ BENCHMARK_TEMPLATE(MatrixRowMultiply,           matrix<float,   3, 3>)->Complexi
 BENCHMARK_TEMPLATE(MatrixRowMultiply,           matrix<double,  3, 3>)->Complexity();
 BENCHMARK_TEMPLATE(MatrixMultiply,              matrix<float,   3, 3>)->Complexity();
 BENCHMARK_TEMPLATE(MatrixMultiply,              matrix<double,  3, 3>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixMultiplyEval,          matrix<float,   3, 3>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixMultiplyEval,          matrix<double,  3, 3>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixChainMultiply,         matrix<float,   3, 3>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixChainMultiply,         matrix<double,  3, 3>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixDeterminant,           matrix<float,   3, 3>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixInverse,               matrix<float,   3, 3>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixSolveLoop,             matrix<float,   3, 3>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(MatrixSolveBatch,            matrix<float,   3, 3>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(MatrixDeterminant,           matrix<double,  3, 3>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixInverse,               matrix<double,  3, 3>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixSolveLoop,             matrix<double,  3, 3>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(MatrixSolveBatch,            matrix<double,  3, 3>)->Range(1 << 10, 1 << 16);
 
 BENCHMARK_TEMPLATE(MatrixEq,                    matrix<float,   4, 4>)->Complexity();
 BENCHMARK_TEMPLATE(MatrixEq,                    matrix<double,  4, 4>)->Complexity();
@@ -214,6 +733,42 @@ BENCHMARK_TEMPLATE(MatrixRowMultiply,           matrix<float,   4, 4>)->Complexi
 BENCHMARK_TEMPLATE(MatrixRowMultiply,           matrix<double,  4, 4>)->Complexity();
 BENCHMARK_TEMPLATE(MatrixMultiply,              matrix<float,   4, 4>)->Complexity();
 BENCHMARK_TEMPLATE(MatrixMultiply,              matrix<double,  4, 4>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixMultiplyEval,          matrix<float,   4, 4>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixMultiplyEval,          matrix<double,  4, 4>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixMultiplyAdd,           matrix<float,   4, 4>, false);
+BENCHMARK_TEMPLATE(MatrixMultiplyAdd,           matrix<float,   4, 4>, true);
+BENCHMARK_TEMPLATE(MatrixMultiplyAdd,           matrix<double,  4, 4>, false);
+BENCHMARK_TEMPLATE(MatrixMultiplyAdd,           matrix<double,  4, 4>, true);
+BENCHMARK_TEMPLATE(MatrixColMultiplyEval,       matrix<float,   4, 4>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(MatrixColMultiplyEval,       matrix<double,  4, 4>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(TransformPointsLoop,         float)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(TransformPoints,             float)->Ranges({{1 << 10, 1 << 20}, {1, 4}})->UseRealTime();
+BENCHMARK_TEMPLATE(TransformPointsLoop,         double)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(TransformPoints,             double)->Ranges({{1 << 10, 1 << 20}, {1, 4}})->UseRealTime();
+BENCHMARK_TEMPLATE(MatrixChainMultiply,         matrix<float,   4, 4>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixChainMultiply,         matrix<double,  4, 4>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixDeterminant,           matrix<float,   4, 4>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixInverse,               matrix<float,   4, 4>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixSolveLoop,             matrix<float,   4, 4>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(MatrixSolveBatch,            matrix<float,   4, 4>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(MatrixRigidInverse,          matrix<float,   4, 4>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixDeterminant,           matrix<double,  4, 4>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixInverse,               matrix<double,  4, 4>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixSolveLoop,             matrix<double,  4, 4>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(MatrixSolveBatch,            matrix<double,  4, 4>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(MatrixRigidInverse,          matrix<double,  4, 4>)->Complexity();
+BENCHMARK_TEMPLATE(AffineMultiply,              float);
+BENCHMARK_TEMPLATE(AffineMultiply,              double);
+BENCHMARK_TEMPLATE(AffineInverse,               float);
+BENCHMARK_TEMPLATE(AffineInverse,               double);
+BENCHMARK_TEMPLATE(AffineRigidInverse,          float);
+BENCHMARK_TEMPLATE(AffineRigidInverse,          double);
+BENCHMARK_TEMPLATE(DiagonalMultiply,            matrix<float,   4, 4>);
+BENCHMARK_TEMPLATE(DiagonalMultiply,            matrix<double,  4, 4>);
+BENCHMARK_TEMPLATE(TriangularMultiply,          matrix<float,   4, 4>);
+BENCHMARK_TEMPLATE(TriangularMultiply,          matrix<double,  4, 4>);
+BENCHMARK_TEMPLATE(PermutationMultiply,         matrix<float,   4, 4>);
+BENCHMARK_TEMPLATE(PermutationMultiply,         matrix<double,  4, 4>);
 
 BENCHMARK_TEMPLATE(MatrixEq,                    matrix<float,   3, 4>)->Complexity();
 BENCHMARK_TEMPLATE(MatrixEq,                    matrix<double,  3, 4>)->Complexity();
@@ -265,6 +820,33 @@ BENCHMARK_TEMPLATE(MatrixTranspose,             matrix<float,   10, 10>)->Comple
 BENCHMARK_TEMPLATE(MatrixColMultiply,           matrix<float,   10, 10>)->Complexity();
 BENCHMARK_TEMPLATE(MatrixRowMultiply,           matrix<float,   10, 10>)->Complexity();
 BENCHMARK_TEMPLATE(MatrixMultiply,              matrix<float,   10, 10>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixMultiplyEval,          matrix<float,   10, 10>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixChainMultiply,         matrix<float,   10, 10>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixDeterminant,           matrix<float,   10, 10>)->Complexity();
+BENCHMARK_TEMPLATE(MatrixInverse,               matrix<float,   10, 10>)->Complexity();
+
+BENCHMARK_TEMPLATE(MatrixGemm,                  matrix<float,   10, 10>);
+BENCHMARK_TEMPLATE(MatrixGemmNaive,             matrix<float,   10, 10>);
+BENCHMARK_TEMPLATE(MatrixGemm,                  matrix<float,   16, 16, components::none>);
+BENCHMARK_TEMPLATE(MatrixGemmNaive,             matrix<float,   16, 16, components::none>);
+BENCHMARK_TEMPLATE(MatrixGemm,                  matrix<float,   32, 32, components::none>);
+BENCHMARK_TEMPLATE(MatrixGemmNaive,             matrix<float,   32, 32, components::none>);
+BENCHMARK_TEMPLATE(MatrixGemm,                  matrix<double,  32, 32, components::none>);
+BENCHMARK_TEMPLATE(MatrixGemmNaive,             matrix<double,  32, 32, components::none>);
+BENCHMARK_TEMPLATE(MatrixSweepAxpy,             matrix<float,   4, 4, components::none>);
+BENCHMARK_TEMPLATE(MatrixSweepAxpy,             matrix<float,   6, 6, components::none>);
+BENCHMARK_TEMPLATE(MatrixSweepAxpy,             matrix<float,   8, 8, components::none>);
+BENCHMARK_TEMPLATE(MatrixSweepAxpy,             matrix<float,   12, 12, components::none>);
+BENCHMARK_TEMPLATE(MatrixSweepAxpy,             matrix<float,   16, 16, components::none>);
+BENCHMARK_TEMPLATE(MatrixSweepEq,               matrix<float,   4, 4, components::none>);
+BENCHMARK_TEMPLATE(MatrixSweepEq,               matrix<float,   6, 6, components::none>);
+BENCHMARK_TEMPLATE(MatrixSweepEq,               matrix<float,   8, 8, components::none>);
+BENCHMARK_TEMPLATE(MatrixSweepEq,               matrix<float,   12, 12, components::none>);
+BENCHMARK_TEMPLATE(MatrixSweepEq,               matrix<float,   16, 16, components::none>);
+BENCHMARK_TEMPLATE(DynamicMatrixGemm,           float)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK_TEMPLATE(DynamicMatrixGemmNaive,      float)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK_TEMPLATE(DynamicMatrixGemm,           double)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK_TEMPLATE(DynamicMatrixGemmNaive,      double)->RangeMultiplier(4)->Range(16, 1024);
 // clang-format on
 
 } /* namespace bench */
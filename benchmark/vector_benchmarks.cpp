@@ -8,11 +8,17 @@
 #include "make_test_data.hpp"
 #include <psst/math/matrix.hpp>
 #include <psst/math/matrix_io.hpp>
+#include <psst/math/padded_vector.hpp>
 #include <psst/math/vector.hpp>
 #include <psst/math/vector_io.hpp>
+#include <psst/math/vector_soa.hpp>
+#include <psst/math/vector_transform.hpp>
 
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace psst {
 namespace math {
 namespace bench {
@@ -154,6 +160,42 @@ VectorCross(benchmark::State& state)
         benchmark::DoNotOptimize(v3 = v1 * v2);
     }
 }
+/**
+ * Dot products of vectors from an array, the values are evaluated
+ */
+template <typename Vector>
+void
+VectorDotEval(benchmark::State& state)
+{
+    using value_type = typename Vector::value_type;
+    std::vector<Vector> a(state.range(0), make_test_vector<value_type>(dimension_count<Vector::size>{}));
+    std::vector<Vector> b(a);
+    std::vector<value_type> out(a.size());
+
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            out[i] = eval(dot_product(a[i], b[i]));
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+template <typename Vector>
+void
+VectorNormalizeArray(benchmark::State& state)
+{
+    using value_type = typename Vector::value_type;
+    std::vector<Vector> a(state.range(0), make_test_vector<value_type>(dimension_count<Vector::size>{}));
+    std::vector<Vector> out(a.size());
+
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            out[i] = normalize(a[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
 template <typename Vector>
 void
 VectorMagSQ(benchmark::State& state)
@@ -205,6 +247,306 @@ VectorSlerp(benchmark::State& state)
     }
 }
 
+//----------------------------------------------------------------------------
+//  Size sweep, unrolled vs looped evaluation
+//  Build with different -DPSST_MATH_UNROLL_THRESHOLD values to compare
+//----------------------------------------------------------------------------
+template <typename Vector>
+Vector
+make_sweep_vector(typename Vector::value_type start)
+{
+    Vector res;
+    for (std::size_t i = 0; i < Vector::size; ++i) {
+        res[i] = start + static_cast<typename Vector::value_type>(i);
+    }
+    return res;
+}
+
+template <typename Vector>
+void
+SweepConstruct(benchmark::State& state)
+{
+    using value_type = typename Vector::value_type;
+    value_type val{1};
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(val);
+        Vector v(val);
+        benchmark::DoNotOptimize(v);
+    }
+}
+template <typename Vector>
+void
+SweepAxpy(benchmark::State& state)
+{
+    auto v1 = make_sweep_vector<Vector>(1);
+    auto v2 = make_sweep_vector<Vector>(2);
+    typename Vector::value_type s{2};
+    while (state.KeepRunning()) {
+        // The values are not known to the compiler
+        benchmark::DoNotOptimize(v1);
+        benchmark::DoNotOptimize(v2);
+        benchmark::DoNotOptimize(s);
+        Vector v3 = v1 * s + v2;
+        benchmark::DoNotOptimize(v3);
+    }
+}
+template <typename Vector>
+void
+SweepEq(benchmark::State& state)
+{
+    auto v1 = make_sweep_vector<Vector>(1);
+    auto v2 = make_sweep_vector<Vector>(1);
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(v1);
+        benchmark::DoNotOptimize(v2);
+        bool const eq = v1 == v2;
+        benchmark::DoNotOptimize(eq);
+    }
+}
+template <typename Vector>
+void
+SweepDot(benchmark::State& state)
+{
+    auto v1 = make_sweep_vector<Vector>(1);
+    auto v2 = make_sweep_vector<Vector>(2);
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(v1);
+        benchmark::DoNotOptimize(v2);
+        benchmark::DoNotOptimize(eval(dot_product(v1, v2)));
+    }
+}
+
+//----------------------------------------------------------------------------
+//  Memory buffers
+//----------------------------------------------------------------------------
+template <typename Vector>
+void
+MemoryViewLoop(benchmark::State& state)
+{
+    using value_type = typename Vector::value_type;
+    std::vector<Vector> a(state.range(0), make_test_vector<value_type>(dimension_count<Vector::size>{}));
+    std::vector<Vector> b(a);
+    std::vector<Vector> out(a.size());
+    auto const buf_size = Vector::size * a.size();
+    auto a_view   = make_memory_vector_view<Vector>(a.data()->data(), buf_size);
+    auto b_view   = make_memory_vector_view<Vector>(b.data()->data(), buf_size);
+    auto out_view = make_memory_vector_view<Vector>(out.data()->data(), buf_size);
+    value_type s{2};
+
+    while (state.KeepRunning()) {
+        auto a_it = a_view.begin();
+        auto b_it = b_view.begin();
+        for (auto o : out_view) {
+            o = *a_it++ * s + *b_it++;
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+
+template <typename Vector>
+void
+MemoryViewTransform(benchmark::State& state)
+{
+    using value_type = typename Vector::value_type;
+    std::vector<Vector> a(state.range(0), make_test_vector<value_type>(dimension_count<Vector::size>{}));
+    std::vector<Vector> b(a);
+    std::vector<Vector> out(a.size());
+    auto const buf_size = Vector::size * a.size();
+    auto a_view   = make_memory_vector_view<Vector>(a.data()->data(), buf_size);
+    auto b_view   = make_memory_vector_view<Vector>(b.data()->data(), buf_size);
+    auto out_view = make_memory_vector_view<Vector>(out.data()->data(), buf_size);
+    value_type s{2};
+
+    while (state.KeepRunning()) {
+        transform(out_view, [s](auto a, auto b) { return a * s + b; }, a_view, b_view);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+
+/**
+ * The same as MemoryViewTransform with the output buffer being one of the
+ * input buffers, each element is evaluated before it is stored
+ */
+template <typename Vector>
+void
+MemoryViewTransformInPlace(benchmark::State& state)
+{
+    using value_type = typename Vector::value_type;
+    std::vector<Vector> a(state.range(0), make_test_vector<value_type>(dimension_count<Vector::size>{}));
+    std::vector<Vector> b(a);
+    auto const buf_size = Vector::size * a.size();
+    auto a_view   = make_memory_vector_view<Vector>(a.data()->data(), buf_size);
+    auto b_view   = make_memory_vector_view<Vector>(b.data()->data(), buf_size);
+    value_type s{0.5};
+
+    while (state.KeepRunning()) {
+        transform(a_view, [s](auto a, auto b) { return a * s + b; }, a_view, b_view);
+        benchmark::DoNotOptimize(a.data());
+    }
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+
+template <typename Vector>
+void
+VectorSoaLoop(benchmark::State& state)
+{
+    using value_type = typename Vector::value_type;
+    using soa_type   = vector_soa<value_type, Vector::size>;
+    soa_type a(state.range(0), make_test_vector<value_type>(dimension_count<Vector::size>{}));
+    soa_type b(a);
+    soa_type out(a.size());
+    value_type s{2};
+
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            out[i] = a[i] * s + b[i];
+        }
+        benchmark::DoNotOptimize(out.lane(0));
+    }
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+
+/**
+ * The same as MemoryViewTransform with the vectors stored in vector_soa
+ * containers, a lane per component
+ */
+template <typename Vector>
+void
+VectorSoaTransform(benchmark::State& state)
+{
+    using value_type = typename Vector::value_type;
+    using soa_type   = vector_soa<value_type, Vector::size>;
+    soa_type a(state.range(0), make_test_vector<value_type>(dimension_count<Vector::size>{}));
+    soa_type b(a);
+    soa_type out(a.size());
+    value_type s{2};
+
+    while (state.KeepRunning()) {
+        transform(out, [s](auto a, auto b) { return a * s + b; }, a, b);
+        benchmark::DoNotOptimize(out.lane(0));
+    }
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+
+/**
+ * Element-wise clamp of vectors from an array
+ */
+template <typename Vector>
+void
+VectorClampArray(benchmark::State& state)
+{
+    using value_type = typename Vector::value_type;
+    std::vector<Vector> a(state.range(0), make_test_vector<value_type>(dimension_count<Vector::size>{}));
+    std::vector<Vector> out(a.size());
+    Vector const lo(value_type{-1});
+    Vector const hi(value_type{1});
+
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            out[i] = clamp(a[i], lo, hi);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+/**
+ * The same as VectorClampArray with std::clamp for each component
+ */
+template <typename Vector>
+void
+VectorClampComponents(benchmark::State& state)
+{
+    using value_type = typename Vector::value_type;
+    std::vector<Vector> a(state.range(0), make_test_vector<value_type>(dimension_count<Vector::size>{}));
+    std::vector<Vector> out(a.size());
+    Vector const lo(value_type{-1});
+    Vector const hi(value_type{1});
+
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            for (std::size_t c = 0; c < Vector::size; ++c) {
+                out[i][c] = std::clamp(a[i][c], lo[c], hi[c]);
+            }
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+template <typename Vector>
+void
+VectorArgminArray(benchmark::State& state)
+{
+    using value_type = typename Vector::value_type;
+    std::vector<Vector> a(state.range(0), make_test_vector<value_type>(dimension_count<Vector::size>{}));
+    std::vector<std::size_t> out(a.size());
+
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            out[i] = argmin(a[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+template <typename Vector>
+void
+VectorMinComponentArray(benchmark::State& state)
+{
+    using value_type = typename Vector::value_type;
+    std::vector<Vector> a(state.range(0), make_test_vector<value_type>(dimension_count<Vector::size>{}));
+    std::vector<value_type> out(a.size());
+
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            out[i] = min_component(a[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+/**
+ * Bounding box of a buffer of vectors
+ */
+template <typename Vector>
+void
+MemoryViewBounds(benchmark::State& state)
+{
+    using value_type = typename Vector::value_type;
+    std::vector<Vector> a(state.range(0), make_test_vector<value_type>(dimension_count<Vector::size>{}));
+    auto a_view = make_memory_vector_view<Vector>(a.data()->data(), Vector::size * a.size());
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(component_min(a_view));
+        benchmark::DoNotOptimize(component_max(a_view));
+    }
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+
+/**
+ * Loop over an array of vectors with the given storage, vector or
+ * padded_vector
+ */
+template <typename Vector>
+void
+VectorArrayLoop(benchmark::State& state)
+{
+    using value_type = typename Vector::value_type;
+    std::vector<Vector> a(state.range(0), make_test_vector<value_type>(dimension_count<Vector::size>{}));
+    std::vector<Vector> b(a);
+    std::vector<Vector> out(a.size());
+    value_type s{2};
+
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            out[i] = (a[i] * b[i]) * s + b[i];
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+
 //----------------------------------------------------------------------------
 // clang-format off
 BENCHMARK_TEMPLATE(Compare,             float);
@@ -287,6 +629,78 @@ BENCHMARK_TEMPLATE(VectorDot,           vector<float,   10>);
 BENCHMARK_TEMPLATE(VectorMagSQ,         vector<float,   10>);
 BENCHMARK_TEMPLATE(VectorMag,           vector<float,   10>);
 BENCHMARK_TEMPLATE(VectorNorm,          vector<float,   10>);
+
+BENCHMARK_TEMPLATE(SweepConstruct,      vector<float,   8>);
+BENCHMARK_TEMPLATE(SweepConstruct,      vector<float,   16>);
+BENCHMARK_TEMPLATE(SweepConstruct,      vector<float,   24>);
+BENCHMARK_TEMPLATE(SweepConstruct,      vector<float,   32>);
+BENCHMARK_TEMPLATE(SweepConstruct,      vector<float,   64>);
+BENCHMARK_TEMPLATE(SweepConstruct,      vector<float,   128>);
+BENCHMARK_TEMPLATE(SweepConstruct,      vector<float,   256>);
+
+BENCHMARK_TEMPLATE(SweepAxpy,           vector<float,   8>);
+BENCHMARK_TEMPLATE(SweepAxpy,           vector<float,   16>);
+BENCHMARK_TEMPLATE(SweepAxpy,           vector<float,   24>);
+BENCHMARK_TEMPLATE(SweepAxpy,           vector<float,   32>);
+BENCHMARK_TEMPLATE(SweepAxpy,           vector<float,   64>);
+BENCHMARK_TEMPLATE(SweepAxpy,           vector<float,   128>);
+BENCHMARK_TEMPLATE(SweepAxpy,           vector<float,   256>);
+
+BENCHMARK_TEMPLATE(SweepEq,             vector<float,   8>);
+BENCHMARK_TEMPLATE(SweepEq,             vector<float,   16>);
+BENCHMARK_TEMPLATE(SweepEq,             vector<float,   24>);
+BENCHMARK_TEMPLATE(SweepEq,             vector<float,   32>);
+BENCHMARK_TEMPLATE(SweepEq,             vector<float,   64>);
+BENCHMARK_TEMPLATE(SweepEq,             vector<float,   128>);
+BENCHMARK_TEMPLATE(SweepEq,             vector<float,   256>);
+
+BENCHMARK_TEMPLATE(SweepDot,            vector<float,   8>);
+BENCHMARK_TEMPLATE(SweepDot,            vector<float,   10>);
+BENCHMARK_TEMPLATE(SweepDot,            vector<float,   16>);
+BENCHMARK_TEMPLATE(SweepDot,            vector<float,   32>);
+BENCHMARK_TEMPLATE(SweepDot,            vector<double,  10>);
+BENCHMARK_TEMPLATE(SweepDot,            vector<double,  32>);
+
+BENCHMARK_TEMPLATE(MemoryViewLoop,             vector<float,   3>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(MemoryViewTransform,        vector<float,   3>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(MemoryViewTransformInPlace, vector<float,   3>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(MemoryViewLoop,             vector<float,   4>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(MemoryViewTransform,        vector<float,   4>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(MemoryViewTransformInPlace, vector<float,   4>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(MemoryViewLoop,             vector<double,  3>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(MemoryViewTransform,        vector<double,  3>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(MemoryViewTransformInPlace, vector<double,  3>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(VectorSoaLoop,              vector<float,   3>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(VectorSoaTransform,         vector<float,   3>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(VectorSoaLoop,              vector<float,   4>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(VectorSoaTransform,         vector<float,   4>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(VectorSoaLoop,              vector<double,  3>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(VectorSoaTransform,         vector<double,  3>)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_TEMPLATE(VectorDotEval,       vector<float,   3>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(VectorDotEval,       vector<double,  3>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(VectorDotEval,       vector<float,   4>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(VectorDotEval,       vector<double,  4>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(VectorNormalizeArray, vector<float,  3>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(VectorNormalizeArray, vector<double, 3>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(VectorNormalizeArray, vector<float,  4>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(VectorNormalizeArray, vector<double, 4>)->Arg(1 << 10);
+
+BENCHMARK_TEMPLATE(VectorClampArray,    vector<float,   4>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(VectorClampComponents, vector<float, 4>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(VectorClampArray,    vector<double,  3>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(VectorClampComponents, vector<double, 3>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(VectorMinComponentArray, vector<float,  4>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(VectorMinComponentArray, vector<double, 4>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(VectorArgminArray,   vector<float,   4>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(VectorArgminArray,   vector<double,  4>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(MemoryViewBounds,    vector<float,   3>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(MemoryViewBounds,    vector<float,   4>)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_TEMPLATE(VectorArrayLoop,     vector<float,   3>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(VectorArrayLoop,     padded_vector<float,   3>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(VectorArrayLoop,     vector<double,  3>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(VectorArrayLoop,     padded_vector<double,  3>)->Range(1 << 10, 1 << 20);
 // clang-format on
 
 } /* namespace bench */
@@ -0,0 +1,329 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * affine_matrix.hpp
+ *
+ *  Created on: Feb 11, 2019
+ *      Author: ser-fedorov
+ */
+
+#ifndef PSST_MATH_AFFINE_MATRIX_HPP_
+#define PSST_MATH_AFFINE_MATRIX_HPP_
+
+#include <psst/math/matrix.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace psst {
+namespace math {
+
+/**
+ * Affine transform stored as the upper 3x4 part of a 4x4 matrix, the last
+ * row [0 0 0 1] is implicit.
+ *
+ * The upper left 3x3 block is the linear part and the last column is the
+ * translation. Composition, inversion and transforming a point skip the
+ * arithmetic with the implicit row, e.g. a composition takes 36
+ * multiplications instead of 64.
+ *
+ * Converts explicitly from a 4x4 (or 3x4) matrix expression, the last row
+ * of a 4x4 matrix is not checked and is dropped. Converts implicitly to a
+ * 4x4 matrix.
+ */
+template <typename T>
+struct affine_matrix {
+    using value_type       = T;
+    using compact_type     = matrix<T, 3, 4>;
+    using full_matrix_type = matrix<T, 4, 4>;
+    using linear_type      = matrix<T, 3, 3>;
+    using vector_type      = vector<T, 3>;
+    using row_type         = typename compact_type::row_type;
+    using pointer          = typename compact_type::pointer;
+    using const_pointer    = typename compact_type::const_pointer;
+    using init_list        = typename compact_type::init_list;
+
+    static constexpr std::size_t rows = 3;
+    static constexpr std::size_t cols = 4;
+
+    constexpr affine_matrix() = default;
+    /**
+     * Construct from the three upper rows
+     */
+    constexpr affine_matrix(init_list const& args) : data_{args} {}
+    constexpr explicit affine_matrix(compact_type const& m) : data_{m} {}
+    /**
+     * Construct from the linear part and the translation
+     */
+    affine_matrix(linear_type const& linear, vector_type const& translation)
+    {
+        for (std::size_t r = 0; r < rows; ++r) {
+            for (std::size_t c = 0; c < 3; ++c) {
+                data_[r][c] = linear[r][c];
+            }
+            data_[r][3] = translation[r];
+        }
+    }
+    /**
+     * Construct from a 4x4 or 3x4 matrix expression, the fourth row is
+     * dropped
+     */
+    template <typename Expression, typename = traits::enable_if_matrix_expression<Expression>>
+    constexpr explicit affine_matrix(Expression&& rhs) : data_{std::forward<Expression>(rhs)}
+    {
+        using matrix_type = typename std::decay_t<Expression>::matrix_type;
+        static_assert((matrix_type::rows == 3 || matrix_type::rows == 4) && matrix_type::cols == 4,
+                      "Affine matrix is constructed from a 4x4 or a 3x4 matrix");
+    }
+
+    static affine_matrix
+    identity()
+    {
+        return affine_matrix{linear_type::identity(), vector_type{}};
+    }
+
+    /**
+     * The 3x4 matrix of the upper rows, e.g. for a bulk transform of a
+     * buffer with transform_points
+     */
+    compact_type const&
+    compact() const
+    {
+        return data_;
+    }
+
+    full_matrix_type
+    to_matrix() const
+    {
+        full_matrix_type res{value_type{0}};
+        for (std::size_t r = 0; r < rows; ++r) {
+            res[r] = data_[r];
+        }
+        res[3][3] = value_type{1};
+        return res;
+    }
+    operator full_matrix_type() const { return to_matrix(); }
+
+    linear_type
+    linear() const
+    {
+        linear_type res;
+        for (std::size_t r = 0; r < rows; ++r) {
+            for (std::size_t c = 0; c < 3; ++c) {
+                res[r][c] = data_[r][c];
+            }
+        }
+        return res;
+    }
+    vector_type
+    translation() const
+    {
+        return vector_type{data_[0][3], data_[1][3], data_[2][3]};
+    }
+
+    row_type& operator[](std::size_t r) { return data_[r]; }
+    row_type const& operator[](std::size_t r) const { return data_[r]; }
+
+    pointer
+    data()
+    {
+        return data_.data();
+    }
+    const_pointer
+    data() const
+    {
+        return data_.data();
+    }
+
+private:
+    compact_type data_;
+};
+
+namespace detail {
+
+/**
+ * Element I of the composition, at row I / 4 and column I % 4. The implicit
+ * last row of rhs adds only the translation of lhs.
+ */
+template <typename T, std::size_t I>
+constexpr T
+affine_compose_element(T const (&a)[12], T const (&b)[12])
+{
+    constexpr std::size_t r = I / 4 * 4;
+    constexpr std::size_t c = I % 4;
+    return utils::multiply_add<T>(
+        a[r + 2], b[8 + c],
+        utils::multiply_add<T>(a[r + 1], b[4 + c],
+                               utils::multiply_add<T>(a[r], b[c], c == 3 ? a[I] : T{0})));
+}
+
+/**
+ * Copy the elements of an affine transform row by row, the rows of the
+ * compact matrix storage can be padded
+ */
+template <typename T>
+void
+affine_copy_elements(affine_matrix<T> const& m, T (&a)[12])
+{
+    using compact_type = typename affine_matrix<T>::compact_type;
+    for (std::size_t r = 0; r < compact_type::rows; ++r) {
+        auto const row = m.data() + r * compact_type::major_stride;
+        std::copy(row, row + compact_type::cols, a + r * compact_type::cols);
+    }
+}
+
+template <typename T, std::size_t... I>
+affine_matrix<T>
+affine_compose(T const (&a)[12], T const (&b)[12], std::index_sequence<I...>)
+{
+    T const res[]{affine_compose_element<T, I>(a, b)...};
+    return affine_matrix<T>{typename affine_matrix<T>::compact_type{res}};
+}
+
+}    // namespace detail
+
+/**
+ * Composition of affine transforms, the same as the product of the 4x4
+ * matrices. 36 multiplications instead of 64.
+ */
+template <typename T>
+affine_matrix<T>
+operator*(affine_matrix<T> const& lhs, affine_matrix<T> const& rhs)
+{
+    // Local copies of the operands are not reloaded between the unrolled
+    // elements
+    T a[12];
+    T b[12];
+    detail::affine_copy_elements(lhs, a);
+    detail::affine_copy_elements(rhs, b);
+    return detail::affine_compose(a, b, std::make_index_sequence<12>{});
+}
+
+template <typename T>
+affine_matrix<T>&
+operator*=(affine_matrix<T>& lhs, affine_matrix<T> const& rhs)
+{
+    return lhs = lhs * rhs;
+}
+
+template <typename T>
+bool
+operator==(affine_matrix<T> const& lhs, affine_matrix<T> const& rhs)
+{
+    return lhs.compact() == rhs.compact();
+}
+
+template <typename T>
+bool
+operator!=(affine_matrix<T> const& lhs, affine_matrix<T> const& rhs)
+{
+    return !(lhs == rhs);
+}
+
+/**
+ * Transform a point, the translation is applied. 9 multiplications.
+ */
+template <typename T>
+vector<T, 3>
+transform_point(affine_matrix<T> const& m, vector<T, 3> const& p)
+{
+    vector<T, 3> res;
+    for (std::size_t r = 0; r < affine_matrix<T>::rows; ++r) {
+        res[r] = utils::multiply_add<T>(
+            m[r][2], p[2],
+            utils::multiply_add<T>(m[r][1], p[1], utils::multiply_add<T>(m[r][0], p[0], m[r][3])));
+    }
+    return res;
+}
+
+/**
+ * Transform a direction vector, the translation is not applied.
+ * 9 multiplications.
+ */
+template <typename T>
+vector<T, 3>
+transform_vector(affine_matrix<T> const& m, vector<T, 3> const& v)
+{
+    vector<T, 3> res;
+    for (std::size_t r = 0; r < affine_matrix<T>::rows; ++r) {
+        res[r] = utils::multiply_add<T>(m[r][2], v[2],
+                                        utils::multiply_add<T>(m[r][1], v[1], m[r][0] * v[0]));
+    }
+    return res;
+}
+
+namespace detail {
+
+/**
+ * Affine transform with the inverted linear part, the translation is
+ * transformed by it and negated
+ */
+template <typename T>
+affine_matrix<T>
+affine_matrix_inverse(T const (&a)[12], T const (&inv)[9])
+{
+    using compact_type = typename affine_matrix<T>::compact_type;
+    affine_matrix<T> res;
+    auto             dst = res.data();
+    for (std::size_t r = 0; r < affine_matrix<T>::rows; ++r, dst += compact_type::major_stride) {
+        auto const row = inv + r * 3;
+        std::copy(row, row + 3, dst);
+        dst[3] = -utils::multiply_add<T>(row[2], a[11],
+                                         utils::multiply_add<T>(row[1], a[7], row[0] * a[3]));
+    }
+    return res;
+}
+
+}    // namespace detail
+
+/**
+ * Inverse of an affine transform. Only the 3x3 linear part is inverted,
+ * 42 multiplications and a division.
+ *
+ * @throws std::runtime_error if the linear part is singular or numerically
+ *         singular
+ */
+template <typename T>
+affine_matrix<T>
+inverse(affine_matrix<T> const& m)
+{
+    static_assert(std::is_floating_point_v<T>, "Inverse is defined only for floating point matrices");
+    T a[12];
+    detail::affine_copy_elements(m, a);
+    // Cofactors of the first row of the linear part
+    T const c00 = a[5] * a[10] - a[6] * a[9];
+    T const c01 = a[6] * a[8] - a[4] * a[10];
+    T const c02 = a[4] * a[9] - a[5] * a[8];
+    // The same tolerance as the 3x3 inverse of a matrix, so that both
+    // affine inverses reject the same numerically singular linear parts
+    T const d = expr::m::detail::checked_reciprocal(
+        a[0] * c00 + a[1] * c01 + a[2] * c02, expr::m::detail::determinant_tolerance(m.linear()));
+    // clang-format off
+    T const inv[]{
+        c00 * d, (a[2] * a[9] - a[1] * a[10]) * d, (a[1] * a[6] - a[2] * a[5]) * d,
+        c01 * d, (a[0] * a[10] - a[2] * a[8]) * d, (a[2] * a[4] - a[0] * a[6]) * d,
+        c02 * d, (a[1] * a[8] - a[0] * a[9]) * d,  (a[0] * a[5] - a[1] * a[4]) * d
+    };
+    // clang-format on
+    return detail::affine_matrix_inverse(a, inv);
+}
+
+/**
+ * Inverse of a rigid transform, an affine transform with an orthonormal
+ * linear part (rotation). The linear part is transposed instead of inverted.
+ */
+template <typename T>
+affine_matrix<T>
+rigid_inverse(affine_matrix<T> const& m)
+{
+    T a[12];
+    detail::affine_copy_elements(m, a);
+    T const inv[]{a[0], a[4], a[8], a[1], a[5], a[9], a[2], a[6], a[10]};
+    return detail::affine_matrix_inverse(a, inv);
+}
+
+}    // namespace math
+}    // namespace psst
+
+#endif /* PSST_MATH_AFFINE_MATRIX_HPP_ */
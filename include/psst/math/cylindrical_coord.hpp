@@ -83,6 +83,10 @@ struct vector_scalar_multiply<components::cylindrical, LHS, RHS>
     }
 };
 
+template <typename LHS, typename RHS>
+struct has_runtime_at<vector_scalar_multiply<components::cylindrical, LHS, RHS>>
+    : std::false_type {};
+
 //@}
 //@{
 /** @name Vector scalar division for spherical coordinates */
@@ -111,6 +115,9 @@ struct vector_scalar_divide<components::cylindrical, LHS, RHS>
         }
     }
 };
+
+template <typename LHS, typename RHS>
+struct has_runtime_at<vector_scalar_divide<components::cylindrical, LHS, RHS>> : std::false_type {};
 //@}
 //@{
 /** @name Magnitude squared for spherical coordinates */
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * alignment.hpp
+ *
+ *  Created on: Feb 5, 2019
+ *      Author: ser-fedorov
+ */
+
+#ifndef PSST_MATH_DETAIL_ALIGNMENT_HPP_
+#define PSST_MATH_DETAIL_ALIGNMENT_HPP_
+
+#include <psst/math/detail/simd.hpp>
+#include <psst/math/detail/utils.hpp>
+#include <psst/math/matrix_fwd.hpp>
+#include <psst/math/vector_fwd.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace psst {
+namespace math {
+
+/**
+ * Alignment policy for storage of vectors and matrices.
+ *
+ * Specialize the template to change the alignment of a type, e.g.
+ * @code
+ * template <>
+ * struct alignment_policy<matrix<float, 4, 4>> : utils::size_constant<64> {};
+ * @endcode
+ * The specialization must be visible before the type is used and must be the
+ * same in all translation units.
+ *
+ * Alignment that is greater than the size of a vector pads the vector, it no
+ * longer has the memory layout of an array of it's components.
+ */
+template <typename T>
+struct alignment_policy : utils::size_constant<alignof(T)> {};
+
+template <typename T, std::size_t Size, typename Components>
+struct alignment_policy<vector<T, Size, Components>>
+    : utils::size_constant<simd::storage_alignment_v<T, Size>> {};
+
+template <typename T, std::size_t RC, std::size_t CC, typename Components, typename Layout>
+struct alignment_policy<matrix<T, RC, CC, Components, Layout>>
+    : utils::size_constant<alignof(T)> {};
+
+template <typename T>
+constexpr std::size_t alignment_policy_v = alignment_policy<T>::value;
+
+namespace utils {
+
+/**
+ * Maximum alignment detected for a memory buffer, the size of a cache line
+ */
+constexpr std::size_t max_alignment = 64;
+
+/**
+ * Alignment of memory pointed to by p, the greatest power of two up to
+ * max_alignment the address is a multiple of.
+ */
+inline std::size_t
+pointer_alignment(void const* p)
+{
+    auto const addr = reinterpret_cast<std::uintptr_t>(p) | max_alignment;
+    return static_cast<std::size_t>(addr & (~addr + 1));
+}
+
+/**
+ * Alignment of all elements of an array with the given stride in bytes
+ */
+inline std::size_t
+array_alignment(void const* p, std::size_t stride)
+{
+    auto const p_align = pointer_alignment(p);
+    auto const s       = stride | max_alignment;
+    auto const s_align = s & (~s + 1);
+    return p_align < s_align ? p_align : s_align;
+}
+
+inline bool
+is_aligned(void const* p, std::size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+}    // namespace utils
+
+}    // namespace math
+}    // namespace psst
+
+#endif /* PSST_MATH_DETAIL_ALIGNMENT_HPP_ */
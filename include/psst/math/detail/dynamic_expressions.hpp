@@ -0,0 +1,546 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * dynamic_expressions.hpp
+ *
+ *  Created on: Feb 8, 2019
+ *      Author: ser-fedorov
+ */
+
+#ifndef PSST_MATH_DETAIL_DYNAMIC_EXPRESSIONS_HPP_
+#define PSST_MATH_DETAIL_DYNAMIC_EXPRESSIONS_HPP_
+
+#include <psst/math/detail/expressions.hpp>
+#include <psst/math/detail/gemm.hpp>
+#include <psst/math/detail/matrix_expressions.hpp>
+#include <psst/math/detail/scalar_expressions.hpp>
+#include <psst/math/detail/vector_expressions.hpp>
+#include <psst/math/matrix_fwd.hpp>
+#include <psst/math/vector_fwd.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+namespace psst {
+namespace math {
+namespace expr {
+
+/**
+ * Expressions over vectors and matrices with sizes known only at runtime.
+ *
+ * The element-wise expressions are the fixed size expression templates,
+ * e.g. vector_sum or matrix_scalar_multiply, with a dynamic expression base.
+ * They are evaluated in loops by the runtime access at(i) and element(r, c)
+ * that the fixed size expressions use for large sizes. A dynamic vector
+ * expression has size() and at(i), a dynamic matrix expression has rows(),
+ * cols() and element(r, c). Sizes of the operands are checked when an
+ * expression is built. Only the expressions that have no fixed size
+ * counterpart, like products, are defined here.
+ */
+inline namespace dyn {
+
+//----------------------------------------------------------------------------
+template <typename Expression, typename T>
+using dynamic_vector_expression = vector_expression<Expression, dynamic_vector<T>>;
+
+template <typename Expression, typename T>
+using dynamic_matrix_expression = matrix_expression<Expression, dynamic_matrix<T>>;
+
+template <template <typename> class Expression, typename Arg,
+          typename T = traits::scalar_expression_result_t<Arg>>
+using unary_dynamic_vector_expression = dynamic_vector_expression<Expression<Arg>, T>;
+template <template <typename, typename> class Expression, typename LHS, typename RHS,
+          typename T = traits::scalar_expression_result_t<LHS, RHS>>
+using binary_dynamic_vector_expression = dynamic_vector_expression<Expression<LHS, RHS>, T>;
+
+template <template <typename> class Expression, typename Arg,
+          typename T = traits::scalar_expression_result_t<Arg>>
+using unary_dynamic_matrix_expression = dynamic_matrix_expression<Expression<Arg>, T>;
+template <template <typename, typename> class Expression, typename LHS, typename RHS,
+          typename T = traits::scalar_expression_result_t<LHS, RHS>>
+using binary_dynamic_matrix_expression = dynamic_matrix_expression<Expression<LHS, RHS>, T>;
+
+/**
+ * Evaluate a dynamic vector or matrix expression, e.g. to use it several
+ * times without recomputing the elements.
+ */
+template <typename Expression,
+          typename = std::enable_if_t<traits::is_dynamic_vector_expression_v<Expression>
+                                      || traits::is_dynamic_matrix_expression_v<Expression>>>
+auto
+eval(Expression&& exp)
+{
+    return typename std::decay_t<Expression>::result_type{std::forward<Expression>(exp)};
+}
+
+namespace detail {
+
+/**
+ * @throws std::runtime_error if the sizes don't match
+ */
+inline void
+check_dynamic_size(std::size_t lhs, std::size_t rhs)
+{
+    if (lhs != rhs)
+        throw std::runtime_error("Dynamic expression sizes don't match");
+}
+
+/**
+ * Scalar operand of a dynamic expression, a scalar expression is evaluated
+ * once instead of for every element.
+ */
+template <typename T>
+constexpr auto
+scalar_argument(T&& v)
+{
+    if constexpr (traits::is_expression_v<T>) {
+        return make_scalar_constant(eval(std::forward<T>(v)));
+    } else {
+        return make_scalar_constant(std::decay_t<T>{std::forward<T>(v)});
+    }
+}
+
+}    // namespace detail
+
+//----------------------------------------------------------------------------
+//@{
+/** @name Dynamic vector element-wise expressions */
+template <typename LHS, typename RHS>
+using dynamic_vector_scalar_multiply = vector_scalar_multiply<components::none, LHS, RHS>;
+template <typename LHS, typename RHS>
+using dynamic_vector_scalar_divide = vector_scalar_divide<components::none, LHS, RHS>;
+
+/**
+ * Negation of a vector, fixed size vectors have no negation expression
+ */
+template <typename Vector>
+struct dynamic_vector_negate : unary_dynamic_vector_expression<dynamic_vector_negate, Vector>,
+                               unary_expression<Vector> {
+    using base_type  = unary_dynamic_vector_expression<dynamic_vector_negate, Vector>;
+    using value_type = typename base_type::value_type;
+
+    using expression_base = unary_expression<Vector>;
+    using expression_base::expression_base;
+
+    value_type
+    at(std::size_t i) const
+    {
+        return -this->arg_.at(i);
+    }
+};
+
+//@}
+
+//----------------------------------------------------------------------------
+//@{
+/** @name Dynamic vector scalar functions */
+template <typename LHS, typename RHS,
+          typename = traits::enable_if_dynamic_vector_expressions<LHS, RHS>>
+auto
+dot_product(LHS const& lhs, RHS const& rhs)
+{
+    using value_type = traits::scalar_expression_result_t<LHS, RHS>;
+    detail::check_dynamic_size(lhs.size(), rhs.size());
+    // Independent accumulators, so that the additions overlap
+    constexpr std::size_t chains = s::detail::sum_accumulators;
+    value_type            acc[chains]{};
+    auto const            n    = lhs.size();
+    auto const            body = n - n % chains;
+    std::size_t           i    = 0;
+    for (; i < body; i += chains) {
+        for (std::size_t c = 0; c < chains; ++c) {
+            acc[c] = utils::multiply_add<value_type>(lhs.at(i + c), rhs.at(i + c), acc[c]);
+        }
+    }
+    for (; i < n; ++i) {
+        acc[0] = utils::multiply_add<value_type>(lhs.at(i), rhs.at(i), acc[0]);
+    }
+    return s::detail::tree_reduce<0, chains>(std::plus<>{}, [&acc](auto c) { return acc[c]; });
+}
+
+template <typename LHS, typename RHS,
+          typename = traits::enable_if_dynamic_vector_expressions<LHS, RHS>>
+auto
+operator|(LHS const& lhs, RHS const& rhs)
+{
+    return dot_product(lhs, rhs);
+}
+
+template <typename Vector, typename = traits::enable_if_dynamic_vector_expression<Vector>>
+auto
+magnitude_square(Vector const& v)
+{
+    return dot_product(v, v);
+}
+
+template <typename Vector, typename = traits::enable_if_dynamic_vector_expression<Vector>>
+auto
+magnitude(Vector const& v)
+{
+    using std::sqrt;
+    return sqrt(magnitude_square(v));
+}
+
+template <typename Vector, typename = traits::enable_if_dynamic_vector_expression<Vector>>
+auto
+normalize(Vector&& v)
+{
+    // Evaluate the magnitude once, not for every element, and the result
+    // right away, so that the elements are scaled by their own magnitude
+    auto const mag = magnitude(v);
+    return eval(std::forward<Vector>(v) / mag);
+}
+//@}
+
+//----------------------------------------------------------------------------
+//@{
+/** @name Dynamic matrix element-wise expressions */
+template <typename Matrix>
+struct dynamic_matrix_transpose
+    : unary_dynamic_matrix_expression<dynamic_matrix_transpose, Matrix>,
+      unary_expression<Matrix> {
+    using base_type  = unary_dynamic_matrix_expression<dynamic_matrix_transpose, Matrix>;
+    using value_type = typename base_type::value_type;
+
+    using expression_base = unary_expression<Matrix>;
+    using expression_base::expression_base;
+
+    std::size_t
+    rows() const
+    {
+        return this->arg_.cols();
+    }
+    std::size_t
+    cols() const
+    {
+        return this->arg_.rows();
+    }
+    value_type
+    element(std::size_t r, std::size_t c) const
+    {
+        return this->arg_.element(c, r);
+    }
+};
+
+template <typename LHS, typename RHS,
+          typename = std::enable_if_t<(traits::is_dynamic_vector_expression_v<
+                                           LHS> && traits::is_dynamic_vector_expression_v<RHS>)
+                                      || (traits::is_dynamic_matrix_expression_v<
+                                              LHS> && traits::is_dynamic_matrix_expression_v<RHS>)>>
+auto
+operator+(LHS&& lhs, RHS&& rhs)
+{
+    if constexpr (traits::is_dynamic_vector_expression_v<LHS>) {
+        detail::check_dynamic_size(lhs.size(), rhs.size());
+        return make_binary_expression<vector_sum>(std::forward<LHS>(lhs), std::forward<RHS>(rhs));
+    } else {
+        detail::check_dynamic_size(lhs.rows(), rhs.rows());
+        detail::check_dynamic_size(lhs.cols(), rhs.cols());
+        return make_binary_expression<matrix_sum>(std::forward<LHS>(lhs), std::forward<RHS>(rhs));
+    }
+}
+
+template <typename LHS, typename RHS,
+          typename = std::enable_if_t<(traits::is_dynamic_vector_expression_v<
+                                           LHS> && traits::is_dynamic_vector_expression_v<RHS>)
+                                      || (traits::is_dynamic_matrix_expression_v<
+                                              LHS> && traits::is_dynamic_matrix_expression_v<RHS>)>>
+auto
+operator-(LHS&& lhs, RHS&& rhs)
+{
+    if constexpr (traits::is_dynamic_vector_expression_v<LHS>) {
+        detail::check_dynamic_size(lhs.size(), rhs.size());
+        return make_binary_expression<vector_diff>(std::forward<LHS>(lhs), std::forward<RHS>(rhs));
+    } else {
+        detail::check_dynamic_size(lhs.rows(), rhs.rows());
+        detail::check_dynamic_size(lhs.cols(), rhs.cols());
+        return make_binary_expression<matrix_diff>(std::forward<LHS>(lhs), std::forward<RHS>(rhs));
+    }
+}
+
+template <typename Expr,
+          typename = std::enable_if_t<traits::is_dynamic_vector_expression_v<Expr>
+                                      || traits::is_dynamic_matrix_expression_v<Expr>>>
+auto
+operator-(Expr&& ex)
+{
+    if constexpr (traits::is_dynamic_vector_expression_v<Expr>) {
+        return make_unary_expression<dynamic_vector_negate>(std::forward<Expr>(ex));
+    } else {
+        return make_unary_expression<matrix_negate>(std::forward<Expr>(ex));
+    }
+}
+
+template <typename Matrix, typename = traits::enable_if_dynamic_matrix_expression<Matrix>>
+auto
+transpose(Matrix&& m)
+{
+    return make_unary_expression<dynamic_matrix_transpose>(std::forward<Matrix>(m));
+}
+//@}
+
+//----------------------------------------------------------------------------
+//@{
+/** @name Dynamic matrix products */
+template <typename T>
+struct is_dynamic_container : std::false_type {};
+template <typename T>
+struct is_dynamic_container<dynamic_vector<T>> : std::true_type {};
+template <typename T>
+struct is_dynamic_container<dynamic_matrix<T>> : std::true_type {};
+
+/**
+ * Evaluation policy for operands of a dynamic matrix product.
+ *
+ * Each element of a product reads a whole row or column of the operands, so
+ * any operand that is not a container is evaluated to a temporary when the
+ * product expression is built. Unlike the fixed size products the sizes are
+ * usually large enough for the temporary to be cheaper than recomputing the
+ * operand elements n times.
+ */
+template <typename T>
+struct materialize_dynamic_product_operand
+    : std::integral_constant<bool, !is_dynamic_container<std::decay_t<T>>::value> {};
+template <typename T>
+constexpr bool materialize_dynamic_product_operand_v
+    = materialize_dynamic_product_operand<std::decay_t<T>>::value;
+
+namespace detail {
+
+template <typename Expr>
+decltype(auto)
+dynamic_product_operand(Expr&& ex)
+{
+    if constexpr (materialize_dynamic_product_operand_v<Expr>) {
+        return eval(std::forward<Expr>(ex));
+    } else {
+        return std::forward<Expr>(ex);
+    }
+}
+
+}    // namespace detail
+
+template <typename LHS, typename RHS>
+struct dynamic_matrix_matrix_multiply
+    : binary_dynamic_matrix_expression<dynamic_matrix_matrix_multiply, LHS, RHS>,
+      binary_expression<LHS, RHS> {
+    using base_type  = binary_dynamic_matrix_expression<dynamic_matrix_matrix_multiply, LHS, RHS>;
+    using value_type = typename base_type::value_type;
+
+    using expression_base = binary_expression<LHS, RHS>;
+    using expression_base::expression_base;
+
+    std::size_t
+    rows() const
+    {
+        return this->lhs_.rows();
+    }
+    std::size_t
+    cols() const
+    {
+        return this->rhs_.cols();
+    }
+    /**
+     * An element is accumulated in a single chain with fused multiply-adds,
+     * as an element of a fixed size product is
+     */
+    value_type
+    element(std::size_t r, std::size_t c) const
+    {
+        value_type   res{0};
+        auto const n = this->lhs_.cols();
+        for (std::size_t k = 0; k < n; ++k) {
+            res = utils::multiply_add<value_type>(this->lhs_.element(r, k),
+                                                  this->rhs_.element(k, c), res);
+        }
+        return res;
+    }
+};
+
+/**
+ * A product of two dynamic floating point matrices of the same value type is
+ * evaluated with the blocked multiply when it is assigned to a matrix.
+ */
+template <typename T>
+struct use_blocked_dynamic_product : std::false_type {};
+template <typename LHS, typename RHS>
+struct use_blocked_dynamic_product<dynamic_matrix_matrix_multiply<LHS, RHS>>
+    : std::integral_constant<
+          bool, std::is_floating_point<typename std::decay_t<LHS>::value_type>::value
+                    && std::is_same<typename std::decay_t<LHS>::value_type,
+                                    typename std::decay_t<RHS>::value_type>::value> {};
+template <typename T>
+constexpr bool use_blocked_dynamic_product_v = use_blocked_dynamic_product<std::decay_t<T>>::value;
+
+template <typename LHS, typename RHS>
+struct dynamic_matrix_vector_multiply
+    : binary_dynamic_vector_expression<dynamic_matrix_vector_multiply, LHS, RHS>,
+      binary_expression<LHS, RHS> {
+    using base_type  = binary_dynamic_vector_expression<dynamic_matrix_vector_multiply, LHS, RHS>;
+    using value_type = typename base_type::value_type;
+
+    using expression_base = binary_expression<LHS, RHS>;
+    using expression_base::expression_base;
+
+    std::size_t
+    size() const
+    {
+        return this->lhs_.rows();
+    }
+    value_type
+    at(std::size_t r) const
+    {
+        value_type   res{0};
+        auto const n = this->lhs_.cols();
+        for (std::size_t k = 0; k < n; ++k) {
+            res = utils::multiply_add<value_type>(this->lhs_.element(r, k), this->rhs_.at(k),
+                                                  res);
+        }
+        return res;
+    }
+};
+
+template <
+    typename LHS, typename RHS,
+    typename = std::enable_if_t<
+        (traits::is_dynamic_vector_expression_v<LHS> && traits::is_scalar_v<RHS>)
+        || (traits::is_scalar_v<LHS> && traits::is_dynamic_vector_expression_v<RHS>)
+        || (traits::is_dynamic_matrix_expression_v<LHS> && traits::is_scalar_v<RHS>)
+        || (traits::is_scalar_v<LHS> && traits::is_dynamic_matrix_expression_v<RHS>)
+        || (traits::is_dynamic_matrix_expression_v<LHS> && traits::is_dynamic_matrix_expression_v<RHS>)
+        || (traits::is_dynamic_matrix_expression_v<
+                LHS> && traits::is_dynamic_vector_expression_v<RHS>)>>
+auto operator*(LHS&& lhs, RHS&& rhs)
+{
+    if constexpr (traits::is_dynamic_vector_expression_v<LHS> && traits::is_scalar_v<RHS>) {
+        return make_binary_expression<dynamic_vector_scalar_multiply>(
+            std::forward<LHS>(lhs), detail::scalar_argument(std::forward<RHS>(rhs)));
+    } else if constexpr (traits::is_scalar_v<LHS> && traits::is_dynamic_vector_expression_v<RHS>) {
+        return make_binary_expression<dynamic_vector_scalar_multiply>(
+            std::forward<RHS>(rhs), detail::scalar_argument(std::forward<LHS>(lhs)));
+    } else if constexpr (traits::is_dynamic_matrix_expression_v<LHS> && traits::is_scalar_v<RHS>) {
+        return make_binary_expression<matrix_scalar_multiply>(
+            std::forward<LHS>(lhs), detail::scalar_argument(std::forward<RHS>(rhs)));
+    } else if constexpr (traits::is_scalar_v<LHS> && traits::is_dynamic_matrix_expression_v<RHS>) {
+        return make_binary_expression<matrix_scalar_multiply>(
+            std::forward<RHS>(rhs), detail::scalar_argument(std::forward<LHS>(lhs)));
+    } else if constexpr (traits::is_dynamic_matrix_expression_v<RHS>) {
+        detail::check_dynamic_size(lhs.cols(), rhs.rows());
+        return make_binary_expression<dynamic_matrix_matrix_multiply>(
+            detail::dynamic_product_operand(std::forward<LHS>(lhs)),
+            detail::dynamic_product_operand(std::forward<RHS>(rhs)));
+    } else {
+        detail::check_dynamic_size(lhs.cols(), rhs.size());
+        return make_binary_expression<dynamic_matrix_vector_multiply>(
+            detail::dynamic_product_operand(std::forward<LHS>(lhs)),
+            detail::dynamic_product_operand(std::forward<RHS>(rhs)));
+    }
+}
+
+template <typename LHS, typename RHS,
+          typename = std::enable_if_t<(traits::is_dynamic_vector_expression_v<LHS>
+                                       || traits::is_dynamic_matrix_expression_v<LHS>)
+                                      && traits::is_scalar_v<RHS>>>
+auto
+operator/(LHS&& lhs, RHS&& rhs)
+{
+    if constexpr (traits::is_dynamic_vector_expression_v<LHS>) {
+        return make_binary_expression<dynamic_vector_scalar_divide>(
+            std::forward<LHS>(lhs), detail::scalar_argument(std::forward<RHS>(rhs)));
+    } else {
+        return make_binary_expression<matrix_scalar_divide>(
+            std::forward<LHS>(lhs), detail::scalar_argument(std::forward<RHS>(rhs)));
+    }
+}
+//@}
+
+//----------------------------------------------------------------------------
+//@{
+/** @name Compare dynamic expressions */
+template <typename LHS, typename RHS,
+          typename = std::enable_if_t<
+              (traits::is_dynamic_vector_expression_v<LHS> && traits::is_dynamic_vector_expression_v<RHS>)
+              || (traits::is_dynamic_matrix_expression_v<
+                      LHS> && traits::is_dynamic_matrix_expression_v<RHS>)>>
+bool
+operator==(LHS const& lhs, RHS const& rhs)
+{
+    using traits_type = traits::value_traits_t<typename LHS::value_type>;
+    if constexpr (traits::is_dynamic_vector_expression_v<LHS>) {
+        auto const n = lhs.size();
+        if (n != rhs.size())
+            return false;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!traits_type::eq(lhs.at(i), rhs.at(i)))
+                return false;
+        }
+    } else {
+        auto const rows = lhs.rows();
+        auto const cols = lhs.cols();
+        if (rows != rhs.rows() || cols != rhs.cols())
+            return false;
+        for (std::size_t r = 0; r < rows; ++r) {
+            for (std::size_t c = 0; c < cols; ++c) {
+                if (!traits_type::eq(lhs.element(r, c), rhs.element(r, c)))
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename LHS, typename RHS,
+          typename = std::enable_if_t<
+              (traits::is_dynamic_vector_expression_v<LHS> && traits::is_dynamic_vector_expression_v<RHS>)
+              || (traits::is_dynamic_matrix_expression_v<
+                      LHS> && traits::is_dynamic_matrix_expression_v<RHS>)>>
+bool
+operator!=(LHS const& lhs, RHS const& rhs)
+{
+    return !(lhs == rhs);
+}
+//@}
+
+}    // namespace dyn
+
+//----------------------------------------------------------------------------
+//@{
+/**
+ * @name Element-wise dynamic expressions
+ *
+ * A dynamic vector or matrix is updated by such expression in place, e.g.
+ * v += v * 2. Other expressions, e.g. m += transpose(m) or v += m * v, are
+ * evaluated to a temporary first.
+ * @see is_elementwise
+ */
+inline namespace m {
+
+template <typename T>
+struct is_elementwise<dynamic_vector<T>> : std::true_type {};
+template <typename T>
+struct is_elementwise<dynamic_matrix<T>> : std::true_type {};
+template <typename LHS, typename RHS>
+struct is_elementwise<v::vector_sum<LHS, RHS>>
+    : utils::bool_constant<is_elementwise_v<LHS> && is_elementwise_v<RHS>> {};
+template <typename LHS, typename RHS>
+struct is_elementwise<v::vector_diff<LHS, RHS>>
+    : utils::bool_constant<is_elementwise_v<LHS> && is_elementwise_v<RHS>> {};
+template <typename LHS, typename RHS>
+struct is_elementwise<dyn::dynamic_vector_scalar_multiply<LHS, RHS>>
+    : utils::bool_constant<is_elementwise_v<LHS> && detail::scalar_constant_v<RHS>> {};
+template <typename LHS, typename RHS>
+struct is_elementwise<dyn::dynamic_vector_scalar_divide<LHS, RHS>>
+    : utils::bool_constant<is_elementwise_v<LHS> && detail::scalar_constant_v<RHS>> {};
+template <typename Vector>
+struct is_elementwise<dyn::dynamic_vector_negate<Vector>>
+    : utils::bool_constant<is_elementwise_v<Vector>> {};
+
+}    // namespace m
+//@}
+
+}    // namespace expr
+}    // namespace math
+}    // namespace psst
+
+#endif /* PSST_MATH_DETAIL_DYNAMIC_EXPRESSIONS_HPP_ */
@@ -9,6 +9,10 @@
 #include <tuple>
 #include <utility>
 
+#ifndef PSST_MATH_UNROLL_THRESHOLD
+#    define PSST_MATH_UNROLL_THRESHOLD 16
+#endif
+
 namespace psst {
 namespace math {
 namespace expr {
@@ -45,8 +49,8 @@ template <typename T>
 using expression_argument_t = typename expression_argument<T>::type;
 
 template <typename T>
-struct arg_by_value : utils::bool_constant<std::is_rvalue_reference<T>{} || std::is_pointer<T>{}> {
-};
+struct arg_by_value : utils::bool_constant<std::is_rvalue_reference<T>{} || std::is_pointer<T>{}
+                                           || traits::is_vector_handle_v<T>> {};
 template <typename T>
 using arg_by_value_t = typename arg_by_value<T>::type;
 template <typename T>
@@ -73,7 +77,7 @@ struct unary_expression {
     constexpr arg_type
     arg() &&
     {
-        return arg_;
+        return static_cast<arg_type>(arg_);
     }
     constexpr arg_ref
     arg() const&
@@ -220,6 +224,62 @@ make_n_ary_expression(Args&&... args)
         static_cast<expression_argument_t<Args&&>>(args)...};
 }
 
+//----------------------------------------------------------------------------
+//@{
+/** @name Expression has a single argument */
+template <typename Expr, typename = utils::void_t<>>
+struct is_unary_expression : std::false_type {};
+template <typename Expr>
+struct is_unary_expression<Expr, utils::void_t<typename std::decay_t<Expr>::arg_type>>
+    : std::true_type {};
+template <typename Expr>
+constexpr bool is_unary_expression_v = is_unary_expression<Expr>::value;
+//@}
+
+//@{
+/**
+ * Argument types of an expression as a std::tuple, taken from its
+ * unary_expression, binary_expression or n_ary_expression base, so that the
+ * arguments are found whatever the other template parameters of the
+ * expression are, e.g. the indexes of nth_row<Matrix, RN>. The tuple is
+ * empty for a value or a leaf expression.
+ */
+namespace detail {
+
+template <typename Arg>
+std::tuple<Arg> expression_arguments_of(unary_expression<Arg> const*);
+template <typename LHS, typename RHS>
+std::tuple<LHS, RHS> expression_arguments_of(binary_expression<LHS, RHS> const*);
+template <typename... T>
+std::tuple<T...> expression_arguments_of(n_ary_expression<T...> const*);
+std::tuple<> expression_arguments_of(void const*);
+
+}    // namespace detail
+
+template <typename Expr>
+struct expression_arguments {
+    using type = decltype(
+        detail::expression_arguments_of(static_cast<std::decay_t<Expr> const*>(nullptr)));
+};
+template <typename Expr>
+using expression_arguments_t = typename expression_arguments<Expr>::type;
+//@}
+
+/**
+ * The argument of a unary expression or the left hand side of a binary one.
+ * Element-wise expressions of runtime sized operands take the size from it.
+ */
+template <typename Expr>
+constexpr decltype(auto)
+first_operand(Expr const& ex)
+{
+    if constexpr (is_unary_expression_v<Expr>) {
+        return ex.arg();
+    } else {
+        return ex.lhs();
+    }
+}
+
 //----------------------------------------------------------------------------
 template <typename Components, template <typename, typename> class Expression>
 struct select_unary_impl {
@@ -239,6 +299,22 @@ struct select_n_ary_impl {
     using type = Expression<Components, T...>;
 };
 
+//----------------------------------------------------------------------------
+/**
+ * Number of elements up to which fixed size vectors and matrices are
+ * initialized, evaluated and compared by code unrolled at compile time.
+ * Larger ones are processed in loops when the expression provides runtime
+ * access to the elements, a loop keeps the code small and is vectorized by
+ * the compiler. Both ways are usable in constant expressions. Define
+ * PSST_MATH_UNROLL_THRESHOLD to change the value.
+ */
+constexpr std::size_t unroll_threshold = PSST_MATH_UNROLL_THRESHOLD;
+
+/**
+ * Tag type to select evaluation of an expression in a loop
+ */
+struct loop_evaluation_tag {};
+
 }    // namespace expr
 }    // namespace math
 }    // namespace psst
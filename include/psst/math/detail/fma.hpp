@@ -0,0 +1,70 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * fma.hpp
+ *
+ *  Created on: Feb 7, 2019
+ *      Author: ser-fedorov
+ */
+
+#ifndef PSST_MATH_DETAIL_FMA_HPP_
+#define PSST_MATH_DETAIL_FMA_HPP_
+
+#include <psst/math/detail/utils.hpp>
+
+#include <cmath>
+#include <type_traits>
+
+namespace psst {
+namespace math {
+namespace utils {
+
+/**
+ * Multiply-add operations of expressions are fused for a floating point type
+ * when the target has a fast fma instruction for it (e.g. compiled with
+ * -mfma). Defining PSST_MATH_DISABLE_FMA turns the fusing off.
+ *
+ * Fused operations are rounded once, so the results can differ in the last
+ * bit from separate multiply and add.
+ */
+template <typename T>
+struct fused_multiply_add : std::false_type {};
+
+#if !defined(PSST_MATH_DISABLE_FMA)
+#    if defined(FP_FAST_FMAF)
+template <>
+struct fused_multiply_add<float> : std::true_type {};
+#    endif
+#    if defined(FP_FAST_FMA)
+template <>
+struct fused_multiply_add<double> : std::true_type {};
+#    endif
+#    if defined(FP_FAST_FMAL)
+template <>
+struct fused_multiply_add<long double> : std::true_type {};
+#    endif
+#endif
+
+template <typename T>
+constexpr bool fused_multiply_add_v = fused_multiply_add<std::decay_t<T>>::value;
+
+/**
+ * Computes a * b + c in type T, with a single rounding when fusing is
+ * enabled for the type.
+ */
+template <typename T, typename A, typename B, typename C>
+constexpr T
+multiply_add(A const& a, B const& b, C const& c)
+{
+    if constexpr (fused_multiply_add_v<T>) {
+        using std::fma;
+        return fma(static_cast<T>(a), static_cast<T>(b), static_cast<T>(c));
+    } else {
+        return a * b + c;
+    }
+}
+
+}    // namespace utils
+}    // namespace math
+}    // namespace psst
+
+#endif /* PSST_MATH_DETAIL_FMA_HPP_ */
@@ -0,0 +1,257 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * gemm.hpp
+ *
+ *  Created on: Feb 9, 2019
+ *      Author: ser-fedorov
+ */
+
+#ifndef PSST_MATH_DETAIL_GEMM_HPP_
+#define PSST_MATH_DETAIL_GEMM_HPP_
+
+#include <psst/math/detail/fma.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace psst {
+namespace math {
+namespace detail {
+
+/**
+ * Block sizes of the blocked matrix multiply.
+ *
+ * The result is computed in tiles of tile_rows x tile_cols, the tile is
+ * accumulated in registers. tile_cols is a few vector registers wide.
+ * A panel of depth x block_rows of the left hand matrix is packed to stay in
+ * L2 cache, a panel of depth x block_cols of the right hand matrix is packed
+ * to stay in L3 cache.
+ */
+template <typename T>
+struct gemm_blocking {
+    static constexpr std::size_t tile_rows  = 4;
+    static constexpr std::size_t tile_cols  = 32 / sizeof(T) > 0 ? 32 / sizeof(T) : 1;
+    static constexpr std::size_t depth      = 256;
+    static constexpr std::size_t block_rows = 64;
+    static constexpr std::size_t block_cols = 1024;
+};
+
+/**
+ * Copy a block of rows x depth of a row-major matrix to row tiles, the
+ * elements of a tile column are consecutive. A partial tile is padded
+ * with zeros.
+ */
+template <typename T, std::size_t TileRows>
+void
+gemm_pack_lhs(T const* a, std::size_t lda, std::size_t rows, std::size_t depth, T* packed)
+{
+    for (std::size_t i = 0; i < rows; i += TileRows) {
+        auto const tr = std::min(TileRows, rows - i);
+        for (std::size_t k = 0; k < depth; ++k) {
+            for (std::size_t r = 0; r < TileRows; ++r) {
+                *packed++ = r < tr ? a[(i + r) * lda + k] : T{0};
+            }
+        }
+    }
+}
+
+/**
+ * Copy a block of depth x cols of a row-major matrix to column tiles, the
+ * elements of a tile row are consecutive. A partial tile is padded with
+ * zeros.
+ */
+template <typename T, std::size_t TileCols>
+void
+gemm_pack_rhs(T const* b, std::size_t ldb, std::size_t depth, std::size_t cols, T* packed)
+{
+    for (std::size_t j = 0; j < cols; j += TileCols) {
+        auto const tc = std::min(TileCols, cols - j);
+        for (std::size_t k = 0; k < depth; ++k) {
+            auto const row = b + k * ldb + j;
+            for (std::size_t c = 0; c < TileCols; ++c) {
+                *packed++ = c < tc ? row[c] : T{0};
+            }
+        }
+    }
+}
+
+/**
+ * Accumulator of a tile of the product.
+ *
+ * The rows are unrolled at compile time and the loops over the columns have
+ * constant bounds, so that the compiler keeps the whole tile in vector
+ * registers.
+ */
+template <typename T, std::size_t TileRows, std::size_t TileCols>
+struct gemm_tile_accumulator {
+    static constexpr std::size_t tile_size = TileRows * TileCols;
+
+    void
+    multiply(std::size_t depth, T const* a, T const* b)
+    {
+        // A local copy that doesn't alias the operands can live in registers
+        T tile[tile_size]{};
+        for (std::size_t k = 0; k < depth; ++k, a += TileRows, b += TileCols) {
+            multiply_add(tile, a, b, std::make_index_sequence<tile_size>{});
+        }
+        std::copy(tile, tile + tile_size, acc);
+    }
+
+    void
+    store(T* c, std::size_t ldc, std::size_t rows, std::size_t cols, bool accumulate) const
+    {
+        for (std::size_t r = 0; r < rows; ++r) {
+            auto const row = c + r * ldc;
+            auto const src = acc + r * TileCols;
+            if (accumulate) {
+                for (std::size_t col = 0; col < cols; ++col) {
+                    row[col] += src[col];
+                }
+            } else {
+                std::copy(src, src + cols, row);
+            }
+        }
+    }
+
+    T acc[tile_size];
+
+private:
+    template <std::size_t... Indexes>
+    static void
+    multiply_add(T (&tile)[tile_size], T const* a, T const* b, std::index_sequence<Indexes...>)
+    {
+        ((tile[Indexes] = utils::multiply_add<T>(a[Indexes / TileCols], b[Indexes % TileCols],
+                                                 tile[Indexes])),
+         ...);
+    }
+};
+
+/**
+ * Number of elements of the packed left hand panel of a product of m x k
+ * and k x n matrices
+ */
+template <typename T>
+constexpr std::size_t
+gemm_lhs_panel_size(std::size_t m, std::size_t k)
+{
+    using blocking = gemm_blocking<T>;
+    auto const rows = std::min(m, blocking::block_rows);
+    return (rows + blocking::tile_rows - 1) / blocking::tile_rows * blocking::tile_rows
+         * std::min(k, blocking::depth);
+}
+
+/**
+ * Number of elements of the packed right hand panel of a product of m x k
+ * and k x n matrices
+ */
+template <typename T>
+constexpr std::size_t
+gemm_rhs_panel_size(std::size_t n, std::size_t k)
+{
+    using blocking = gemm_blocking<T>;
+    auto const cols = std::min(n, blocking::block_cols);
+    return (cols + blocking::tile_cols - 1) / blocking::tile_cols * blocking::tile_cols
+         * std::min(k, blocking::depth);
+}
+
+/**
+ * Blocked matrix multiply c = a * b of row-major matrices with the packing
+ * buffers provided by the caller.
+ *
+ * The operands are packed into panels that are reused from cache, the
+ * result is computed in register tiles. The result must not overlap the
+ * operands.
+ *
+ * @param m Number of rows of a and c
+ * @param n Number of columns of b and c
+ * @param k Number of columns of a and rows of b
+ * @param a Left hand matrix, lda elements between rows
+ * @param b Right hand matrix, ldb elements between rows
+ * @param c Result matrix, ldc elements between rows
+ * @param packed_a Buffer of gemm_lhs_panel_size(m, k) elements
+ * @param packed_b Buffer of gemm_rhs_panel_size(n, k) elements
+ */
+template <typename T>
+void
+gemm_packed(std::size_t m, std::size_t n, std::size_t k, T const* a, std::size_t lda,
+            T const* b, std::size_t ldb, T* c, std::size_t ldc, T* packed_a, T* packed_b)
+{
+    using blocking            = gemm_blocking<T>;
+    constexpr auto tile_rows  = blocking::tile_rows;
+    constexpr auto tile_cols  = blocking::tile_cols;
+    constexpr auto depth      = blocking::depth;
+    constexpr auto block_rows = blocking::block_rows;
+    constexpr auto block_cols = blocking::block_cols;
+
+    if (k == 0) {
+        for (std::size_t r = 0; r < m; ++r) {
+            std::fill_n(c + r * ldc, n, T{0});
+        }
+        return;
+    }
+
+    for (std::size_t jc = 0; jc < n; jc += block_cols) {
+        auto const nc = std::min(block_cols, n - jc);
+        for (std::size_t pc = 0; pc < k; pc += depth) {
+            auto const kc = std::min(depth, k - pc);
+            gemm_pack_rhs<T, tile_cols>(b + pc * ldb + jc, ldb, kc, nc, packed_b);
+            for (std::size_t ic = 0; ic < m; ic += block_rows) {
+                auto const mc = std::min(block_rows, m - ic);
+                gemm_pack_lhs<T, tile_rows>(a + ic * lda + pc, lda, mc, kc, packed_a);
+                for (std::size_t jr = 0; jr < nc; jr += tile_cols) {
+                    for (std::size_t ir = 0; ir < mc; ir += tile_rows) {
+                        gemm_tile_accumulator<T, tile_rows, tile_cols> tile;
+                        tile.multiply(kc, packed_a + ir * kc, packed_b + jr * kc);
+                        tile.store(c + (ic + ir) * ldc + jc + jr, ldc,
+                                   std::min(tile_rows, mc - ir), std::min(tile_cols, nc - jr),
+                                   pc > 0);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Blocked matrix multiply of runtime-sized row-major matrices.
+ * @see gemm_packed
+ */
+template <typename T>
+void
+gemm(std::size_t m, std::size_t n, std::size_t k, T const* a, std::size_t lda, T const* b,
+     std::size_t ldb, T* c, std::size_t ldc)
+{
+    // Packing buffers are kept between calls, a product of small matrices
+    // doesn't allocate
+    thread_local std::vector<T> lhs_buffer;
+    thread_local std::vector<T> rhs_buffer;
+    lhs_buffer.resize(gemm_lhs_panel_size<T>(m, k));
+    rhs_buffer.resize(gemm_rhs_panel_size<T>(n, k));
+    gemm_packed(m, n, k, a, lda, b, ldb, c, ldc, lhs_buffer.data(), rhs_buffer.data());
+}
+
+/**
+ * Blocked matrix multiply of fixed-size row-major matrices, M x K by K x N.
+ *
+ * The packing panels are sized from the dimensions at compile time and
+ * live on the stack, the product doesn't allocate. A panel is never larger
+ * than its operand padded to whole tiles.
+ * @see gemm_packed
+ */
+template <std::size_t M, std::size_t N, std::size_t K, typename T>
+void
+gemm(T const* a, std::size_t lda, T const* b, std::size_t ldb, T* c, std::size_t ldc)
+{
+    std::array<T, std::max(gemm_lhs_panel_size<T>(M, K), std::size_t{1})> packed_a;
+    std::array<T, std::max(gemm_rhs_panel_size<T>(N, K), std::size_t{1})> packed_b;
+    gemm_packed(M, N, K, a, lda, b, ldb, c, ldc, packed_a.data(), packed_b.data());
+}
+
+}    // namespace detail
+}    // namespace math
+}    // namespace psst
+
+#endif /* PSST_MATH_DETAIL_GEMM_HPP_ */
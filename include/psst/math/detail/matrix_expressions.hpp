@@ -8,8 +8,16 @@
 #ifndef PSST_MATH_DETAIL_MATRIX_EXPRESSIONS_HPP_
 #define PSST_MATH_DETAIL_MATRIX_EXPRESSIONS_HPP_
 
+#include <psst/math/detail/gemm.hpp>
 #include <psst/math/detail/vector_expressions.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
 // Undefine minor macro that comes with some libc libraries
 #ifdef minor
 #    undef minor
@@ -43,6 +51,32 @@ struct matrix_expression {
     static constexpr auto size = traits::size;
 };
 
+/**
+ * Matrix expression over runtime sized matrices. The element-wise
+ * expressions are shared with the fixed size matrices and are evaluated in
+ * loops by the runtime access element(r, c). The sizes are the sizes of the
+ * first operand.
+ */
+template <typename Expression, typename T>
+struct matrix_expression<Expression, dynamic_matrix<T>> {
+    using expression_type = Expression;
+    using result_type     = dynamic_matrix<T>;
+    using value_type      = T;
+    using value_tag       = traits::tag::dynamic_matrix;
+    using matrix_type     = dynamic_matrix<T>;
+
+    std::size_t
+    rows() const
+    {
+        return first_operand(static_cast<Expression const&>(*this)).rows();
+    }
+    std::size_t
+    cols() const
+    {
+        return first_operand(static_cast<Expression const&>(*this)).cols();
+    }
+};
+
 namespace detail {
 
 template <typename T>
@@ -62,6 +96,123 @@ using matrix_row_count_t = typename matrix_row_count<T>::type;
 template <typename T>
 constexpr std::size_t matrix_row_count_v = matrix_row_count_t<T>::value;
 
+/**
+ * Storage layout of the result of a matrix expression
+ */
+template <typename T>
+using matrix_layout_t = typename std::decay_t<T>::matrix_type::layout_type;
+/**
+ * Storage layout of the result of an expression of two matrices, the layout
+ * of the operands if it is the same or the row-major layout
+ */
+template <typename LHS, typename RHS>
+using common_layout_t
+    = std::conditional_t<std::is_same<matrix_layout_t<LHS>, matrix_layout_t<RHS>>::value,
+                         matrix_layout_t<LHS>, layout::row_major>;
+
+/**
+ * Evaluate a matrix expression to a matrix, e.g. to use it several times
+ * without recomputing the elements.
+ */
+template <typename Expression, typename = traits::enable_if_matrix_expression<Expression>>
+constexpr auto
+eval(Expression&& exp)
+{
+    return typename std::decay_t<Expression>::matrix_type{std::forward<Expression>(exp)};
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Tags of the known structure of a square matrix expression. Products,
+ * determinants and inverses of structured matrices skip the elements that
+ * are known to be zero.
+ */
+namespace structure {
+
+/**
+ * No known structure
+ */
+struct general {};
+/**
+ * Identity matrix
+ */
+struct identity {};
+/**
+ * Zeros outside of the main diagonal
+ */
+struct diagonal {};
+/**
+ * Zeros above the main diagonal
+ */
+struct lower_triangular {};
+/**
+ * Zeros below the main diagonal
+ */
+struct upper_triangular {};
+/**
+ * A single one in each row and in each column, zeros elsewhere
+ */
+struct permutation {};
+/**
+ * All elements are zeros, the matrix can be non-square
+ */
+struct zero {};
+
+}    // namespace structure
+
+/**
+ * Structure of a matrix expression. Specialize the template for an
+ * expression type that has a known structure.
+ */
+template <typename T>
+struct matrix_structure {
+    using type = structure::general;
+};
+template <typename T>
+using matrix_structure_t = typename matrix_structure<std::decay_t<T>>::type;
+
+namespace detail {
+
+template <typename Structure>
+constexpr bool diagonal_structure_v
+    = std::is_same<Structure, structure::identity>::value
+      || std::is_same<Structure, structure::diagonal>::value;
+/**
+ * Zeros above the main diagonal
+ */
+template <typename Structure>
+constexpr bool lower_structure_v
+    = diagonal_structure_v<Structure>
+      || std::is_same<Structure, structure::lower_triangular>::value;
+/**
+ * Zeros below the main diagonal
+ */
+template <typename Structure>
+constexpr bool upper_structure_v
+    = diagonal_structure_v<Structure>
+      || std::is_same<Structure, structure::upper_triangular>::value;
+
+template <typename T, typename Structure>
+constexpr bool has_structure_v = std::is_same<matrix_structure_t<T>, Structure>::value;
+
+/**
+ * The operand that an expression is simplified to, e.g. the other operand
+ * of a sum with a zero matrix. An lvalue is referenced, an rvalue is moved
+ * to the result.
+ */
+template <typename Expr>
+using simplified_operand_t = std::conditional_t<std::is_lvalue_reference<Expr>::value,
+                                                std::decay_t<Expr> const&, std::decay_t<Expr>>;
+
+template <typename Expr>
+constexpr simplified_operand_t<Expr&&>
+simplified_operand(Expr&& ex)
+{
+    return std::forward<Expr>(ex);
+}
+
+}    // namespace detail
+
 //----------------------------------------------------------------------------
 template <typename Matrix>
 struct identity_matrix : matrix_expression<identity_matrix<Matrix>, Matrix> {
@@ -83,6 +234,16 @@ struct identity_matrix : matrix_expression<identity_matrix<Matrix>, Matrix> {
             return 0;
         }
     }
+    constexpr value_type
+    element(std::size_t r, std::size_t c) const
+    {
+        return r == c ? value_type{1} : value_type{0};
+    }
+};
+
+template <typename Matrix>
+struct matrix_structure<identity_matrix<Matrix>> {
+    using type = structure::identity;
 };
 
 template <typename Matrix, typename = traits::enable_if_matrix_expression<Matrix>>
@@ -99,6 +260,68 @@ identity(Matrix&& m)
     return identity_matrix<std::decay_t<Matrix>>{};
 }
 
+//----------------------------------------------------------------------------
+/**
+ * Matrix of zeros. A product with it is a zero matrix, a sum with it is the
+ * other operand.
+ */
+template <typename Matrix>
+struct zero_matrix : matrix_expression<zero_matrix<Matrix>, Matrix> {
+    using base_type  = matrix_expression<zero_matrix<Matrix>, Matrix>;
+    using value_type = typename base_type::value_type;
+
+    template <std::size_t R, std::size_t C>
+    constexpr value_type
+    element() const
+    {
+        static_assert(R < base_type::rows, "Invalid matrix expression row index");
+        static_assert(C < base_type::cols, "Invalid matrix expression col index");
+        return value_type{0};
+    }
+    constexpr value_type element(std::size_t, std::size_t) const { return value_type{0}; }
+};
+
+template <typename Matrix>
+struct matrix_structure<zero_matrix<Matrix>> {
+    using type = structure::zero;
+};
+
+template <typename Matrix, typename = traits::enable_if_matrix_expression<Matrix>>
+constexpr auto
+zero()
+{
+    return zero_matrix<std::decay_t<Matrix>>{};
+}
+
+//----------------------------------------------------------------------------
+//@{
+/** @name Evaluation in loops */
+/**
+ * A matrix expression that provides runtime access to the elements with
+ * element(std::size_t, std::size_t) in addition to element<R, C>(). Large
+ * matrices are evaluated and compared in loops with it.
+ *
+ * @see unroll_threshold
+ */
+template <typename T>
+struct has_runtime_element : traits::is_matrix_t<T> {};
+template <typename T>
+constexpr bool has_runtime_element_v = has_runtime_element<std::decay_t<T>>::value;
+
+template <typename Matrix>
+struct has_runtime_element<identity_matrix<Matrix>> : std::true_type {};
+template <typename Matrix>
+struct has_runtime_element<zero_matrix<Matrix>> : std::true_type {};
+
+/**
+ * The matrix expression is larger than the unroll threshold and is
+ * evaluated in a loop
+ */
+template <typename Expr>
+constexpr bool matrix_loop_evaluable_v
+    = (std::decay_t<Expr>::size > unroll_threshold) && has_runtime_element_v<Expr>;
+//@}
+
 //----------------------------------------------------------------------------
 //@{
 /** @name Vector as row matrix */
@@ -460,6 +683,42 @@ struct matrix_expression_cmp {
     }
 };
 
+/**
+ * Comparison of large matrices in a loop, row by row as the unrolled one
+ */
+template <typename LHS, typename RHS>
+struct matrix_loop_cmp {
+    using lhs_type    = std::decay_t<LHS>;
+    using rhs_type    = std::decay_t<RHS>;
+    using traits_type = traits::value_traits_t<typename lhs_type::value_type>;
+
+    static constexpr std::size_t rows = utils::min_v<lhs_type::rows, rhs_type::rows>;
+    static constexpr std::size_t cols = utils::min_v<lhs_type::cols, rhs_type::cols>;
+
+    constexpr static int
+    cmp(lhs_type const& lhs, rhs_type const& rhs)
+    {
+        for (std::size_t r = 0; r < rows; ++r) {
+            for (std::size_t c = 0; c < cols; ++c) {
+                auto const res = traits_type::cmp(lhs.element(r, c), rhs.element(r, c));
+                if (res != 0) {
+                    return res;
+                }
+            }
+        }
+        return 0;
+    }
+};
+
+/**
+ * Comparison of the first Rows rows of matrix expressions
+ */
+template <std::size_t Rows, typename LHS, typename RHS>
+using matrix_cmp_t = std::conditional_t<
+    (Rows * utils::min_v<std::decay_t<LHS>::cols, std::decay_t<RHS>::cols> > unroll_threshold
+     && has_runtime_element_v<LHS> && has_runtime_element_v<RHS>),
+    matrix_loop_cmp<LHS, RHS>, matrix_expression_cmp<Rows - 1, LHS, RHS>>;
+
 }    // namespace detail
 
 template <typename LHS, typename RHS>
@@ -470,7 +729,7 @@ struct matrix_cmp : binary_scalar_expression<matrix_cmp, LHS, RHS, int>,
     using lhs_type                        = std::decay_t<LHS>;
     using rhs_type                        = std::decay_t<RHS>;
     static constexpr std::size_t cmp_size = utils::min_v<lhs_type::rows, rhs_type::rows>;
-    using cmp_type                        = detail::matrix_expression_cmp<cmp_size - 1, LHS, RHS>;
+    using cmp_type                        = detail::matrix_cmp_t<cmp_size, LHS, RHS>;
 
     using expression_base = binary_expression<LHS, RHS>;
     using expression_base::expression_base;
@@ -500,8 +759,9 @@ struct matrix_eq : binary_scalar_expression<matrix_eq, LHS, RHS, bool>,
                    binary_expression<LHS, RHS> {
     static_assert((traits::is_matrix_expression_v<LHS> && traits::is_matrix_expression_v<RHS>),
                   "Both sides to the comparison must be matrix expressions");
-    static constexpr std::size_t cmp_size = utils::min_v<LHS::rows, RHS::rows>;
-    using cmp_type                        = detail::matrix_expression_cmp<cmp_size - 1, LHS, RHS>;
+    static constexpr std::size_t cmp_size
+        = utils::min_v<std::decay_t<LHS>::rows, std::decay_t<RHS>::rows>;
+    using cmp_type = detail::matrix_cmp_t<cmp_size, LHS, RHS>;
 
     using expression_base = binary_expression<LHS, RHS>;
     using expression_base::expression_base;
@@ -536,8 +796,9 @@ struct matrix_less : binary_scalar_expression<matrix_less, LHS, RHS, bool>,
                      binary_expression<LHS, RHS> {
     static_assert((traits::is_matrix_expression_v<LHS> && traits::is_matrix_expression_v<RHS>),
                   "Both sides to the comparison must be matrix expressions");
-    static constexpr std::size_t cmp_size = utils::min_v<LHS::rows, RHS::rows>;
-    using cmp_type                        = detail::matrix_expression_cmp<cmp_size - 1, LHS, RHS>;
+    static constexpr std::size_t cmp_size
+        = utils::min_v<std::decay_t<LHS>::rows, std::decay_t<RHS>::rows>;
+    using cmp_type = detail::matrix_cmp_t<cmp_size, LHS, RHS>;
 
     using expression_base = binary_expression<LHS, RHS>;
     using expression_base::expression_base;
@@ -578,6 +839,185 @@ operator>=(LHS&& lhs, RHS&& rhs)
 }
 //@}
 
+//----------------------------------------------------------------------------
+//@{
+/** @name Index remaps */
+template <typename Expr>
+struct matrix_transpose;
+template <typename Expr>
+struct matrix_secondary_flip;
+template <typename Expr>
+struct matrix_horizontal_flip;
+template <typename Expr>
+struct matrix_vertical_flip;
+template <typename Expr>
+struct matrix_cw_rotation;
+template <typename Expr>
+struct matrix_ccw_rotation;
+template <typename Expr>
+struct matrix_180_rotate;
+
+namespace detail {
+
+/**
+ * Remap of the element indexes of a matrix: a transposition, a flip or a
+ * rotation. Element (R, C) of the result is the element of the argument
+ * at (R, C), swapped when Swap is set, then mirrored over the rows when
+ * FlipRows is set and over the columns when FlipCols is set.
+ *
+ * The remaps are the 8 symmetries of a square, a remap of a remap is a
+ * single remap.
+ */
+template <bool Swap, bool FlipRows, bool FlipCols>
+struct index_remap {
+    static constexpr bool swap      = Swap;
+    static constexpr bool flip_rows = FlipRows;
+    static constexpr bool flip_cols = FlipCols;
+};
+using identity_remap        = index_remap<false, false, false>;
+using transpose_remap       = index_remap<true, false, false>;
+using secondary_flip_remap  = index_remap<true, true, true>;
+using horizontal_flip_remap = index_remap<false, false, true>;
+using vertical_flip_remap   = index_remap<false, true, false>;
+using cw_rotation_remap     = index_remap<true, true, false>;
+using ccw_rotation_remap    = index_remap<true, false, true>;
+using rotation_180_remap    = index_remap<false, true, true>;
+
+/**
+ * Remap of Outer applied to the result of Inner. A swap of the inner remap
+ * exchanges the flips of the outer remap.
+ */
+template <typename Outer, typename Inner>
+using compose_remaps_t
+    = index_remap<Outer::swap != Inner::swap,
+                  Inner::flip_rows != (Inner::swap ? Outer::flip_cols : Outer::flip_rows),
+                  Inner::flip_cols != (Inner::swap ? Outer::flip_rows : Outer::flip_cols)>;
+
+/**
+ * Index remap of an expression type, void for other expressions
+ */
+template <typename T>
+struct expression_remap {
+    using type = void;
+};
+template <typename Expr>
+struct expression_remap<matrix_transpose<Expr>> {
+    using type = transpose_remap;
+};
+template <typename Expr>
+struct expression_remap<matrix_secondary_flip<Expr>> {
+    using type = secondary_flip_remap;
+};
+template <typename Expr>
+struct expression_remap<matrix_horizontal_flip<Expr>> {
+    using type = horizontal_flip_remap;
+};
+template <typename Expr>
+struct expression_remap<matrix_vertical_flip<Expr>> {
+    using type = vertical_flip_remap;
+};
+template <typename Expr>
+struct expression_remap<matrix_cw_rotation<Expr>> {
+    using type = cw_rotation_remap;
+};
+template <typename Expr>
+struct expression_remap<matrix_ccw_rotation<Expr>> {
+    using type = ccw_rotation_remap;
+};
+template <typename Expr>
+struct expression_remap<matrix_180_rotate<Expr>> {
+    using type = rotation_180_remap;
+};
+template <typename T>
+using expression_remap_t = typename expression_remap<std::decay_t<T>>::type;
+
+/**
+ * Expression template for an index remap
+ */
+template <typename Remap>
+struct remap_expression;
+template <>
+struct remap_expression<transpose_remap> {
+    template <typename Expr>
+    using type = matrix_transpose<Expr>;
+};
+template <>
+struct remap_expression<secondary_flip_remap> {
+    template <typename Expr>
+    using type = matrix_secondary_flip<Expr>;
+};
+template <>
+struct remap_expression<horizontal_flip_remap> {
+    template <typename Expr>
+    using type = matrix_horizontal_flip<Expr>;
+};
+template <>
+struct remap_expression<vertical_flip_remap> {
+    template <typename Expr>
+    using type = matrix_vertical_flip<Expr>;
+};
+template <>
+struct remap_expression<cw_rotation_remap> {
+    template <typename Expr>
+    using type = matrix_cw_rotation<Expr>;
+};
+template <>
+struct remap_expression<ccw_rotation_remap> {
+    template <typename Expr>
+    using type = matrix_ccw_rotation<Expr>;
+};
+template <>
+struct remap_expression<rotation_180_remap> {
+    template <typename Expr>
+    using type = matrix_180_rotate<Expr>;
+};
+
+/**
+ * Build a remap expression, simplified at compile time:
+ *
+ *   - a remap of a remap is a single remap of the inner argument, remaps
+ *     that cancel out, e.g. a double transposition, are dropped;
+ *   - a remapped zero matrix is a zero matrix;
+ *   - the identity matrix is symmetric to the transposition, the secondary
+ *     flip and the 180 degree rotation, a diagonal matrix is symmetric to
+ *     the transposition.
+ */
+template <typename Remap, typename Expr>
+constexpr decltype(auto)
+make_remap_expression(Expr&& ex)
+{
+    using expr_type      = std::decay_t<Expr>;
+    using inner_remap    = expression_remap_t<Expr>;
+    using structure_type = matrix_structure_t<Expr>;
+    if constexpr (std::is_same<structure_type, structure::zero>::value) {
+        using result_type = std::conditional_t<Remap::swap, typename expr_type::transposed_type,
+                                               typename expr_type::matrix_type>;
+        return zero_matrix<result_type>{};
+    } else if constexpr ((std::is_same<structure_type, structure::identity>::value
+                          && Remap::flip_rows == Remap::flip_cols)
+                         || (diagonal_structure_v<structure_type>
+                             && std::is_same<Remap, transpose_remap>::value)) {
+        return simplified_operand(std::forward<Expr>(ex));
+    } else if constexpr (std::is_void<inner_remap>::value) {
+        return make_unary_expression<remap_expression<Remap>::template type>(
+            std::forward<Expr>(ex));
+    } else {
+        using remap_type = compose_remaps_t<Remap, inner_remap>;
+        // An lvalue argument of an rvalue remap is referenced, an rvalue
+        // argument is moved
+        if constexpr (std::is_same<remap_type, identity_remap>::value) {
+            return static_cast<typename expr_type::arg_storage_type>(
+                std::forward<Expr>(ex).arg());
+        } else {
+            return make_unary_expression<remap_expression<remap_type>::template type>(
+                std::forward<Expr>(ex).arg());
+        }
+    }
+}
+
+}    // namespace detail
+//@}
+
 //----------------------------------------------------------------------------
 //@{
 /** @name Matrix transposition */
@@ -606,10 +1046,10 @@ struct matrix_transpose
 };
 
 template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
-constexpr auto
+constexpr decltype(auto)
 transpose(Expr&& expr)
 {
-    return make_unary_expression<matrix_transpose>(std::forward<Expr>(expr));
+    return detail::make_remap_expression<detail::transpose_remap>(std::forward<Expr>(expr));
 }
 //@}
 
@@ -636,10 +1076,10 @@ struct matrix_secondary_flip
 };
 
 template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
-constexpr auto
+constexpr decltype(auto)
 flip_secondary(Expr&& expr)
 {
-    return make_unary_expression<matrix_secondary_flip>(std::forward<Expr>(expr));
+    return detail::make_remap_expression<detail::secondary_flip_remap>(std::forward<Expr>(expr));
 }
 //@}
 
@@ -666,10 +1106,10 @@ struct matrix_horizontal_flip
 };
 
 template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
-constexpr auto
+constexpr decltype(auto)
 flip_horizontally(Expr&& expr)
 {
-    return make_unary_expression<matrix_horizontal_flip>(std::forward<Expr>(expr));
+    return detail::make_remap_expression<detail::horizontal_flip_remap>(std::forward<Expr>(expr));
 }
 //@}
 
@@ -696,10 +1136,10 @@ struct matrix_vertical_flip
 };
 
 template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
-constexpr auto
+constexpr decltype(auto)
 flip_vertically(Expr&& expr)
 {
-    return make_unary_expression<matrix_vertical_flip>(std::forward<Expr>(expr));
+    return detail::make_remap_expression<detail::vertical_flip_remap>(std::forward<Expr>(expr));
 }
 //@}
 
@@ -726,10 +1166,10 @@ struct matrix_cw_rotation
 };
 
 template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
-constexpr auto
+constexpr decltype(auto)
 rotate_cw(Expr&& expr)
 {
-    return make_unary_expression<matrix_cw_rotation>(std::forward<Expr>(expr));
+    return detail::make_remap_expression<detail::cw_rotation_remap>(std::forward<Expr>(expr));
 }
 //@}
 
@@ -756,10 +1196,10 @@ struct matrix_ccw_rotation
 };
 
 template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
-constexpr auto
+constexpr decltype(auto)
 rotate_ccw(Expr&& expr)
 {
-    return make_unary_expression<matrix_ccw_rotation>(std::forward<Expr>(expr));
+    return detail::make_remap_expression<detail::ccw_rotation_remap>(std::forward<Expr>(expr));
 }
 //@}
 
@@ -786,17 +1226,58 @@ struct matrix_180_rotate
 };
 
 template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
-constexpr auto
+constexpr decltype(auto)
 rotate_180(Expr&& expr)
 {
-    return make_unary_expression<matrix_180_rotate>(std::forward<Expr>(expr));
+    return detail::make_remap_expression<detail::rotation_180_remap>(std::forward<Expr>(expr));
 }
 //@}
 
+//----------------------------------------------------------------------------
+//@{
+/** @name Element-wise expressions */
+/**
+ * An expression which element (R, C) depends only on the elements (R, C) of
+ * its matrix operands, e.g. a sum or a multiplication by a scalar value.
+ *
+ * A matrix is assigned such expression in place even if the expression
+ * refers to the matrix itself, e.g. m += m * 2. Other expressions, e.g.
+ * m = transpose(m) or m = m * n, are evaluated to a temporary first.
+ *
+ * Specialize the template to declare an expression element-wise.
+ * @see noalias
+ */
+template <typename T>
+struct is_elementwise : traits::is_matrix_t<T> {};
+template <typename T>
+constexpr bool is_elementwise_v = is_elementwise<std::decay_t<T>>::value;
+
+template <typename Matrix>
+struct is_elementwise<identity_matrix<Matrix>> : std::true_type {};
+template <typename Matrix>
+struct is_elementwise<zero_matrix<Matrix>> : std::true_type {};
+
+namespace detail {
+
+template <typename T>
+struct is_scalar_constant : std::false_type {};
+template <typename T>
+struct is_scalar_constant<scalar_constant<T>> : std::true_type {};
+
+/**
+ * A scalar operand that is read once, a scalar expression can refer to the
+ * assigned matrix, e.g. m *= det(m)
+ */
+template <typename T>
+constexpr bool scalar_constant_v = is_scalar_constant<std::decay_t<T>>::value;
+
+}    // namespace detail
+//@}
+
 //----------------------------------------------------------------------------
 //@{
 /** @name Matrices sum */
-template <typename LHS, typename RHS>
+template <typename LHS, typename RHS, typename = utils::void_t<>>
 struct matrix_sum_result {
     static_assert((traits::is_matrix_expression_v<LHS> && traits::is_matrix_expression_v<RHS>),
                   "Both sides to the expession must be matrix expressions");
@@ -808,8 +1289,12 @@ struct matrix_sum_result {
                                 typename rhs_type::component_names>::value),
                   "Matrices must have the same components");
     using value_type = traits::scalar_expression_result_t<lhs_type, rhs_type>;
-    using type
-        = matrix<value_type, lhs_type::rows, lhs_type::cols, typename lhs_type::component_names>;
+    using type       = matrix<value_type, lhs_type::rows, lhs_type::cols,
+                        typename lhs_type::component_names, common_layout_t<LHS, RHS>>;
+};
+template <typename LHS, typename RHS>
+struct matrix_sum_result<LHS, RHS, traits::enable_if_dynamic_matrix_expressions<LHS, RHS>> {
+    using type = dynamic_matrix<traits::scalar_expression_result_t<LHS, RHS>>;
 };
 template <typename LHS, typename RHS>
 using matrix_sum_result_t = typename matrix_sum_result<LHS, RHS>::type;
@@ -830,13 +1315,39 @@ struct matrix_sum : matrix_expression<matrix_sum<LHS, RHS>, matrix_sum_result_t<
         static_assert(C < base_type::cols, "Invalid matrix expression col index");
         return this->lhs_.template element<R, C>() + this->rhs_.template element<R, C>();
     }
+    constexpr value_type
+    element(std::size_t r, std::size_t c) const
+    {
+        return this->lhs_.element(r, c) + this->rhs_.element(r, c);
+    }
 };
 
+template <typename LHS, typename RHS>
+struct is_elementwise<matrix_sum<LHS, RHS>>
+    : utils::bool_constant<is_elementwise_v<LHS> && is_elementwise_v<RHS>> {};
+template <typename LHS, typename RHS>
+struct has_runtime_element<matrix_sum<LHS, RHS>>
+    : utils::bool_constant<has_runtime_element_v<LHS> && has_runtime_element_v<RHS>> {};
+
+/**
+ * Sum of matrices, a zero matrix operand is dropped when the other operand
+ * has the type of the result
+ */
 template <typename LHS, typename RHS, typename = traits::enable_if_matrix_expressions<LHS, RHS>>
-constexpr auto
+constexpr decltype(auto)
 operator+(LHS&& lhs, RHS&& rhs)
 {
-    return make_binary_expression<matrix_sum>(std::forward<LHS>(lhs), std::forward<RHS>(rhs));
+    using result_type = matrix_sum_result_t<LHS, RHS>;
+    if constexpr (detail::has_structure_v<LHS, structure::zero>
+                  && std::is_same<result_type, typename std::decay_t<RHS>::matrix_type>::value) {
+        return detail::simplified_operand(std::forward<RHS>(rhs));
+    } else if constexpr (detail::has_structure_v<RHS, structure::zero>
+                         && std::is_same<result_type,
+                                         typename std::decay_t<LHS>::matrix_type>::value) {
+        return detail::simplified_operand(std::forward<LHS>(lhs));
+    } else {
+        return make_binary_expression<matrix_sum>(std::forward<LHS>(lhs), std::forward<RHS>(rhs));
+    }
 }
 //@}
 
@@ -860,20 +1371,42 @@ struct matrix_diff : matrix_expression<matrix_diff<LHS, RHS>, matrix_sum_result_
         static_assert(C < base_type::cols, "Invalid matrix expression col index");
         return this->lhs_.template element<R, C>() - this->rhs_.template element<R, C>();
     }
+    constexpr value_type
+    element(std::size_t r, std::size_t c) const
+    {
+        return this->lhs_.element(r, c) - this->rhs_.element(r, c);
+    }
 };
 
+template <typename LHS, typename RHS>
+struct is_elementwise<matrix_diff<LHS, RHS>>
+    : utils::bool_constant<is_elementwise_v<LHS> && is_elementwise_v<RHS>> {};
+template <typename LHS, typename RHS>
+struct has_runtime_element<matrix_diff<LHS, RHS>>
+    : utils::bool_constant<has_runtime_element_v<LHS> && has_runtime_element_v<RHS>> {};
+
+/**
+ * Difference of matrices, a zero matrix subtrahend is dropped when the
+ * minuend has the type of the result
+ */
 template <typename LHS, typename RHS, typename = traits::enable_if_matrix_expressions<LHS, RHS>>
-constexpr auto
+constexpr decltype(auto)
 operator-(LHS&& lhs, RHS&& rhs)
 {
-    return make_binary_expression<matrix_diff>(std::forward<LHS>(lhs), std::forward<RHS>(rhs));
+    if constexpr (detail::has_structure_v<RHS, structure::zero>
+                  && std::is_same<matrix_sum_result_t<LHS, RHS>,
+                                  typename std::decay_t<LHS>::matrix_type>::value) {
+        return detail::simplified_operand(std::forward<LHS>(lhs));
+    } else {
+        return make_binary_expression<matrix_diff>(std::forward<LHS>(lhs), std::forward<RHS>(rhs));
+    }
 }
 //@}
 
 //----------------------------------------------------------------------------
 //@{
 /** @name Matrix by scalar multiplication */
-template <typename LHS, typename RHS>
+template <typename LHS, typename RHS, typename = utils::void_t<>>
 struct matrix_scalar_mul_result {
     static_assert((traits::is_matrix_expression_v<LHS>),
                   "Left side to the expession must be matrix expressions");
@@ -882,8 +1415,12 @@ struct matrix_scalar_mul_result {
     using lhs_type   = std::decay_t<LHS>;
     using rhs_type   = std::decay_t<RHS>;
     using value_type = traits::scalar_expression_result_t<lhs_type, rhs_type>;
-    using type
-        = matrix<value_type, lhs_type::rows, lhs_type::cols, typename lhs_type::component_names>;
+    using type       = matrix<value_type, lhs_type::rows, lhs_type::cols,
+                        typename lhs_type::component_names, matrix_layout_t<LHS>>;
+};
+template <typename LHS, typename RHS>
+struct matrix_scalar_mul_result<LHS, RHS, traits::enable_if_dynamic_matrix_expression<LHS>> {
+    using type = dynamic_matrix<traits::scalar_expression_result_t<LHS, RHS>>;
 };
 template <typename LHS, typename RHS>
 using matrix_scalar_mul_result_t = typename matrix_scalar_mul_result<LHS, RHS>::type;
@@ -907,7 +1444,19 @@ struct matrix_scalar_multiply
         static_assert(C < base_type::cols, "Invalid matrix expression col index");
         return this->lhs_.template element<R, C>() * this->rhs_;
     }
+    constexpr value_type
+    element(std::size_t r, std::size_t c) const
+    {
+        return this->lhs_.element(r, c) * this->rhs_;
+    }
 };
+
+template <typename LHS, typename RHS>
+struct is_elementwise<matrix_scalar_multiply<LHS, RHS>>
+    : utils::bool_constant<is_elementwise_v<LHS> && detail::scalar_constant_v<RHS>> {};
+template <typename LHS, typename RHS>
+struct has_runtime_element<matrix_scalar_multiply<LHS, RHS>>
+    : utils::bool_constant<has_runtime_element_v<LHS>> {};
 //@}
 
 //----------------------------------------------------------------------------
@@ -932,8 +1481,20 @@ struct matrix_scalar_divide
         static_assert(C < base_type::cols, "Invalid matrix expression col index");
         return this->lhs_.template element<R, C>() / this->rhs_;
     }
+    constexpr value_type
+    element(std::size_t r, std::size_t c) const
+    {
+        return this->lhs_.element(r, c) / this->rhs_;
+    }
 };
 
+template <typename LHS, typename RHS>
+struct is_elementwise<matrix_scalar_divide<LHS, RHS>>
+    : utils::bool_constant<is_elementwise_v<LHS> && detail::scalar_constant_v<RHS>> {};
+template <typename LHS, typename RHS>
+struct has_runtime_element<matrix_scalar_divide<LHS, RHS>>
+    : utils::bool_constant<has_runtime_element_v<LHS>> {};
+
 template <typename LHS, typename RHS,
           typename
           = std::enable_if_t<traits::is_matrix_expression_v<LHS> && traits::is_scalar_v<RHS>>>
@@ -945,6 +1506,68 @@ operator/(LHS&& lhs, RHS&& rhs)
 }
 //@}
 
+//----------------------------------------------------------------------------
+//@{
+/** @name Matrix negation */
+template <typename Expr>
+struct matrix_negate
+    : matrix_expression<matrix_negate<Expr>, typename std::decay_t<Expr>::matrix_type>,
+      unary_expression<Expr> {
+    using base_type
+        = matrix_expression<matrix_negate<Expr>, typename std::decay_t<Expr>::matrix_type>;
+    using value_type      = typename base_type::value_type;
+    using expression_base = unary_expression<Expr>;
+    using expression_base::expression_base;
+
+    template <std::size_t R, std::size_t C>
+    constexpr value_type
+    element() const
+    {
+        static_assert(R < base_type::rows, "Invalid matrix expression row index");
+        static_assert(C < base_type::cols, "Invalid matrix expression col index");
+        return -this->arg_.template element<R, C>();
+    }
+    constexpr value_type
+    element(std::size_t r, std::size_t c) const
+    {
+        return -this->arg_.element(r, c);
+    }
+};
+
+template <typename Expr>
+struct is_elementwise<matrix_negate<Expr>> : utils::bool_constant<is_elementwise_v<Expr>> {};
+template <typename Expr>
+struct has_runtime_element<matrix_negate<Expr>>
+    : utils::bool_constant<has_runtime_element_v<Expr>> {};
+
+namespace detail {
+
+template <typename T>
+struct is_matrix_negate : std::false_type {};
+template <typename Expr>
+struct is_matrix_negate<matrix_negate<Expr>> : std::true_type {};
+
+}    // namespace detail
+
+/**
+ * Negated matrix, a double negation is the argument and a negated zero
+ * matrix is zero
+ */
+template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
+constexpr decltype(auto)
+operator-(Expr&& ex)
+{
+    using expr_type = std::decay_t<Expr>;
+    if constexpr (detail::has_structure_v<Expr, structure::zero>) {
+        return detail::simplified_operand(std::forward<Expr>(ex));
+    } else if constexpr (detail::is_matrix_negate<expr_type>::value) {
+        return static_cast<typename expr_type::arg_storage_type>(std::forward<Expr>(ex).arg());
+    } else {
+        return make_unary_expression<matrix_negate>(std::forward<Expr>(ex));
+    }
+}
+//@}
+
 //----------------------------------------------------------------------------
 //@{
 /** @name Matrix-matrix multiplication */
@@ -960,19 +1583,766 @@ struct matrix_matrix_mul_result {
                   "Matrices must have the same components");
     using value_type      = traits::scalar_expression_result_t<lhs_type, rhs_type>;
     using component_names = traits::component_names_for_t<LHS, RHS>;
-    using type            = matrix<value_type, lhs_type::rows, rhs_type::cols, component_names>;
+    using type            = matrix<value_type, lhs_type::rows, rhs_type::cols, component_names,
+                        common_layout_t<LHS, RHS>>;
 };
 
 template <typename LHS, typename RHS>
 using matrix_matrix_mul_result_t = typename matrix_matrix_mul_result<LHS, RHS>::type;
 
 template <typename LHS, typename RHS>
-struct matrix_matrix_multiply
-    : matrix_expression<matrix_matrix_multiply<LHS, RHS>, matrix_matrix_mul_result_t<LHS, RHS>>,
+struct matrix_matrix_multiply
+    : matrix_expression<matrix_matrix_multiply<LHS, RHS>, matrix_matrix_mul_result_t<LHS, RHS>>,
+      binary_expression<LHS, RHS> {
+
+    using base_type
+        = matrix_expression<matrix_matrix_multiply<LHS, RHS>, matrix_matrix_mul_result_t<LHS, RHS>>;
+    using value_type      = typename base_type::value_type;
+    using expression_base = binary_expression<LHS, RHS>;
+    using expression_base::expression_base;
+
+    template <std::size_t R, std::size_t C>
+    constexpr value_type
+    element() const
+    {
+        static_assert(R < base_type::rows, "Invalid matrix expression row index");
+        static_assert(C < base_type::cols, "Invalid matrix expression col index");
+        return row_col_dot<R, C>(std::make_index_sequence<std::decay_t<LHS>::cols>{});
+    }
+
+private:
+    /**
+     * The elements of a product are independent and overlap in the pipeline,
+     * so an element is accumulated in a single chain, unlike a dot product of
+     * vectors. The same chain for each element of a row is vectorized.
+     */
+    template <std::size_t R, std::size_t C, std::size_t First, std::size_t... K>
+    constexpr value_type
+    row_col_dot(std::index_sequence<First, K...>) const
+    {
+        value_type res
+            = this->lhs_.template element<R, First>() * this->rhs_.template element<First, C>();
+        ((res = utils::multiply_add<value_type>(this->lhs_.template element<R, K>(),
+                                                this->rhs_.template element<K, C>(), res)),
+         ...);
+        return res;
+    }
+};
+
+template <typename T>
+struct is_matrix_product : std::false_type {};
+template <typename LHS, typename RHS>
+struct is_matrix_product<matrix_matrix_multiply<LHS, RHS>> : std::true_type {};
+
+/**
+ * An expression containing a matrix product, a product of a product or e.g.
+ * a transposed sum of products or a minor of a product. The arguments are
+ * looked into by expression_arguments.
+ */
+template <typename T, typename Args = expression_arguments_t<T>>
+struct contains_matrix_product;
+template <typename T, typename... Args>
+struct contains_matrix_product<T, std::tuple<Args...>>
+    : std::integral_constant<bool, is_matrix_product<T>::value
+                                       || (contains_matrix_product<std::decay_t<Args>>::value
+                                           || ...)> {};
+
+/**
+ * Evaluation policy for operands of a matrix product.
+ *
+ * Each element of a lazy product reads a whole row and a whole column of the
+ * operands, so an operand that is a product itself would be recomputed for
+ * every element of the result, e.g. A * B * C is O(n^4) instead of O(n^3).
+ * Such operands are evaluated to a temporary matrix when the product
+ * expression is built.
+ *
+ * Specialize the template to change the policy for an expression type. An
+ * operand can be evaluated explicitly with eval().
+ */
+template <typename T>
+struct materialize_product_operand
+    : std::integral_constant<bool, traits::is_matrix_expression_v<T>
+                                       && contains_matrix_product<std::decay_t<T>>::value> {};
+template <typename T>
+constexpr bool materialize_product_operand_v = materialize_product_operand<std::decay_t<T>>::value;
+
+namespace detail {
+
+template <typename Expr>
+constexpr decltype(auto)
+product_operand(Expr&& ex)
+{
+    if constexpr (materialize_product_operand_v<Expr>) {
+        return eval(std::forward<Expr>(ex));
+    } else {
+        return std::forward<Expr>(ex);
+    }
+}
+
+}    // namespace detail
+
+/**
+ * Number of multiply-adds (rows * cols * inner size) from which a floating
+ * point matrix product is evaluated with the blocked multiply when it is
+ * assigned to a matrix. Smaller products are evaluated element by element,
+ * that is faster when the whole product fits into registers.
+ */
+constexpr std::size_t blocked_product_threshold = 4096;
+
+template <typename T>
+struct use_blocked_product : std::false_type {};
+template <typename LHS, typename RHS>
+struct use_blocked_product<matrix_matrix_multiply<LHS, RHS>>
+    : std::integral_constant<
+          bool, std::is_floating_point<
+                    typename matrix_matrix_multiply<LHS, RHS>::value_type>::value
+                    && (std::decay_t<LHS>::rows * std::decay_t<LHS>::cols
+                            * std::decay_t<RHS>::cols
+                        >= blocked_product_threshold)> {};
+template <typename T>
+constexpr bool use_blocked_product_v = use_blocked_product<std::decay_t<T>>::value;
+
+namespace detail {
+
+/**
+ * Operand of the blocked multiply, a matrix of the value type T and of the
+ * Layout. A matrix of the type is used as is, other expressions are
+ * evaluated.
+ */
+template <typename T, typename Layout, typename Expr>
+decltype(auto)
+blocked_product_operand(Expr const& ex)
+{
+    using expr_type = std::decay_t<Expr>;
+    if constexpr (traits::is_matrix_v<expr_type>
+                  && std::is_same<typename expr_type::value_type, T>::value
+                  && std::is_same<matrix_layout_t<expr_type>, Layout>::value) {
+        return ex;
+    } else {
+        return matrix<T, expr_type::rows, expr_type::cols, typename expr_type::component_names,
+                      Layout>{ex};
+    }
+}
+
+/**
+ * Evaluate a matrix product to a matrix with the blocked multiply.
+ *
+ * The operands are converted to the layout of the result. The storage of a
+ * column-major matrix is the storage of the transposed row-major matrix, so
+ * a column-major product is computed as the row-major product of the
+ * transposed operands in reverse order.
+ */
+template <typename LHS, typename RHS, typename Matrix>
+void
+blocked_product(matrix_matrix_multiply<LHS, RHS> const& ex, Matrix& res)
+{
+    using value_type  = typename Matrix::value_type;
+    using layout_type = typename Matrix::layout_type;
+    auto const& a     = blocked_product_operand<value_type, layout_type>(ex.lhs());
+    auto const& b     = blocked_product_operand<value_type, layout_type>(ex.rhs());
+    using lhs_type    = std::decay_t<decltype(a)>;
+    using rhs_type    = std::decay_t<decltype(b)>;
+    if constexpr (Matrix::col_major) {
+        math::detail::gemm<Matrix::cols, Matrix::rows, lhs_type::cols>(
+            b.data(), rhs_type::major_stride, a.data(), lhs_type::major_stride, res.data(),
+            Matrix::major_stride);
+    } else {
+        math::detail::gemm<Matrix::rows, Matrix::cols, lhs_type::cols>(
+            a.data(), lhs_type::major_stride, b.data(), rhs_type::major_stride, res.data(),
+            Matrix::major_stride);
+    }
+}
+
+/**
+ * A square matrix of value type T that can be loaded to the SIMD matrix
+ * kernels as is, the rows (or columns) are consecutive and the elements have
+ * no value policies.
+ */
+template <typename T, typename Matrix, typename = utils::void_t<>>
+struct simd_kernel_matrix : std::false_type {};
+template <typename T, typename Matrix>
+struct simd_kernel_matrix<T, Matrix, std::enable_if_t<traits::is_matrix_v<Matrix>>>
+    : utils::bool_constant<
+          std::is_same<typename Matrix::value_type, T>::value && Matrix::rows == Matrix::cols
+          && simd::matrix_kernels_enabled_v<T, Matrix::rows>
+          && Matrix::major_stride == Matrix::cols
+          && v::detail::simd_plain_components_v<T, typename Matrix::component_names>> {};
+
+/**
+ * A column vector that is evaluated in the register of the SIMD matrix
+ * kernels for Size x Size matrices of T.
+ */
+template <typename T, std::size_t Size, typename Expr, typename = utils::void_t<>>
+struct simd_kernel_column : std::false_type {};
+template <typename T, std::size_t Size, typename Vector>
+struct simd_kernel_column<T, Size, vector_as_col_matrix<Vector>,
+                          std::enable_if_t<simd::matrix_kernels_enabled_v<
+                                               T, Size> && simd_evaluable_v<Vector>>>
+    : std::is_same<typename simd::matrix_kernels<T, Size>::register_traits,
+                   v::detail::simd_register_for<Vector>> {};
+
+}    // namespace detail
+
+/**
+ * A product of square matrices or of a square matrix and a column vector
+ * that is computed with the SIMD matrix kernels, e.g. 4x4 float matrices
+ * with SSE enabled.
+ */
+template <typename T>
+struct use_simd_product : std::false_type {};
+template <typename LHS, typename RHS>
+struct use_simd_product<matrix_matrix_multiply<LHS, RHS>>
+    : utils::bool_constant<
+          detail::simd_kernel_matrix<typename matrix_matrix_multiply<LHS, RHS>::value_type,
+                                     std::decay_t<LHS>>::value
+          && ((detail::simd_kernel_matrix<typename matrix_matrix_multiply<LHS, RHS>::value_type,
+                                          std::decay_t<RHS>>::value
+               && std::is_same<matrix_layout_t<LHS>, matrix_layout_t<RHS>>::value)
+              || detail::simd_kernel_column<typename matrix_matrix_multiply<LHS, RHS>::value_type,
+                                            std::decay_t<LHS>::rows, std::decay_t<RHS>>::value)> {
+};
+template <typename T>
+constexpr bool use_simd_product_v = use_simd_product<std::decay_t<T>>::value;
+
+/**
+ * The product is evaluated with a dedicated kernel when it is assigned to a
+ * matrix
+ */
+template <typename T>
+constexpr bool use_product_kernel_v = use_blocked_product_v<T> || use_simd_product_v<T>;
+
+/**
+ * The product is evaluated with a dedicated kernel when it is assigned to a
+ * matrix of the same size. The kernels write the whole product, a matrix of
+ * a different size is initialized element by element.
+ */
+template <typename T, typename Matrix>
+struct use_product_kernel_for : std::false_type {};
+template <typename LHS, typename RHS, typename Matrix>
+struct use_product_kernel_for<matrix_matrix_multiply<LHS, RHS>, Matrix>
+    : utils::bool_constant<use_product_kernel_v<matrix_matrix_multiply<LHS, RHS>>
+                           && matrix_matrix_multiply<LHS, RHS>::rows == Matrix::rows
+                           && matrix_matrix_multiply<LHS, RHS>::cols == Matrix::cols> {};
+template <typename T, typename Matrix>
+constexpr bool use_product_kernel_for_v
+    = use_product_kernel_for<std::decay_t<T>, std::decay_t<Matrix>>::value;
+
+namespace detail {
+
+/**
+ * Columns of a square matrix loaded to the registers of the SIMD matrix
+ * kernels, a column-major matrix is loaded as is
+ */
+template <typename Matrix>
+auto
+simd_kernel_columns(Matrix const& m)
+{
+    using kernels = simd::matrix_kernels<typename Matrix::value_type, Matrix::rows>;
+    if constexpr (Matrix::col_major) {
+        return kernels::load_stored_columns(m.data());
+    } else {
+        return kernels::load_columns(m.data());
+    }
+}
+
+/**
+ * Evaluate a product with the SIMD kernels. The result has the layout of the
+ * operands, a column-major product is computed as the row-major product of
+ * the transposed operands in reverse order.
+ */
+template <typename LHS, typename RHS, typename Matrix>
+void
+simd_product(matrix_matrix_multiply<LHS, RHS> const& ex, Matrix& res)
+{
+    using kernels = simd::matrix_kernels<typename Matrix::value_type, std::decay_t<LHS>::rows>;
+    if constexpr (traits::is_matrix_v<std::decay_t<RHS>>) {
+        if constexpr (Matrix::col_major) {
+            kernels::multiply(ex.rhs().data(), ex.lhs().data(), res.data());
+        } else {
+            kernels::multiply(ex.lhs().data(), ex.rhs().data(), res.data());
+        }
+    } else {
+        static_assert(Matrix::col_major || Matrix::major_stride == 1,
+                      "Column matrix elements must be consecutive");
+        auto const col
+            = kernels::multiply(simd_kernel_columns(ex.lhs()), simd_eval(ex.rhs().arg()));
+        kernels::register_traits::store(res.data(), col);
+    }
+}
+
+/**
+ * Evaluate a matrix product to a matrix with the blocked multiply or with
+ * the SIMD kernels
+ */
+template <typename Expr, typename Matrix>
+void
+product_kernel(Expr const& ex, Matrix& res)
+{
+    static_assert(use_product_kernel_for_v<Expr, Matrix>,
+                  "The product kernels write a matrix of the size of the product");
+    if constexpr (use_blocked_product_v<Expr>) {
+        blocked_product(ex, res);
+    } else {
+        using result_type = typename Expr::result_type;
+        if constexpr (std::is_same<Matrix, result_type>::value) {
+            simd_product(ex, res);
+        } else {
+            // The kernels write the result type only
+            result_type tmp;
+            simd_product(ex, tmp);
+            res = Matrix{tmp};
+        }
+    }
+}
+
+/**
+ * Row and column of the element I of a matrix in the storage order
+ */
+template <typename Matrix, std::size_t I>
+constexpr std::size_t storage_row_v = Matrix::col_major ? I % Matrix::rows : I / Matrix::cols;
+template <typename Matrix, std::size_t I>
+constexpr std::size_t storage_col_v = Matrix::col_major ? I / Matrix::rows : I % Matrix::cols;
+
+template <typename Matrix, typename Expr, std::size_t... I>
+constexpr void
+assign_elements(Matrix& res, Expr const& ex, std::index_sequence<I...>)
+{
+    using value_type = typename Matrix::value_type;
+    ((res.template element<storage_row_v<Matrix, I>, storage_col_v<Matrix, I>>()
+      = static_cast<value_type>(
+          ex.template element<storage_row_v<Matrix, I>, storage_col_v<Matrix, I>>())),
+     ...);
+}
+
+/**
+ * Assign an expression to a matrix element by element, without a temporary.
+ * Element (R, C) of the expression is read right before element (R, C) of
+ * the matrix is written, so the expression can refer to the matrix only if
+ * it is element-wise.
+ *
+ * @see is_elementwise
+ */
+template <typename Matrix, typename Expr>
+constexpr void
+assign_elements(Matrix& res, Expr const& ex)
+{
+    using expr_type = std::decay_t<Expr>;
+    static_assert(expr_type::rows == Matrix::rows && expr_type::cols == Matrix::cols,
+                  "Matrices must be of equal size");
+    if constexpr (matrix_loop_evaluable_v<Expr>) {
+        using value_type = typename Matrix::value_type;
+        // Inner loop over the elements adjacent in the storage
+        constexpr std::size_t major_count = Matrix::col_major ? Matrix::cols : Matrix::rows;
+        constexpr std::size_t minor_count = Matrix::col_major ? Matrix::rows : Matrix::cols;
+        for (std::size_t i = 0; i < major_count; ++i) {
+            for (std::size_t j = 0; j < minor_count; ++j) {
+                auto const r      = Matrix::col_major ? j : i;
+                auto const c      = Matrix::col_major ? i : j;
+                res.element(r, c) = static_cast<value_type>(ex.element(r, c));
+            }
+        }
+    } else {
+        assign_elements(res, ex, std::make_index_sequence<Matrix::size>{});
+    }
+}
+
+}    // namespace detail
+
+//----------------------------------------------------------------------------
+//@{
+/** @name Structured matrices */
+/**
+ * Diagonal matrix, e.g. a scaling transform. Only the diagonal is stored.
+ */
+template <typename Matrix>
+struct diagonal_matrix : matrix_expression<diagonal_matrix<Matrix>, Matrix> {
+    using base_type     = matrix_expression<diagonal_matrix<Matrix>, Matrix>;
+    using value_type    = typename base_type::value_type;
+    using diagonal_type = typename base_type::row_type;
+
+    static_assert(base_type::cols == base_type::rows,
+                  "Diagonal matrix is defined only for square matrices");
+
+    constexpr diagonal_matrix() = default;
+    constexpr explicit diagonal_matrix(diagonal_type const& diag) : diagonal_{diag} {}
+
+    template <std::size_t R, std::size_t C>
+    constexpr value_type
+    element() const
+    {
+        static_assert(R < base_type::rows, "Invalid matrix expression row index");
+        static_assert(C < base_type::cols, "Invalid matrix expression col index");
+        if constexpr (R == C) {
+            return diagonal_[R];
+        } else {
+            return value_type{0};
+        }
+    }
+    constexpr value_type
+    element(std::size_t r, std::size_t c) const
+    {
+        return r == c ? diagonal_[r] : value_type{0};
+    }
+
+    constexpr diagonal_type const&
+    diagonal() const
+    {
+        return diagonal_;
+    }
+
+private:
+    diagonal_type diagonal_;
+};
+
+template <typename Matrix>
+struct matrix_structure<diagonal_matrix<Matrix>> {
+    using type = structure::diagonal;
+};
+template <typename Matrix>
+struct is_elementwise<diagonal_matrix<Matrix>> : std::true_type {};
+template <typename Matrix>
+struct has_runtime_element<diagonal_matrix<Matrix>> : std::true_type {};
+
+/**
+ * Diagonal matrix with the elements of a vector on the main diagonal
+ */
+template <typename Vector, typename = traits::enable_if_vector_expression<Vector>>
+constexpr auto
+diagonal(Vector&& diag)
+{
+    using vector_type = std::decay_t<Vector>;
+    using value_type  = typename vector_type::value_type;
+    using matrix_type = matrix<value_type, vector_type::size, vector_type::size>;
+    return diagonal_matrix<matrix_type>{
+        typename matrix_type::row_type(std::forward<Vector>(diag))};
+}
+
+/**
+ * Scaling transform in homogeneous coordinates, a diagonal matrix one larger
+ * than the scale vector, e.g. 4x4 for a 3D scale. The last diagonal element
+ * is 1.
+ */
+template <typename Vector, typename = traits::enable_if_vector_expression<Vector>>
+constexpr auto
+scaling(Vector&& scale)
+{
+    using vector_type      = std::decay_t<Vector>;
+    using value_type       = typename vector_type::value_type;
+    constexpr auto size    = vector_type::size + 1;
+    using matrix_type      = matrix<value_type, size, size>;
+    typename vector_type::result_type const src(std::forward<Vector>(scale));
+    typename matrix_type::row_type          diag;
+    for (std::size_t i = 0; i < vector_type::size; ++i) {
+        diag[i] = src[i];
+    }
+    diag[size - 1] = value_type{1};
+    return diagonal_matrix<matrix_type>{diag};
+}
+
+/**
+ * View of the lower or upper triangle of a square matrix expression, the
+ * elements on the other side of the main diagonal are zeros.
+ */
+template <typename Expr, typename Structure>
+struct triangular_matrix
+    : matrix_expression<triangular_matrix<Expr, Structure>,
+                        typename std::decay_t<Expr>::matrix_type>,
+      unary_expression<Expr> {
+    using base_type = matrix_expression<triangular_matrix<Expr, Structure>,
+                                        typename std::decay_t<Expr>::matrix_type>;
+    using value_type      = typename base_type::value_type;
+    using expression_base = unary_expression<Expr>;
+    using expression_base::expression_base;
+
+    static_assert(std::is_same<Structure, structure::lower_triangular>::value
+                      || std::is_same<Structure, structure::upper_triangular>::value,
+                  "Triangular matrix is either lower or upper");
+    static_assert(base_type::cols == base_type::rows,
+                  "Triangular matrix is defined only for square matrices");
+
+    template <std::size_t R, std::size_t C>
+    constexpr value_type
+    element() const
+    {
+        static_assert(R < base_type::rows, "Invalid matrix expression row index");
+        static_assert(C < base_type::cols, "Invalid matrix expression col index");
+        if constexpr (detail::lower_structure_v<Structure> ? C <= R : R <= C) {
+            return this->arg_.template element<R, C>();
+        } else {
+            return value_type{0};
+        }
+    }
+    constexpr value_type
+    element(std::size_t r, std::size_t c) const
+    {
+        if (detail::lower_structure_v<Structure> ? c <= r : r <= c) {
+            return this->arg_.element(r, c);
+        }
+        return value_type{0};
+    }
+};
+
+template <typename Expr, typename Structure>
+struct matrix_structure<triangular_matrix<Expr, Structure>> {
+    using type = Structure;
+};
+template <typename Expr, typename Structure>
+struct is_elementwise<triangular_matrix<Expr, Structure>>
+    : utils::bool_constant<is_elementwise_v<Expr>> {};
+template <typename Expr, typename Structure>
+struct has_runtime_element<triangular_matrix<Expr, Structure>>
+    : utils::bool_constant<has_runtime_element_v<Expr>> {};
+
+/**
+ * Lower triangle of a square matrix, the elements above the main diagonal
+ * are zeros
+ */
+template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
+constexpr auto
+lower_triangular(Expr&& expr)
+{
+    return make_unary_expression<triangular_matrix, structure::lower_triangular>(
+        std::forward<Expr>(expr));
+}
+
+/**
+ * Upper triangle of a square matrix, the elements below the main diagonal
+ * are zeros
+ */
+template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
+constexpr auto
+upper_triangular(Expr&& expr)
+{
+    return make_unary_expression<triangular_matrix, structure::upper_triangular>(
+        std::forward<Expr>(expr));
+}
+
+/**
+ * Permutation matrix, row r has the one in column col_index(r). Row r of
+ * the product P * M is row col_index(r) of M. The indexes in both directions
+ * are stored.
+ */
+template <typename Matrix>
+struct permutation_matrix : matrix_expression<permutation_matrix<Matrix>, Matrix> {
+    using base_type  = matrix_expression<permutation_matrix<Matrix>, Matrix>;
+    using value_type = typename base_type::value_type;
+    using index_type = std::array<std::size_t, base_type::rows>;
+
+    static_assert(base_type::cols == base_type::rows,
+                  "Permutation matrix is defined only for square matrices");
+
+    /**
+     * Identity permutation
+     */
+    permutation_matrix()
+    {
+        for (std::size_t i = 0; i < base_type::rows; ++i) {
+            col_indexes_[i] = row_indexes_[i] = i;
+        }
+    }
+    /**
+     * @param cols Column of the one in each row
+     * @throws std::runtime_error if the indexes are not a permutation
+     */
+    explicit permutation_matrix(index_type const& cols) : col_indexes_{cols}
+    {
+        row_indexes_.fill(base_type::rows);
+        for (std::size_t r = 0; r < base_type::rows; ++r) {
+            auto const c = col_indexes_[r];
+            if (c >= base_type::rows || row_indexes_[c] != base_type::rows)
+                throw std::runtime_error("Invalid permutation");
+            row_indexes_[c] = r;
+        }
+    }
+
+    template <std::size_t R, std::size_t C>
+    constexpr value_type
+    element() const
+    {
+        static_assert(R < base_type::rows, "Invalid matrix expression row index");
+        static_assert(C < base_type::cols, "Invalid matrix expression col index");
+        return col_indexes_[R] == C ? value_type{1} : value_type{0};
+    }
+
+    /**
+     * Column of the one in row r
+     */
+    std::size_t
+    col_index(std::size_t r) const
+    {
+        return col_indexes_[r];
+    }
+    /**
+     * Row of the one in column c
+     */
+    std::size_t
+    row_index(std::size_t c) const
+    {
+        return row_indexes_[c];
+    }
+
+    /**
+     * 1 for an even permutation, -1 for an odd one
+     */
+    int
+    sign() const
+    {
+        int                                 res = 1;
+        std::array<bool, base_type::rows> visited{};
+        for (std::size_t i = 0; i < base_type::rows; ++i) {
+            // A cycle of even length is an odd number of swaps
+            std::size_t length = 0;
+            for (auto j = i; !visited[j]; j = col_indexes_[j], ++length) {
+                visited[j] = true;
+            }
+            if (length > 0 && length % 2 == 0) {
+                res = -res;
+            }
+        }
+        return res;
+    }
+
+private:
+    index_type col_indexes_;
+    index_type row_indexes_;
+};
+
+template <typename Matrix>
+struct matrix_structure<permutation_matrix<Matrix>> {
+    using type = structure::permutation;
+};
+
+/**
+ * Permutation matrix with the one of row r in column cols[r]
+ *
+ * @throws std::runtime_error if the indexes are not a permutation
+ */
+template <typename Matrix, typename = traits::enable_if_matrix_expression<Matrix>>
+auto
+permutation(std::array<std::size_t, std::decay_t<Matrix>::rows> const& cols)
+{
+    return permutation_matrix<std::decay_t<Matrix>>{cols};
+}
+
+namespace detail {
+
+/**
+ * Structure of a product of triangular or diagonal matrices
+ */
+template <typename LHS, typename RHS>
+using product_structure_t = std::conditional_t<
+    diagonal_structure_v<LHS> && diagonal_structure_v<RHS>, structure::diagonal,
+    std::conditional_t<
+        lower_structure_v<LHS> && lower_structure_v<RHS>, structure::lower_triangular,
+        std::conditional_t<upper_structure_v<LHS> && upper_structure_v<RHS>,
+                           structure::upper_triangular, structure::general>>>;
+
+}    // namespace detail
+
+/**
+ * Product with a triangular or a diagonal operand. The sum for an element
+ * runs only over the inner indexes where both the row of the left hand
+ * operand and the column of the right hand operand can be non-zero, e.g. a
+ * single multiplication for a diagonal operand.
+ */
+template <typename LHS, typename RHS>
+struct matrix_structured_multiply
+    : matrix_expression<matrix_structured_multiply<LHS, RHS>, matrix_matrix_mul_result_t<LHS, RHS>>,
+      binary_expression<LHS, RHS> {
+
+    using base_type       = matrix_expression<matrix_structured_multiply<LHS, RHS>,
+                                        matrix_matrix_mul_result_t<LHS, RHS>>;
+    using value_type      = typename base_type::value_type;
+    using expression_base = binary_expression<LHS, RHS>;
+    using expression_base::expression_base;
+
+    template <std::size_t R, std::size_t C>
+    constexpr value_type
+    element() const
+    {
+        static_assert(R < base_type::rows, "Invalid matrix expression row index");
+        static_assert(C < base_type::cols, "Invalid matrix expression col index");
+        using lhs_structure  = matrix_structure_t<LHS>;
+        using rhs_structure  = matrix_structure_t<RHS>;
+        constexpr auto inner = std::decay_t<LHS>::cols;
+        constexpr auto begin
+            = std::max(detail::upper_structure_v<lhs_structure> ? R : std::size_t{0},
+                       detail::lower_structure_v<rhs_structure> ? C : std::size_t{0});
+        constexpr auto end = std::min(detail::lower_structure_v<lhs_structure> ? R + 1 : inner,
+                                      detail::upper_structure_v<rhs_structure> ? C + 1 : inner);
+        if constexpr (begin < end) {
+            return partial_dot<R, C, begin>(std::make_index_sequence<end - begin>{});
+        } else {
+            return value_type{0};
+        }
+    }
+
+private:
+    template <std::size_t R, std::size_t C, std::size_t Begin, std::size_t... K>
+    constexpr value_type
+    partial_dot(std::index_sequence<K...>) const
+    {
+        value_type res{0};
+        ((res = utils::multiply_add<value_type>(this->lhs_.template element<R, Begin + K>(),
+                                                this->rhs_.template element<Begin + K, C>(), res)),
+         ...);
+        return res;
+    }
+};
+
+template <typename LHS, typename RHS>
+struct matrix_structure<matrix_structured_multiply<LHS, RHS>> {
+    using type = detail::product_structure_t<matrix_structure_t<LHS>, matrix_structure_t<RHS>>;
+};
+
+/**
+ * An element of a product with a triangular operand is a sum, the product is
+ * evaluated when it is an operand of another product. An element of a
+ * product with a diagonal operand is a single multiplication.
+ */
+template <typename LHS, typename RHS>
+struct is_matrix_product<matrix_structured_multiply<LHS, RHS>>
+    : utils::bool_constant<!detail::diagonal_structure_v<matrix_structure_t<LHS>>
+                           && !detail::diagonal_structure_v<matrix_structure_t<RHS>>> {};
+
+/**
+ * Product of a permutation matrix and a matrix, the rows of the matrix are
+ * permuted
+ */
+template <typename LHS, typename RHS>
+struct matrix_row_permutation
+    : matrix_expression<matrix_row_permutation<LHS, RHS>, matrix_matrix_mul_result_t<LHS, RHS>>,
+      binary_expression<LHS, RHS> {
+    static_assert(traits::is_matrix_v<std::decay_t<RHS>>, "Rows of a matrix are permuted");
+
+    using base_type
+        = matrix_expression<matrix_row_permutation<LHS, RHS>, matrix_matrix_mul_result_t<LHS, RHS>>;
+    using value_type      = typename base_type::value_type;
+    using expression_base = binary_expression<LHS, RHS>;
+    using expression_base::expression_base;
+
+    template <std::size_t R, std::size_t C>
+    constexpr value_type
+    element() const
+    {
+        static_assert(R < base_type::rows, "Invalid matrix expression row index");
+        static_assert(C < base_type::cols, "Invalid matrix expression col index");
+        return this->rhs_[this->lhs_.col_index(R)][C];
+    }
+};
+
+/**
+ * Product of a matrix and a permutation matrix, the columns of the matrix
+ * are permuted
+ */
+template <typename LHS, typename RHS>
+struct matrix_col_permutation
+    : matrix_expression<matrix_col_permutation<LHS, RHS>, matrix_matrix_mul_result_t<LHS, RHS>>,
       binary_expression<LHS, RHS> {
+    static_assert(traits::is_matrix_v<std::decay_t<LHS>>, "Columns of a matrix are permuted");
 
     using base_type
-        = matrix_expression<matrix_matrix_multiply<LHS, RHS>, matrix_matrix_mul_result_t<LHS, RHS>>;
+        = matrix_expression<matrix_col_permutation<LHS, RHS>, matrix_matrix_mul_result_t<LHS, RHS>>;
     using value_type      = typename base_type::value_type;
     using expression_base = binary_expression<LHS, RHS>;
     using expression_base::expression_base;
@@ -983,10 +2353,144 @@ struct matrix_matrix_multiply
     {
         static_assert(R < base_type::rows, "Invalid matrix expression row index");
         static_assert(C < base_type::cols, "Invalid matrix expression col index");
-        return dot_product(row<R>(this->lhs_), col<C>(this->rhs_));
+        return this->lhs_[R][this->rhs_.row_index(C)];
     }
 };
 
+namespace detail {
+
+/**
+ * A product with an operand of a known structure
+ */
+template <typename LHS, typename RHS>
+constexpr bool structured_product_v
+    = !std::is_same<matrix_structure_t<LHS>, structure::general>::value
+      || !std::is_same<matrix_structure_t<RHS>, structure::general>::value;
+
+/**
+ * A product of triangular matrices that is large enough for the blocked
+ * multiply, it is faster than the element-wise product with half of the
+ * multiplications.
+ */
+template <typename LHS, typename RHS>
+constexpr bool blocked_structured_product_v
+    = !diagonal_structure_v<matrix_structure_t<LHS>>
+      && !diagonal_structure_v<matrix_structure_t<RHS>>
+      && std::is_floating_point<typename matrix_matrix_mul_result_t<LHS, RHS>::value_type>::value
+      && std::decay_t<LHS>::rows * std::decay_t<LHS>::cols * std::decay_t<RHS>::cols
+             >= blocked_product_threshold;
+
+/**
+ * Operand of a product with a structured matrix. A triangular operand that
+ * contains a product is evaluated and keeps the structure, an operand
+ * without a structure is handled as an operand of a general product.
+ */
+template <typename Expr>
+constexpr decltype(auto)
+structured_operand(Expr&& ex)
+{
+    using structure_type = matrix_structure_t<Expr>;
+    if constexpr (std::is_same<structure_type, structure::general>::value) {
+        return product_operand(std::forward<Expr>(ex));
+    } else if constexpr (!diagonal_structure_v<structure_type>
+                         && materialize_product_operand_v<Expr>) {
+        return make_unary_expression<triangular_matrix, structure_type>(
+            eval(std::forward<Expr>(ex)));
+    } else {
+        return std::forward<Expr>(ex);
+    }
+}
+
+/**
+ * Operand of a permutation, the rows or columns of a matrix are accessed by
+ * runtime indexes
+ */
+template <typename Expr>
+constexpr decltype(auto)
+permuted_operand(Expr&& ex)
+{
+    if constexpr (traits::is_matrix_v<std::decay_t<Expr>>) {
+        return std::forward<Expr>(ex);
+    } else {
+        return eval(std::forward<Expr>(ex));
+    }
+}
+
+template <typename Matrix, typename LHS, typename RHS, std::size_t... I>
+constexpr auto
+diagonal_matrix_product(LHS const& lhs, RHS const& rhs, std::index_sequence<I...>)
+{
+    using value_type    = typename Matrix::value_type;
+    using diagonal_type = typename diagonal_matrix<Matrix>::diagonal_type;
+    return diagonal_matrix<Matrix>{diagonal_type{static_cast<value_type>(
+        lhs.template element<I, I>() * rhs.template element<I, I>())...}};
+}
+
+template <typename Matrix, typename LHS, typename RHS>
+auto
+permutation_matrix_product(LHS const& lhs, RHS const& rhs)
+{
+    typename permutation_matrix<Matrix>::index_type cols;
+    for (std::size_t r = 0; r < Matrix::rows; ++r) {
+        cols[r] = rhs.col_index(lhs.col_index(r));
+    }
+    return permutation_matrix<Matrix>{cols};
+}
+
+/**
+ * Product with a structured operand.
+ *
+ * A product with a zero matrix is a zero matrix, a product with the identity
+ * matrix is the other operand. A product of diagonal matrices or of
+ * permutation matrices is computed right away to a matrix of the same
+ * structure. A permutation permutes the rows or the columns of the other
+ * operand without multiplications. Other products skip the zero elements of
+ * the triangular or diagonal operand.
+ */
+template <typename LHS, typename RHS>
+constexpr decltype(auto)
+structured_product(LHS&& lhs, RHS&& rhs)
+{
+    using lhs_structure = matrix_structure_t<LHS>;
+    using rhs_structure = matrix_structure_t<RHS>;
+    using result_type   = matrix_matrix_mul_result_t<LHS, RHS>;
+    constexpr auto size = result_type::rows;
+
+    if constexpr (std::is_same<lhs_structure, structure::zero>::value
+                  || std::is_same<rhs_structure, structure::zero>::value) {
+        return zero_matrix<result_type>{};
+    } else if constexpr (std::is_same<lhs_structure, structure::identity>::value
+                         && std::is_same<result_type,
+                                         typename std::decay_t<RHS>::matrix_type>::value) {
+        return simplified_operand(std::forward<RHS>(rhs));
+    } else if constexpr (std::is_same<rhs_structure, structure::identity>::value
+                         && std::is_same<result_type,
+                                         typename std::decay_t<LHS>::matrix_type>::value) {
+        return simplified_operand(std::forward<LHS>(lhs));
+    } else if constexpr (std::is_same<lhs_structure, structure::permutation>::value
+                         && std::is_same<rhs_structure, structure::permutation>::value) {
+        return permutation_matrix_product<result_type>(lhs, rhs);
+    } else if constexpr (std::is_same<lhs_structure, structure::permutation>::value) {
+        return make_binary_expression<matrix_row_permutation>(
+            std::forward<LHS>(lhs), permuted_operand(std::forward<RHS>(rhs)));
+    } else if constexpr (std::is_same<rhs_structure, structure::permutation>::value) {
+        return make_binary_expression<matrix_col_permutation>(
+            permuted_operand(std::forward<LHS>(lhs)), std::forward<RHS>(rhs));
+    } else if constexpr (diagonal_structure_v<
+                             lhs_structure> && diagonal_structure_v<rhs_structure>) {
+        return diagonal_matrix_product<result_type>(lhs, rhs, std::make_index_sequence<size>{});
+    } else if constexpr (blocked_structured_product_v<LHS, RHS>) {
+        return make_binary_expression<matrix_matrix_multiply>(
+            product_operand(std::forward<LHS>(lhs)), product_operand(std::forward<RHS>(rhs)));
+    } else {
+        return make_binary_expression<matrix_structured_multiply>(
+            structured_operand(std::forward<LHS>(lhs)), structured_operand(std::forward<RHS>(rhs)));
+    }
+}
+
+}    // namespace detail
+//@}
+
 //----------------------------------------------------------------------------
 template <typename LHS, typename RHS,
           typename = std::enable_if_t<
@@ -995,7 +2499,7 @@ template <typename LHS, typename RHS,
               || (traits::is_matrix_expression_v<LHS> && traits::is_matrix_expression_v<RHS>)
               || (traits::is_matrix_expression_v<LHS> && traits::is_vector_expression_v<RHS>)
               || (traits::is_vector_expression_v<LHS> && traits::is_matrix_expression_v<RHS>)>>
-constexpr auto operator*(LHS&& lhs, RHS&& rhs)
+constexpr decltype(auto) operator*(LHS&& lhs, RHS&& rhs)
 {
     if constexpr (traits::is_matrix_expression_v<LHS> && traits::is_scalar_v<RHS>) {
         return s::detail::wrap_non_expression_args<matrix_scalar_multiply>(std::forward<LHS>(lhs),
@@ -1005,8 +2509,13 @@ constexpr auto operator*(LHS&& lhs, RHS&& rhs)
                                                                            std::forward<LHS>(lhs));
     } else if constexpr (traits::is_matrix_expression_v<
                              LHS> && traits::is_matrix_expression_v<RHS>) {
-        return make_binary_expression<matrix_matrix_multiply>(std::forward<LHS>(lhs),
-                                                              std::forward<RHS>(rhs));
+        if constexpr (detail::structured_product_v<LHS, RHS>) {
+            return detail::structured_product(std::forward<LHS>(lhs), std::forward<RHS>(rhs));
+        } else {
+            return make_binary_expression<matrix_matrix_multiply>(
+                detail::product_operand(std::forward<LHS>(lhs)),
+                detail::product_operand(std::forward<RHS>(rhs)));
+        }
     } else if constexpr (traits::is_matrix_expression_v<
                              LHS> && traits::is_vector_expression_v<RHS>) {
         return std::forward<LHS>(lhs) * as_col_matrix(std::forward<RHS>(rhs));
@@ -1023,6 +2532,243 @@ template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
 constexpr auto
 det(Expr&& mtx);
 
+namespace detail {
+
+template <typename Matrix>
+typename Matrix::value_type
+determinant_2x2(Matrix const& m)
+{
+    return m[0][0] * m[1][1] - m[0][1] * m[1][0];
+}
+
+template <typename Matrix>
+typename Matrix::value_type
+determinant_3x3(Matrix const& m)
+{
+    return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+         - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+         + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+}
+
+/**
+ * 2x2 sub-determinants of the top (s) and bottom (c) row pairs of a 4x4
+ * matrix, shared by the Laplace expansion of the determinant and the
+ * adjugate.
+ */
+template <typename Matrix>
+struct sub_determinants_4x4 {
+    using value_type = typename Matrix::value_type;
+
+    explicit sub_determinants_4x4(Matrix const& m)
+        : s0{m[0][0] * m[1][1] - m[1][0] * m[0][1]},
+          s1{m[0][0] * m[1][2] - m[1][0] * m[0][2]},
+          s2{m[0][0] * m[1][3] - m[1][0] * m[0][3]},
+          s3{m[0][1] * m[1][2] - m[1][1] * m[0][2]},
+          s4{m[0][1] * m[1][3] - m[1][1] * m[0][3]},
+          s5{m[0][2] * m[1][3] - m[1][2] * m[0][3]},
+          c0{m[2][0] * m[3][1] - m[3][0] * m[2][1]},
+          c1{m[2][0] * m[3][2] - m[3][0] * m[2][2]},
+          c2{m[2][0] * m[3][3] - m[3][0] * m[2][3]},
+          c3{m[2][1] * m[3][2] - m[3][1] * m[2][2]},
+          c4{m[2][1] * m[3][3] - m[3][1] * m[2][3]},
+          c5{m[2][2] * m[3][3] - m[3][2] * m[2][3]}
+    {}
+
+    value_type
+    determinant() const
+    {
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    }
+
+    value_type s0, s1, s2, s3, s4, s5;
+    value_type c0, c1, c2, c3, c4, c5;
+};
+
+template <typename Matrix>
+typename Matrix::value_type
+determinant_4x4(Matrix const& m)
+{
+    return sub_determinants_4x4<Matrix>{m}.determinant();
+}
+
+/**
+ * Relative tolerance of a zero pivot or determinant of an n x n matrix.
+ * Zero for integral types, so that they are compared exactly.
+ */
+template <typename T>
+constexpr T
+singular_tolerance_factor(std::size_t n)
+{
+    return static_cast<T>(n) * std::numeric_limits<T>::epsilon();
+}
+
+/**
+ * Maximum absolute values of the matrix rows. An elimination pivot is
+ * compared to the maximum of its own row, so that scaling a row of the
+ * matrix doesn't change whether it is singular. Must be taken before the
+ * elimination starts and swapped together with the rows.
+ */
+template <typename Matrix>
+constexpr std::array<typename Matrix::value_type, Matrix::rows>
+row_scales(Matrix const& m)
+{
+    using value_type = typename Matrix::value_type;
+    std::array<value_type, Matrix::rows> res{};
+    for (std::size_t r = 0; r < Matrix::rows; ++r) {
+        for (std::size_t c = 0; c < Matrix::cols; ++c) {
+            res[r] = std::max(res[r], utils::abs_value<value_type>(m[r][c]));
+        }
+    }
+    return res;
+}
+
+/**
+ * An elimination pivot of an n x n matrix within n * epsilon of the maximum
+ * of its row is considered zero
+ */
+template <typename T>
+constexpr bool
+negligible_pivot(T pivot, T row_scale, std::size_t n)
+{
+    return utils::abs_value(pivot) <= singular_tolerance_factor<T>(n) * row_scale;
+}
+
+/**
+ * Absolute value below which a closed-form determinant of the matrix is
+ * considered zero. The product of the row maximums bounds every term of
+ * the determinant.
+ */
+template <typename Matrix>
+constexpr typename Matrix::value_type
+determinant_tolerance(Matrix const& m)
+{
+    using value_type = typename Matrix::value_type;
+    value_type bound{1};
+    for (std::size_t r = 0; r < Matrix::rows; ++r) {
+        value_type max_abs{0};
+        for (std::size_t c = 0; c < Matrix::cols; ++c) {
+            max_abs = std::max(max_abs, utils::abs_value<value_type>(m[r][c]));
+        }
+        bound *= max_abs;
+    }
+    return singular_tolerance_factor<value_type>(Matrix::rows) * bound;
+}
+
+/**
+ * Closed-form determinant of a 2x2, 3x3 or 4x4 matrix. A floating point
+ * determinant within the determinant tolerance is zero, as the LU
+ * determinant of a larger matrix with a negligible pivot is, so that the
+ * sign of a numerically singular matrix doesn't depend on its size. Other
+ * types get the exact closed form.
+ */
+template <typename Matrix>
+typename Matrix::value_type
+closed_form_determinant(Matrix const& m)
+{
+    using value_type = typename Matrix::value_type;
+    value_type res{};
+    if constexpr (Matrix::rows == 2) {
+        res = determinant_2x2(m);
+    } else if constexpr (Matrix::rows == 3) {
+        res = determinant_3x3(m);
+    } else {
+        static_assert(Matrix::rows == 4, "Closed-form determinant is for 2x2 to 4x4 matrices");
+        res = determinant_4x4(m);
+    }
+    if constexpr (std::is_floating_point_v<value_type>) {
+        if (utils::abs_value(res) <= determinant_tolerance(m))
+            return value_type{0};
+    }
+    return res;
+}
+
+/**
+ * Row with the greatest value in column k relative to the row scale,
+ * starting from row k
+ */
+template <typename Matrix, typename Scales>
+constexpr std::size_t
+pivot_row(Matrix const& m, Scales const& scales, std::size_t k)
+{
+    using value_type        = typename Matrix::value_type;
+    std::size_t pivot       = k;
+    auto        pivot_abs   = utils::abs_value<value_type>(m[k][k]);
+    auto        pivot_scale = scales[k];
+    for (std::size_t r = k + 1; r < Matrix::rows; ++r) {
+        auto const v = utils::abs_value<value_type>(m[r][k]);
+        // |v| / scale_r > |pivot| / scale_pivot without the division
+        if (v * pivot_scale > pivot_abs * scales[r] || (pivot_abs == 0 && v > 0)) {
+            pivot       = r;
+            pivot_abs   = v;
+            pivot_scale = scales[r];
+        }
+    }
+    return pivot;
+}
+
+/**
+ * Swap rows of a matrix, starting from column first
+ */
+template <typename Matrix>
+constexpr void
+swap_rows(Matrix& m, std::size_t a, std::size_t b, std::size_t first = 0)
+{
+    for (std::size_t c = first; c < Matrix::cols; ++c) {
+        auto const tmp = m[a][c];
+        m[a][c]        = m[b][c];
+        m[b][c]        = tmp;
+    }
+}
+
+/**
+ * Swap elements of a row scales or permutation array, std::swap is not
+ * constexpr
+ */
+template <typename Array>
+constexpr void
+swap_elements(Array& a, std::size_t i, std::size_t j)
+{
+    auto const tmp = a[i];
+    a[i]           = a[j];
+    a[j]           = tmp;
+}
+
+/**
+ * Determinant as the product of the diagonal of the LU decomposition with
+ * scaled partial pivoting, O(n^3). A negligible pivot makes the determinant
+ * zero.
+ * @see negligible_pivot
+ */
+template <typename Matrix>
+constexpr typename Matrix::value_type
+lu_determinant(Matrix m)
+{
+    using value_type    = typename Matrix::value_type;
+    constexpr auto size = Matrix::rows;
+    auto           scales = row_scales(m);
+    value_type     res{1};
+    for (std::size_t k = 0; k < size; ++k) {
+        auto const pivot = pivot_row(m, scales, k);
+        if (negligible_pivot(m[pivot][k], scales[pivot], size))
+            return value_type{0};
+        if (pivot != k) {
+            swap_rows(m, k, pivot, k);
+            swap_elements(scales, k, pivot);
+            res = -res;
+        }
+        res *= m[k][k];
+        for (std::size_t r = k + 1; r < size; ++r) {
+            auto const f = m[r][k] / m[k][k];
+            for (std::size_t c = k + 1; c < size; ++c) {
+                m[r][c] -= f * m[k][c];
+            }
+        }
+    }
+    return res;
+}
+
+}    // namespace detail
+
 template <typename Expr>
 struct matrix_determinant
     : scalar_expression<matrix_determinant<Expr>, typename std::decay_t<Expr>::value_type>,
@@ -1032,7 +2778,7 @@ struct matrix_determinant
         = scalar_expression<matrix_determinant<Expr>, typename std::decay_t<Expr>::value_type>;
     using matrix_type = typename std::decay_t<Expr>::matrix_type;
     static_assert(matrix_type::cols == matrix_type::rows,
-                  "Identity matrix is defined only for square matrices");
+                  "Determinant is defined only for square matrices");
     using value_type       = typename base_type::value_type;
     using col_indexes_type = typename matrix_type::col_indexes_type;
 
@@ -1042,7 +2788,23 @@ struct matrix_determinant
     constexpr value_type
     value() const
     {
-        if constexpr (matrix_type::rows > 1) {
+        using structure_type = matrix_structure_t<Expr>;
+        if constexpr (std::is_same<structure_type, structure::zero>::value) {
+            return value_type{0};
+        } else if constexpr (std::is_same<structure_type, structure::identity>::value) {
+            return value_type{1};
+        } else if constexpr (std::is_same<structure_type, structure::permutation>::value) {
+            return static_cast<value_type>(this->arg_.sign());
+        } else if constexpr (detail::lower_structure_v<
+                                 structure_type> || detail::upper_structure_v<structure_type>) {
+            // Product of the diagonal of a triangular matrix
+            return diagonal_product(col_indexes_type{});
+        } else if constexpr (matrix_type::rows >= 2 && matrix_type::rows <= 4) {
+            return detail::closed_form_determinant(matrix_type{this->arg_});
+        } else if constexpr (matrix_type::rows > 4 && std::is_floating_point_v<value_type>) {
+            return detail::lu_determinant(matrix_type{this->arg_});
+        } else if constexpr (matrix_type::rows > 1) {
+            // Exact cofactor expansion for integral matrices
             return sum(col_indexes_type{});
         } else if constexpr (matrix_type::rows == 1) {
             return this->arg_.template element<0, 0>();
@@ -1052,6 +2814,14 @@ struct matrix_determinant
     }
 
 private:
+    template <std::size_t... I>
+    constexpr value_type
+    diagonal_product(std::index_sequence<I...>) const
+    {
+        value_type res{1};
+        ((res *= this->arg_.template element<I, I>()), ...);
+        return res;
+    }
     template <std::size_t N>
     constexpr auto
     nth_element() const
@@ -1079,8 +2849,363 @@ det(Expr&& expr)
 }
 //@}
 
+//@{
+/** @name Matrix inverse */
+namespace detail {
+
+/**
+ * Reciprocal of a determinant or a pivot, throws if it is within the
+ * tolerance of zero
+ */
+template <typename T>
+T
+checked_reciprocal(T v, T tolerance = T{0})
+{
+    if (std::abs(v) <= tolerance)
+        throw std::runtime_error("Cannot inverse a singular matrix");
+    return T{1} / v;
+}
+
+template <typename Matrix>
+Matrix
+inverse_2x2(Matrix const& m)
+{
+    auto const inv = checked_reciprocal(determinant_2x2(m), determinant_tolerance(m));
+    return Matrix{{m[1][1] * inv, -m[0][1] * inv}, {-m[1][0] * inv, m[0][0] * inv}};
+}
+
+template <typename Matrix>
+Matrix
+inverse_3x3(Matrix const& m)
+{
+    auto const c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    auto const c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    auto const c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    auto const inv = checked_reciprocal(m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02,
+                                        determinant_tolerance(m));
+    // clang-format off
+    return Matrix{
+        {c00 * inv,
+         (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inv,
+         (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inv},
+        {c01 * inv,
+         (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv,
+         (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv},
+        {c02 * inv,
+         (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv,
+         (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv}
+    };
+    // clang-format on
+}
+
+/**
+ * Adjugate of a 4x4 matrix, the cofactors are built from the same 2x2
+ * sub-determinants as the determinant.
+ */
+template <typename Matrix>
+Matrix
+inverse_4x4(Matrix const& m)
+{
+    sub_determinants_4x4<Matrix> const d{m};
+    auto const                         inv
+        = checked_reciprocal(d.determinant(), determinant_tolerance(m));
+    // clang-format off
+    return Matrix{
+        {( m[1][1] * d.c5 - m[1][2] * d.c4 + m[1][3] * d.c3) * inv,
+         (-m[0][1] * d.c5 + m[0][2] * d.c4 - m[0][3] * d.c3) * inv,
+         ( m[3][1] * d.s5 - m[3][2] * d.s4 + m[3][3] * d.s3) * inv,
+         (-m[2][1] * d.s5 + m[2][2] * d.s4 - m[2][3] * d.s3) * inv},
+        {(-m[1][0] * d.c5 + m[1][2] * d.c2 - m[1][3] * d.c1) * inv,
+         ( m[0][0] * d.c5 - m[0][2] * d.c2 + m[0][3] * d.c1) * inv,
+         (-m[3][0] * d.s5 + m[3][2] * d.s2 - m[3][3] * d.s1) * inv,
+         ( m[2][0] * d.s5 - m[2][2] * d.s2 + m[2][3] * d.s1) * inv},
+        {( m[1][0] * d.c4 - m[1][1] * d.c2 + m[1][3] * d.c0) * inv,
+         (-m[0][0] * d.c4 + m[0][1] * d.c2 - m[0][3] * d.c0) * inv,
+         ( m[3][0] * d.s4 - m[3][1] * d.s2 + m[3][3] * d.s0) * inv,
+         (-m[2][0] * d.s4 + m[2][1] * d.s2 - m[2][3] * d.s0) * inv},
+        {(-m[1][0] * d.c3 + m[1][1] * d.c1 - m[1][2] * d.c0) * inv,
+         ( m[0][0] * d.c3 - m[0][1] * d.c1 + m[0][2] * d.c0) * inv,
+         (-m[3][0] * d.s3 + m[3][1] * d.s1 - m[3][2] * d.s0) * inv,
+         ( m[2][0] * d.s3 - m[2][1] * d.s1 + m[2][2] * d.s0) * inv}
+    };
+    // clang-format on
+}
+
+/**
+ * Gauss-Jordan elimination with scaled partial pivoting, O(n^3)
+ */
+template <typename Matrix>
+Matrix
+gauss_jordan_inverse(Matrix m)
+{
+    using value_type    = typename Matrix::value_type;
+    constexpr auto size = Matrix::rows;
+    auto           scales = row_scales(m);
+    Matrix         res;
+    for (std::size_t i = 0; i < size; ++i) {
+        res[i][i] = value_type{1};
+    }
+    for (std::size_t k = 0; k < size; ++k) {
+        auto const pivot = pivot_row(m, scales, k);
+        auto const inv   = checked_reciprocal(
+            m[pivot][k], singular_tolerance_factor<value_type>(size) * scales[pivot]);
+        if (pivot != k) {
+            swap_rows(m, k, pivot);
+            swap_rows(res, k, pivot);
+            std::swap(scales[k], scales[pivot]);
+        }
+        for (std::size_t c = 0; c < size; ++c) {
+            m[k][c] *= inv;
+            res[k][c] *= inv;
+        }
+        for (std::size_t r = 0; r < size; ++r) {
+            if (r == k)
+                continue;
+            auto const f = m[r][k];
+            if (f == value_type{0})
+                continue;
+            for (std::size_t c = 0; c < size; ++c) {
+                m[r][c] -= f * m[k][c];
+                res[r][c] -= f * res[k][c];
+            }
+        }
+    }
+    return res;
+}
+
+/**
+ * Inverse of a lower triangular matrix by forward substitution, the inverse
+ * is lower triangular
+ */
+template <typename Matrix>
+Matrix
+lower_triangular_inverse(Matrix const& m)
+{
+    using value_type    = typename Matrix::value_type;
+    constexpr auto size = Matrix::rows;
+    auto const     scales = row_scales(m);
+    Matrix         res;
+    for (std::size_t i = 0; i < size; ++i) {
+        auto const inv = checked_reciprocal(
+            m[i][i], singular_tolerance_factor<value_type>(size) * scales[i]);
+        res[i][i]      = inv;
+        for (std::size_t j = 0; j < i; ++j) {
+            value_type s{0};
+            for (std::size_t k = j; k < i; ++k) {
+                s += m[i][k] * res[k][j];
+            }
+            res[i][j] = -s * inv;
+        }
+    }
+    return res;
+}
+
+/**
+ * Inverse of an upper triangular matrix by back substitution, the inverse
+ * is upper triangular
+ */
+template <typename Matrix>
+Matrix
+upper_triangular_inverse(Matrix const& m)
+{
+    using value_type    = typename Matrix::value_type;
+    constexpr auto size = Matrix::rows;
+    auto const     scales = row_scales(m);
+    Matrix         res;
+    for (std::size_t i = size; i-- > 0;) {
+        auto const inv = checked_reciprocal(
+            m[i][i], singular_tolerance_factor<value_type>(size) * scales[i]);
+        res[i][i]      = inv;
+        for (std::size_t j = i + 1; j < size; ++j) {
+            value_type s{0};
+            for (std::size_t k = i + 1; k <= j; ++k) {
+                s += m[i][k] * res[k][j];
+            }
+            res[i][j] = -s * inv;
+        }
+    }
+    return res;
+}
+
+/**
+ * An element of the diagonal is the only element of its row, it is checked
+ * against its own magnitude as an elimination pivot of a full matrix is
+ * @see negligible_pivot
+ */
+template <typename Matrix, typename Expr, std::size_t... I>
+auto
+diagonal_inverse(Expr const& m, std::index_sequence<I...>)
+{
+    using value_type    = typename Matrix::value_type;
+    using diagonal_type = typename diagonal_matrix<Matrix>::diagonal_type;
+    constexpr auto factor = singular_tolerance_factor<value_type>(Matrix::rows);
+    return diagonal_matrix<Matrix>{diagonal_type{checked_reciprocal(
+        m.template element<I, I>(), factor * std::abs(m.template element<I, I>()))...}};
+}
+
+template <typename Matrix, typename Expr>
+auto
+permutation_inverse(Expr const& m)
+{
+    // The inverse is the transposed permutation
+    typename permutation_matrix<Matrix>::index_type cols;
+    for (std::size_t c = 0; c < Matrix::cols; ++c) {
+        cols[c] = m.row_index(c);
+    }
+    return permutation_matrix<Matrix>{cols};
+}
+
+}    // namespace detail
+
+/**
+ * Inverse of a square matrix.
+ *
+ * 2x2, 3x3 and 4x4 matrices are inverted with closed form adjugates, other
+ * sizes with Gauss-Jordan elimination. The inverse of a general matrix is a
+ * matrix, not a lazy expression.
+ *
+ * The inverse of a structured matrix has the same structure and is returned
+ * as the structured type, which converts to the matrix: the identity is its
+ * own inverse (identity_matrix), a diagonal is inverted element-wise
+ * (diagonal_matrix), a permutation is transposed (permutation_matrix) and a
+ * triangular matrix is inverted by substitution (triangular_matrix holding
+ * the inverted matrix).
+ *
+ * @throws std::runtime_error if the matrix is singular
+ */
+template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
+auto
+inverse(Expr&& expr)
+{
+    using matrix_type = typename std::decay_t<Expr>::matrix_type;
+    using value_type  = typename matrix_type::value_type;
+    static_assert(matrix_type::rows == matrix_type::cols,
+                  "Inverse is defined only for square matrices");
+    static_assert(std::is_floating_point_v<value_type>,
+                  "Inverse is defined only for floating point matrices");
+
+    using structure_type = matrix_structure_t<Expr>;
+    if constexpr (std::is_same<structure_type, structure::identity>::value) {
+        return identity_matrix<matrix_type>{};
+    } else if constexpr (std::is_same<structure_type, structure::diagonal>::value) {
+        return detail::diagonal_inverse<matrix_type>(expr,
+                                                     typename matrix_type::row_indexes_type{});
+    } else if constexpr (std::is_same<structure_type, structure::permutation>::value) {
+        return detail::permutation_inverse<matrix_type>(expr);
+    } else if constexpr (std::is_same<structure_type, structure::lower_triangular>::value) {
+        return lower_triangular(
+            detail::lower_triangular_inverse(matrix_type{std::forward<Expr>(expr)}));
+    } else if constexpr (std::is_same<structure_type, structure::upper_triangular>::value) {
+        return upper_triangular(
+            detail::upper_triangular_inverse(matrix_type{std::forward<Expr>(expr)}));
+    } else {
+        matrix_type const m{std::forward<Expr>(expr)};
+        if constexpr (matrix_type::rows == 1) {
+            return matrix_type{
+                detail::checked_reciprocal(m[0][0], detail::determinant_tolerance(m))};
+        } else if constexpr (matrix_type::rows == 2) {
+            return detail::inverse_2x2(m);
+        } else if constexpr (matrix_type::rows == 3) {
+            return detail::inverse_3x3(m);
+        } else if constexpr (matrix_type::rows == 4) {
+            return detail::inverse_4x4(m);
+        } else {
+            return detail::gauss_jordan_inverse(m);
+        }
+    }
+}
+
+namespace detail {
+
+template <typename Matrix, typename Block>
+Matrix
+affine_inverse(Matrix const& m, Block const& block_inv)
+{
+    constexpr auto n = Matrix::rows - 1;
+    Matrix         res;
+    for (std::size_t r = 0; r < n; ++r) {
+        typename Matrix::value_type t{0};
+        for (std::size_t c = 0; c < n; ++c) {
+            res[r][c] = block_inv[r][c];
+            t -= block_inv[r][c] * m[c][n];
+        }
+        res[r][n] = t;
+    }
+    res[n][n] = typename Matrix::value_type{1};
+    return res;
+}
+
+}    // namespace detail
+
+/**
+ * Inverse of an affine transform matrix, with the linear part in the upper
+ * left block, the translation in the last column and the last row of
+ * [0 ... 0 1]. The last row is not checked.
+ *
+ * Only the linear block is inverted, the translation is transformed by the
+ * inverted block and negated.
+ *
+ * @throws std::runtime_error if the linear part is singular
+ */
+template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
+auto
+affine_inverse(Expr&& expr)
+{
+    using matrix_type = typename std::decay_t<Expr>::matrix_type;
+    static_assert(matrix_type::rows == matrix_type::cols && matrix_type::rows > 1,
+                  "Affine inverse is defined only for square matrices larger than 1x1");
+    constexpr auto     n = matrix_type::rows - 1;
+    matrix_type const m{std::forward<Expr>(expr)};
+    return detail::affine_inverse(m, inverse(minor<n, n>(m)));
+}
+
+/**
+ * Inverse of a rigid transform matrix, an affine transform with an
+ * orthonormal linear part (rotation). The linear part is transposed instead
+ * of inverted.
+ */
+template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
+auto
+rigid_inverse(Expr&& expr)
+{
+    using matrix_type = typename std::decay_t<Expr>::matrix_type;
+    static_assert(matrix_type::rows == matrix_type::cols && matrix_type::rows > 1,
+                  "Rigid inverse is defined only for square matrices larger than 1x1");
+    constexpr auto     n = matrix_type::rows - 1;
+    matrix_type const m{std::forward<Expr>(expr)};
+    return detail::affine_inverse(m, eval(transpose(minor<n, n>(m))));
+}
+//@}
+
 }    // namespace m
 
+inline namespace v {
+
+/**
+ * The column of a product of a square matrix and a column vector, e.g.
+ * as_vector(m * v), is computed in a register with the SIMD matrix kernels
+ */
+template <typename Product>
+struct simd_evaluator<
+    m::nth_col<Product, 0>,
+    std::enable_if_t<m::use_simd_product_v<Product> && std::decay_t<Product>::cols == 1>>
+    : simd_evaluator_base<m::nth_col<Product, 0>> {
+    using base_type     = simd_evaluator_base<m::nth_col<Product, 0>>;
+    using register_type = typename base_type::register_type;
+    using value_type    = typename base_type::value_type;
+
+    static register_type
+    eval(m::nth_col<Product, 0> const& ex)
+    {
+        using kernels       = simd::matrix_kernels<value_type, std::decay_t<Product>::rows>;
+        auto const& product = ex.arg();
+        return kernels::multiply(m::detail::simd_kernel_columns(product.lhs()),
+                                 simd_eval(product.rhs().arg()));
+    }
+};
+
+}    // namespace v
+
 }    // namespace expr
 }    // namespace math
 }    // namespace psst
@@ -9,8 +9,11 @@
 #define PSST_MATH_DETAIL_SCALAR_EXPRESSIONS_HPP_
 
 #include <psst/math/detail/expressions.hpp>
+#include <psst/math/detail/fma.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
 
 namespace psst {
 namespace math {
@@ -80,6 +83,17 @@ make_scalar_constant(T&& v)
     return make_unary_expression<scalar_constant>(std::forward<T>(v));
 }
 
+/**
+ * Evaluate a scalar expression. Expressions don't cache their values, use the
+ * result of eval when the value is needed more than once.
+ */
+template <typename Expression, typename = traits::enable_if_scalar_expression<Expression>>
+constexpr auto
+eval(Expression&& ex)
+{
+    return static_cast<typename std::decay_t<Expression>::value_type>(ex.value());
+}
+
 namespace detail {
 
 template <typename Arg, typename = utils::void_t<>>
@@ -152,6 +166,90 @@ constexpr auto operator!(Expression&& exp)
 }
 //@}
 
+//----------------------------------------------------------------------------
+template <typename LHS, typename RHS>
+struct scalar_mul;
+template <typename... T>
+struct scalar_product;
+
+namespace detail {
+
+//@{
+/** @name Scalar expression is a product that can be fused with an addition */
+template <typename T>
+struct is_scalar_product : std::false_type {};
+template <typename LHS, typename RHS>
+struct is_scalar_product<scalar_mul<LHS, RHS>> : std::true_type {};
+template <typename T, typename U, typename... Y>
+struct is_scalar_product<scalar_product<T, U, Y...>> : std::true_type {};
+template <typename T>
+constexpr bool is_scalar_product_v = is_scalar_product<std::decay_t<T>>::value;
+//@}
+
+/**
+ * Add value of a scalar expression to the accumulator. Products are added
+ * with a fused multiply-add.
+ */
+template <typename T, typename Expr>
+constexpr T
+accumulate(T acc, Expr const& ex);
+
+/**
+ * Reduce f(Begin) ... f(Begin + Size - 1) with a binary operation as a
+ * balanced tree. The longest dependency chain is log2(Size) operations
+ * instead of Size - 1, so that independent operations overlap in the CPU
+ * pipeline. f is called with std::integral_constant indexes.
+ */
+template <std::size_t Begin, std::size_t Size, typename Op, typename F>
+constexpr auto
+tree_reduce(Op const& op, F const& f)
+{
+    static_assert(Size > 0, "Cannot reduce an empty sequence");
+    if constexpr (Size == 1) {
+        return f(std::integral_constant<std::size_t, Begin>{});
+    } else {
+        constexpr std::size_t half = Size / 2;
+        return op(tree_reduce<Begin, half>(op, f), tree_reduce<Begin + half, Size - half>(op, f));
+    }
+}
+
+/**
+ * Number of independent accumulators of a sum of fused multiply-adds
+ */
+constexpr std::size_t sum_accumulators = 4;
+
+template <typename T, std::size_t Chains, typename Init, typename Acc, std::size_t... Heads,
+          std::size_t... Tails>
+constexpr T
+accumulate_chains(Init const& init, Acc const& acc, std::index_sequence<Heads...>,
+                  std::index_sequence<Tails...>)
+{
+    T chains[]{static_cast<T>(init(std::integral_constant<std::size_t, Heads>{}))...};
+    ((chains[Tails % Chains]
+      = acc(chains[Tails % Chains], std::integral_constant<std::size_t, Chains + Tails>{})),
+     ...);
+    return tree_reduce<0, Chains>(std::plus<>{}, [&chains](auto i) { return chains[i]; });
+}
+
+/**
+ * Sum of Size terms accumulated in up to sum_accumulators independent chains,
+ * term I goes to chain I % chains. A chain starts with init(I) and the
+ * following terms are added with acc(chain, I), e.g. a fused multiply-add.
+ * There are at most Size / 2 chains, so that every chain fuses at least one
+ * term. The chains are summed pairwise.
+ */
+template <typename T, std::size_t Size, typename Init, typename Acc>
+constexpr T
+multi_accumulate(Init const& init, Acc const& acc)
+{
+    static_assert(Size > 0, "Cannot sum an empty sequence");
+    constexpr std::size_t chains = std::max(std::min(Size / 2, sum_accumulators), std::size_t{1});
+    return accumulate_chains<T, chains>(init, acc, std::make_index_sequence<chains>{},
+                                        std::make_index_sequence<Size - chains>{});
+}
+
+}    // namespace detail
+
 //----------------------------------------------------------------------------
 /** @name Sum one or more scalar expressions */
 template <typename T, typename... Y>
@@ -167,15 +265,39 @@ struct scalar_sum : scalar_expression<scalar_sum<T, Y...>, traits::scalar_expres
     constexpr value_type
     value() const
     {
-        return sum(index_sequence_type{});
+        if constexpr (utils::fused_multiply_add_v<value_type>
+                      && (detail::is_scalar_product_v<Y> || ...)) {
+            return fused_sum(index_sequence_type{});
+        } else {
+            return sum(index_sequence_type{});
+        }
     }
 
 private:
+    /**
+     * Sum pairwise, the additions don't wait for each other
+     */
     template <std::size_t... Indexes>
     constexpr auto
     sum(std::index_sequence<Indexes...>) const
     {
-        return (this->template arg<Indexes>().value() + ...);
+        return detail::tree_reduce<0, sizeof...(Indexes)>(std::plus<>{}, [this](auto i) {
+            return this->template arg<decltype(i)::value>().value();
+        });
+    }
+    /**
+     * Sum in several accumulators, fusing the products with the accumulated
+     * values
+     */
+    template <std::size_t... Indexes>
+    constexpr value_type
+    fused_sum(std::index_sequence<Indexes...>) const
+    {
+        return detail::multi_accumulate<value_type, sizeof...(Indexes)>(
+            [this](auto i) { return std::get<decltype(i)::value>(this->args_).value(); },
+            [this](value_type acc, auto i) {
+                return detail::accumulate(acc, std::get<decltype(i)::value>(this->args_));
+            });
     }
 };
 
@@ -346,10 +468,49 @@ private:
     constexpr auto
     product(std::index_sequence<Indexes...>) const
     {
-        return (this->template arg<Indexes>() * ...);
+        return detail::tree_reduce<0, sizeof...(Indexes)>(std::multiplies<>{}, [this](auto i) {
+            return this->template arg<decltype(i)::value>().value();
+        });
     }
 };
 
+namespace detail {
+
+template <typename T, typename LHS, typename RHS>
+constexpr T
+accumulate_product(T acc, scalar_mul<LHS, RHS> const& ex)
+{
+    return utils::multiply_add<T>(ex.lhs().value(), ex.rhs().value(), acc);
+}
+
+template <typename T, typename... P, std::size_t... Indexes>
+constexpr T
+accumulate_product(T acc, scalar_product<P...> const& ex, std::index_sequence<Indexes...>)
+{
+    return utils::multiply_add<T>((std::get<Indexes>(ex.args()).value() * ...),
+                                  std::get<sizeof...(Indexes)>(ex.args()).value(), acc);
+}
+
+template <typename T, typename... P>
+constexpr T
+accumulate_product(T acc, scalar_product<P...> const& ex)
+{
+    return accumulate_product(acc, ex, std::make_index_sequence<sizeof...(P) - 1>{});
+}
+
+template <typename T, typename Expr>
+constexpr T
+accumulate(T acc, Expr const& ex)
+{
+    if constexpr (utils::fused_multiply_add_v<T> && is_scalar_product_v<Expr>) {
+        return accumulate_product(acc, ex);
+    } else {
+        return acc + ex.value();
+    }
+}
+
+}    // namespace detail
+
 template <typename T, typename = traits::enable_if_scalar_value<T>>
 constexpr auto
 product(T&& arg)
@@ -438,16 +599,8 @@ struct square_root : unary_scalar_expression<square_root, Expression>,
     value() const
     {
         using std::sqrt;
-        if (value_cache_ == nval) {
-            value_cache_ = sqrt(this->arg_.value());
-        }
-        return value_cache_;
+        return sqrt(this->arg_.value());
     }
-
-private:
-    // TODO Optional
-    static constexpr value_type nval         = std::numeric_limits<value_type>::min();
-    mutable value_type          value_cache_ = nval;
 };
 
 template <typename Expression, typename = traits::enable_if_scalar_value<Expression>>
@@ -0,0 +1,932 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * simd.hpp
+ *
+ *  Created on: Feb 2, 2019
+ *      Author: ser-fedorov
+ */
+
+#ifndef PSST_MATH_DETAIL_SIMD_HPP_
+#define PSST_MATH_DETAIL_SIMD_HPP_
+
+#include <psst/math/detail/utils.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * SIMD evaluation is opt-in. Define PSST_MATH_ENABLE_SIMD (or configure the
+ * project with -DPSST_MATH_ENABLE_SIMD=ON) to enable SSE/AVX backed storage
+ * and evaluation for 3- and 4-component float and double vectors.
+ *
+ * The macro must be defined consistently for all translation units of a
+ * program, as it changes the alignment of the affected vector types.
+ */
+#if defined(PSST_MATH_ENABLE_SIMD)
+#    if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#        define PSST_MATH_SIMD_SSE2 1
+#        include <emmintrin.h>
+#    endif
+#    if defined(__SSE4_1__) || defined(__AVX__)
+#        define PSST_MATH_SIMD_SSE41 1
+#        include <smmintrin.h>
+#    endif
+#    if defined(__AVX__)
+#        define PSST_MATH_SIMD_AVX 1
+#        include <immintrin.h>
+#    endif
+#    if defined(__AVX2__)
+#        define PSST_MATH_SIMD_AVX2 1
+#    endif
+#    if defined(__FMA__) && !defined(PSST_MATH_DISABLE_FMA)
+#        define PSST_MATH_SIMD_FMA 1
+#        include <immintrin.h>
+#    endif
+#endif
+
+/**
+ * SIMD intrinsics cannot be evaluated in constant expressions. Where the
+ * compiler can tell a constant evaluation apart, constexpr vector
+ * construction and scalar expressions fall back to component-wise
+ * evaluation at compile time and use SIMD registers at run time. Otherwise
+ * SIMD evaluation is never selected in constexpr code paths.
+ */
+#if defined(__cpp_lib_is_constant_evaluated)
+#    define PSST_MATH_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif defined(__has_builtin)
+#    if __has_builtin(__builtin_is_constant_evaluated)
+#        define PSST_MATH_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#    endif
+#endif
+#if !defined(PSST_MATH_IS_CONSTANT_EVALUATED)
+#    if (defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9)                                 \
+        || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#        define PSST_MATH_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#    endif
+#endif
+
+namespace psst {
+namespace math {
+namespace simd {
+
+/**
+ * The compiler can detect constant evaluation, so SIMD evaluation can be
+ * selected in constexpr functions.
+ */
+#if defined(PSST_MATH_IS_CONSTANT_EVALUATED)
+constexpr bool constant_evaluation_detected = true;
+#else
+constexpr bool constant_evaluation_detected = false;
+#endif
+
+/**
+ * The call is evaluated in a constant expression, SIMD intrinsics cannot be
+ * used. Always false if the compiler cannot detect constant evaluation.
+ */
+constexpr bool
+is_constant_evaluated() noexcept
+{
+#if defined(PSST_MATH_IS_CONSTANT_EVALUATED)
+    return PSST_MATH_IS_CONSTANT_EVALUATED();
+#else
+    return false;
+#endif
+}
+
+/**
+ * Primary template for SIMD register operations. SIMD evaluation is disabled
+ * for a value type/size combination unless there is a specialization.
+ *
+ * A 3-component vector occupies the first three lanes of a 4-lane register,
+ * the value of the last lane is unspecified and is never stored or summed.
+ */
+template <typename T, std::size_t Size, typename = utils::void_t<>>
+struct register_traits {
+    static constexpr bool        enabled   = false;
+    static constexpr std::size_t alignment = alignof(T);
+};
+
+template <typename T, std::size_t Size>
+constexpr bool register_enabled_v = register_traits<T, Size>::enabled;
+
+/**
+ * Alignment of vector storage. For types with SIMD support this is the
+ * alignment of the register, if the vector fills the whole register.
+ */
+template <typename T, std::size_t Size, typename = utils::void_t<>>
+struct storage_alignment : utils::size_constant<alignof(T)> {};
+template <typename T, std::size_t Size>
+struct storage_alignment<
+    T, Size,
+    std::enable_if_t<register_enabled_v<
+                         T, Size> && sizeof(T) * Size == sizeof(typename register_traits<T, Size>::type)>>
+    : utils::size_constant<register_traits<T, Size>::alignment> {};
+template <typename T, std::size_t Size>
+constexpr std::size_t storage_alignment_v = storage_alignment<T, Size>::value;
+
+/**
+ * Primary template for products of square row-major matrices of Size x Size
+ * in SIMD registers. A product of column-major matrices is the row-major
+ * product of the operands in reverse order. The kernels are disabled unless there is a
+ * specialization.
+ */
+template <typename T, std::size_t Size, typename = utils::void_t<>>
+struct matrix_kernels {
+    static constexpr bool enabled = false;
+};
+
+template <typename T, std::size_t Size>
+constexpr bool matrix_kernels_enabled_v = matrix_kernels<T, Size>::enabled;
+
+#if defined(PSST_MATH_SIMD_SSE2)
+
+//@{
+/** @name 3 and 4 floats in an SSE register */
+template <std::size_t Size>
+struct register_traits<float, Size, std::enable_if_t<Size == 3 || Size == 4>> {
+    using value_type = float;
+    using type       = __m128;
+
+    static constexpr bool        enabled   = true;
+    static constexpr std::size_t size      = Size;
+    static constexpr std::size_t alignment = 16;
+
+    static type
+    load(value_type const* p)
+    {
+        if constexpr (Size == 4) {
+            return _mm_loadu_ps(p);
+        } else {
+            return _mm_set_ps(0.0f, p[2], p[1], p[0]);
+        }
+    }
+    static void
+    store(value_type* p, type v)
+    {
+        if constexpr (Size == 4) {
+            _mm_storeu_ps(p, v);
+        } else {
+            _mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+            _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+        }
+    }
+    /**
+     * Load from memory aligned to the register alignment
+     */
+    static type
+    load_aligned(value_type const* p)
+    {
+        if constexpr (Size == 4) {
+            return _mm_load_ps(p);
+        } else {
+            return load(p);
+        }
+    }
+    /**
+     * Store to memory aligned to the register alignment
+     */
+    static void
+    store_aligned(value_type* p, type v)
+    {
+        if constexpr (Size == 4) {
+            _mm_store_ps(p, v);
+        } else {
+            store(p, v);
+        }
+    }
+    static type
+    broadcast(value_type v)
+    {
+        return _mm_set1_ps(v);
+    }
+
+    static type
+    add(type lhs, type rhs)
+    {
+        return _mm_add_ps(lhs, rhs);
+    }
+    static type
+    sub(type lhs, type rhs)
+    {
+        return _mm_sub_ps(lhs, rhs);
+    }
+    static type
+    mul(type lhs, type rhs)
+    {
+        return _mm_mul_ps(lhs, rhs);
+    }
+    static type
+    div(type lhs, type rhs)
+    {
+        return _mm_div_ps(lhs, rhs);
+    }
+
+    /**
+     * lhs * rhs + addend, fused when the target has FMA instructions
+     */
+    static type
+    fmadd(type lhs, type rhs, type addend)
+    {
+#    if defined(PSST_MATH_SIMD_FMA)
+        return _mm_fmadd_ps(lhs, rhs, addend);
+#    else
+        return add(mul(lhs, rhs), addend);
+#    endif
+    }
+    /**
+     * lhs * rhs - subtrahend
+     */
+    static type
+    fmsub(type lhs, type rhs, type subtrahend)
+    {
+#    if defined(PSST_MATH_SIMD_FMA)
+        return _mm_fmsub_ps(lhs, rhs, subtrahend);
+#    else
+        return sub(mul(lhs, rhs), subtrahend);
+#    endif
+    }
+    /**
+     * minuend - lhs * rhs
+     */
+    static type
+    fnmadd(type lhs, type rhs, type minuend)
+    {
+#    if defined(PSST_MATH_SIMD_FMA)
+        return _mm_fnmadd_ps(lhs, rhs, minuend);
+#    else
+        return sub(minuend, mul(lhs, rhs));
+#    endif
+    }
+
+    static type
+    min(type lhs, type rhs)
+    {
+        return _mm_min_ps(lhs, rhs);
+    }
+    static type
+    max(type lhs, type rhs)
+    {
+        return _mm_max_ps(lhs, rhs);
+    }
+    /**
+     * Absolute values, the sign bits are cleared
+     */
+    static type
+    abs(type v)
+    {
+        return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+    }
+#    if defined(PSST_MATH_SIMD_SSE41)
+    static constexpr bool has_floor = true;
+    static type
+    floor(type v)
+    {
+        return _mm_floor_ps(v);
+    }
+#    else
+    static constexpr bool has_floor = false;
+#    endif
+    /**
+     * Lanes of a where the lanes of the mask are not zero, lanes of b
+     * otherwise
+     */
+    static type
+    select(type mask, type a, type b)
+    {
+        type const m = _mm_cmpneq_ps(mask, _mm_setzero_ps());
+#    if defined(PSST_MATH_SIMD_SSE41)
+        return _mm_blendv_ps(b, a, m);
+#    else
+        return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+#    endif
+    }
+
+    /**
+     * Minimum of the meaningful lanes of the register
+     */
+    static value_type
+    hmin(type v)
+    {
+        v = fill_last_lane(v);
+        v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtss_f32(_mm_min_ss(v, _mm_movehl_ps(v, v)));
+    }
+    /**
+     * Maximum of the meaningful lanes of the register
+     */
+    static value_type
+    hmax(type v)
+    {
+        v = fill_last_lane(v);
+        v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtss_f32(_mm_max_ss(v, _mm_movehl_ps(v, v)));
+    }
+
+    /**
+     * Sum of the meaningful lanes of the register
+     */
+    static value_type
+    hsum(type v)
+    {
+        if constexpr (Size == 3) {
+            v = _mm_and_ps(v, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+        }
+        type shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+        type sums = _mm_add_ps(v, shuf);
+        shuf      = _mm_movehl_ps(shuf, sums);
+        sums      = _mm_add_ss(sums, shuf);
+        return _mm_cvtss_f32(sums);
+    }
+    static value_type
+    dot(type lhs, type rhs)
+    {
+        return hsum(mul(lhs, rhs));
+    }
+    /**
+     * Cross product of the xyz lanes
+     */
+    static type
+    cross(type lhs, type rhs)
+    {
+        type lhs_yzx = _mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(3, 0, 2, 1));
+        type rhs_yzx = _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 0, 2, 1));
+        type res     = fmsub(lhs, rhs_yzx, _mm_mul_ps(lhs_yzx, rhs));
+        return _mm_shuffle_ps(res, res, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+private:
+    /**
+     * The unspecified last lane of a 3-component vector is replaced with the
+     * first one, so that it doesn't change a minimum or a maximum
+     */
+    static type
+    fill_last_lane(type v)
+    {
+        if constexpr (Size == 3) {
+            return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 2, 1, 0));
+        } else {
+            return v;
+        }
+    }
+};
+//@}
+
+/**
+ * 4x4 float matrix products.
+ *
+ * A row of a matrix product is a sum of the rows of the right hand matrix
+ * scaled by the elements of the left hand row, a product with a vector is a
+ * sum of the matrix columns scaled by the vector components. Both are
+ * computed by broadcasting the scalars and multiply-adding whole registers,
+ * without horizontal sums.
+ */
+template <>
+struct matrix_kernels<float, 4> {
+    using value_type      = float;
+    using register_traits = simd::register_traits<float, 4>;
+    using type            = register_traits::type;
+
+    static constexpr bool        enabled = true;
+    static constexpr std::size_t size    = 4;
+
+    /**
+     * Columns of a matrix, loaded once to multiply several vectors
+     */
+    struct columns {
+        type c0, c1, c2, c3;
+    };
+
+    /**
+     * c = a * b, the matrices are row-major and consecutive in memory. The
+     * result must not overlap the operands.
+     */
+    static void
+    multiply(value_type const* a, value_type const* b, value_type* c)
+    {
+#    if defined(PSST_MATH_SIMD_AVX)
+        // Two rows of the result per register, the right hand rows are
+        // duplicated to both lanes
+        __m256 const b0 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(b));
+        __m256 const b1 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(b + 4));
+        __m256 const b2 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(b + 8));
+        __m256 const b3 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(b + 12));
+        for (std::size_t r = 0; r < 4; r += 2) {
+            __m256 const rows = _mm256_loadu_ps(a + r * 4);
+            __m256       res  = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x00), b0);
+            res = fmadd256(_mm256_shuffle_ps(rows, rows, 0x55), b1, res);
+            res = fmadd256(_mm256_shuffle_ps(rows, rows, 0xaa), b2, res);
+            res = fmadd256(_mm256_shuffle_ps(rows, rows, 0xff), b3, res);
+            _mm256_storeu_ps(c + r * 4, res);
+        }
+#    else
+        type const b0 = _mm_loadu_ps(b);
+        type const b1 = _mm_loadu_ps(b + 4);
+        type const b2 = _mm_loadu_ps(b + 8);
+        type const b3 = _mm_loadu_ps(b + 12);
+        for (std::size_t r = 0; r < 4; ++r) {
+            type const row = _mm_loadu_ps(a + r * 4);
+            type       res = _mm_mul_ps(_mm_shuffle_ps(row, row, 0x00), b0);
+            res            = register_traits::fmadd(_mm_shuffle_ps(row, row, 0x55), b1, res);
+            res            = register_traits::fmadd(_mm_shuffle_ps(row, row, 0xaa), b2, res);
+            res            = register_traits::fmadd(_mm_shuffle_ps(row, row, 0xff), b3, res);
+            _mm_storeu_ps(c + r * 4, res);
+        }
+#    endif
+    }
+
+    /**
+     * Columns of a row-major matrix
+     */
+    static columns
+    load_columns(value_type const* m)
+    {
+        columns res{_mm_loadu_ps(m), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8),
+                    _mm_loadu_ps(m + 12)};
+        _MM_TRANSPOSE4_PS(res.c0, res.c1, res.c2, res.c3);
+        return res;
+    }
+    /**
+     * Columns of a column-major matrix, no shuffles
+     */
+    static columns
+    load_stored_columns(value_type const* m)
+    {
+        return columns{_mm_loadu_ps(m), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8),
+                       _mm_loadu_ps(m + 12)};
+    }
+
+    /**
+     * Product of a matrix and a column vector
+     */
+    static type
+    multiply(columns const& m, type v)
+    {
+        type res = _mm_mul_ps(m.c0, _mm_shuffle_ps(v, v, 0x00));
+        res      = register_traits::fmadd(m.c1, _mm_shuffle_ps(v, v, 0x55), res);
+        res      = register_traits::fmadd(m.c2, _mm_shuffle_ps(v, v, 0xaa), res);
+        return register_traits::fmadd(m.c3, _mm_shuffle_ps(v, v, 0xff), res);
+    }
+    static type
+    multiply(value_type const* m, type v)
+    {
+        return multiply(load_columns(m), v);
+    }
+
+private:
+#    if defined(PSST_MATH_SIMD_AVX)
+    static __m256
+    fmadd256(__m256 lhs, __m256 rhs, __m256 addend)
+    {
+#        if defined(PSST_MATH_SIMD_FMA)
+        return _mm256_fmadd_ps(lhs, rhs, addend);
+#        else
+        return _mm256_add_ps(_mm256_mul_ps(lhs, rhs), addend);
+#        endif
+    }
+#    endif
+};
+
+//@{
+/** @name 3 and 4 doubles in an AVX register or in a pair of SSE2 registers */
+#    if defined(PSST_MATH_SIMD_AVX)
+
+template <std::size_t Size>
+struct register_traits<double, Size, std::enable_if_t<Size == 3 || Size == 4>> {
+    using value_type = double;
+    using type       = __m256d;
+
+    static constexpr bool        enabled   = true;
+    static constexpr std::size_t size      = Size;
+    static constexpr std::size_t alignment = 32;
+
+    static type
+    load(value_type const* p)
+    {
+        if constexpr (Size == 4) {
+            return _mm256_loadu_pd(p);
+        } else {
+            return _mm256_set_pd(0.0, p[2], p[1], p[0]);
+        }
+    }
+    static void
+    store(value_type* p, type v)
+    {
+        if constexpr (Size == 4) {
+            _mm256_storeu_pd(p, v);
+        } else {
+            _mm_storeu_pd(p, _mm256_castpd256_pd128(v));
+            _mm_store_sd(p + 2, _mm256_extractf128_pd(v, 1));
+        }
+    }
+    static type
+    load_aligned(value_type const* p)
+    {
+        if constexpr (Size == 4) {
+            return _mm256_load_pd(p);
+        } else {
+            return load(p);
+        }
+    }
+    static void
+    store_aligned(value_type* p, type v)
+    {
+        if constexpr (Size == 4) {
+            _mm256_store_pd(p, v);
+        } else {
+            store(p, v);
+        }
+    }
+    static type
+    broadcast(value_type v)
+    {
+        return _mm256_set1_pd(v);
+    }
+
+    static type
+    add(type lhs, type rhs)
+    {
+        return _mm256_add_pd(lhs, rhs);
+    }
+    static type
+    sub(type lhs, type rhs)
+    {
+        return _mm256_sub_pd(lhs, rhs);
+    }
+    static type
+    mul(type lhs, type rhs)
+    {
+        return _mm256_mul_pd(lhs, rhs);
+    }
+    static type
+    div(type lhs, type rhs)
+    {
+        return _mm256_div_pd(lhs, rhs);
+    }
+
+    /**
+     * lhs * rhs + addend, fused when the target has FMA instructions
+     */
+    static type
+    fmadd(type lhs, type rhs, type addend)
+    {
+#    if defined(PSST_MATH_SIMD_FMA)
+        return _mm256_fmadd_pd(lhs, rhs, addend);
+#    else
+        return add(mul(lhs, rhs), addend);
+#    endif
+    }
+    /**
+     * lhs * rhs - subtrahend
+     */
+    static type
+    fmsub(type lhs, type rhs, type subtrahend)
+    {
+#    if defined(PSST_MATH_SIMD_FMA)
+        return _mm256_fmsub_pd(lhs, rhs, subtrahend);
+#    else
+        return sub(mul(lhs, rhs), subtrahend);
+#    endif
+    }
+    /**
+     * minuend - lhs * rhs
+     */
+    static type
+    fnmadd(type lhs, type rhs, type minuend)
+    {
+#    if defined(PSST_MATH_SIMD_FMA)
+        return _mm256_fnmadd_pd(lhs, rhs, minuend);
+#    else
+        return sub(minuend, mul(lhs, rhs));
+#    endif
+    }
+
+    static type
+    min(type lhs, type rhs)
+    {
+        return _mm256_min_pd(lhs, rhs);
+    }
+    static type
+    max(type lhs, type rhs)
+    {
+        return _mm256_max_pd(lhs, rhs);
+    }
+    static type
+    abs(type v)
+    {
+        return _mm256_andnot_pd(_mm256_set1_pd(-0.0), v);
+    }
+    static constexpr bool has_floor = true;
+    static type
+    floor(type v)
+    {
+        return _mm256_floor_pd(v);
+    }
+    static type
+    select(type mask, type a, type b)
+    {
+        return _mm256_blendv_pd(b, a, _mm256_cmp_pd(mask, _mm256_setzero_pd(), _CMP_NEQ_UQ));
+    }
+
+    static value_type
+    hmin(type v)
+    {
+        __m128d const s = _mm_min_pd(_mm256_castpd256_pd128(v), high_half(v));
+        return _mm_cvtsd_f64(_mm_min_sd(s, _mm_unpackhi_pd(s, s)));
+    }
+    static value_type
+    hmax(type v)
+    {
+        __m128d const s = _mm_max_pd(_mm256_castpd256_pd128(v), high_half(v));
+        return _mm_cvtsd_f64(_mm_max_sd(s, _mm_unpackhi_pd(s, s)));
+    }
+
+    static value_type
+    hsum(type v)
+    {
+        __m128d lo = _mm256_castpd256_pd128(v);
+        __m128d hi = _mm256_extractf128_pd(v, 1);
+        if constexpr (Size == 3) {
+            hi = _mm_move_sd(_mm_setzero_pd(), hi);
+        }
+        lo = _mm_add_pd(lo, hi);
+        return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+    }
+    static value_type
+    dot(type lhs, type rhs)
+    {
+        return hsum(mul(lhs, rhs));
+    }
+    /**
+     * Cross product of the xyz lanes
+     */
+    static type
+    cross(type lhs, type rhs)
+    {
+        type res = fmsub(lhs, yzx(rhs), mul(yzx(lhs), rhs));
+        return yzx(res);
+    }
+
+private:
+    /**
+     * Rotate the xyz lanes to yzx, the last lane is kept
+     */
+    static type
+    yzx(type v)
+    {
+#    if defined(PSST_MATH_SIMD_AVX2)
+        return _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 0, 2, 1));
+#    else
+        // (x, y, x, y) and (z, w, z, w)
+        type const lo = _mm256_permute2f128_pd(v, v, 0x00);
+        type const hi = _mm256_permute2f128_pd(v, v, 0x11);
+        return _mm256_shuffle_pd(lo, hi, 0b1001);
+#    endif
+    }
+    /**
+     * The upper two lanes, the last lane of a 3-component vector is replaced
+     * with the third one
+     */
+    static __m128d
+    high_half(type v)
+    {
+        __m128d const hi = _mm256_extractf128_pd(v, 1);
+        if constexpr (Size == 3) {
+            return _mm_unpacklo_pd(hi, hi);
+        } else {
+            return hi;
+        }
+    }
+};
+
+#    else
+
+/**
+ * Four doubles in a pair of SSE2 registers
+ */
+struct double4_register {
+    __m128d lo;
+    __m128d hi;
+};
+
+template <std::size_t Size>
+struct register_traits<double, Size, std::enable_if_t<Size == 3 || Size == 4>> {
+    using value_type = double;
+    using type       = double4_register;
+
+    static constexpr bool        enabled   = true;
+    static constexpr std::size_t size      = Size;
+    static constexpr std::size_t alignment = 16;
+
+    static type
+    load(value_type const* p)
+    {
+        if constexpr (Size == 4) {
+            return {_mm_loadu_pd(p), _mm_loadu_pd(p + 2)};
+        } else {
+            return {_mm_loadu_pd(p), _mm_load_sd(p + 2)};
+        }
+    }
+    static void
+    store(value_type* p, type v)
+    {
+        _mm_storeu_pd(p, v.lo);
+        if constexpr (Size == 4) {
+            _mm_storeu_pd(p + 2, v.hi);
+        } else {
+            _mm_store_sd(p + 2, v.hi);
+        }
+    }
+    static type
+    load_aligned(value_type const* p)
+    {
+        if constexpr (Size == 4) {
+            return {_mm_load_pd(p), _mm_load_pd(p + 2)};
+        } else {
+            return {_mm_load_pd(p), _mm_load_sd(p + 2)};
+        }
+    }
+    static void
+    store_aligned(value_type* p, type v)
+    {
+        _mm_store_pd(p, v.lo);
+        if constexpr (Size == 4) {
+            _mm_store_pd(p + 2, v.hi);
+        } else {
+            _mm_store_sd(p + 2, v.hi);
+        }
+    }
+    static type
+    broadcast(value_type v)
+    {
+        return {_mm_set1_pd(v), _mm_set1_pd(v)};
+    }
+
+    static type
+    add(type lhs, type rhs)
+    {
+        return {_mm_add_pd(lhs.lo, rhs.lo), _mm_add_pd(lhs.hi, rhs.hi)};
+    }
+    static type
+    sub(type lhs, type rhs)
+    {
+        return {_mm_sub_pd(lhs.lo, rhs.lo), _mm_sub_pd(lhs.hi, rhs.hi)};
+    }
+    static type
+    mul(type lhs, type rhs)
+    {
+        return {_mm_mul_pd(lhs.lo, rhs.lo), _mm_mul_pd(lhs.hi, rhs.hi)};
+    }
+    static type
+    div(type lhs, type rhs)
+    {
+        return {_mm_div_pd(lhs.lo, rhs.lo), _mm_div_pd(lhs.hi, rhs.hi)};
+    }
+
+    /**
+     * lhs * rhs + addend, fused when the target has FMA instructions
+     */
+    static type
+    fmadd(type lhs, type rhs, type addend)
+    {
+#    if defined(PSST_MATH_SIMD_FMA)
+        return {_mm_fmadd_pd(lhs.lo, rhs.lo, addend.lo),
+                _mm_fmadd_pd(lhs.hi, rhs.hi, addend.hi)};
+#    else
+        return add(mul(lhs, rhs), addend);
+#    endif
+    }
+    /**
+     * lhs * rhs - subtrahend
+     */
+    static type
+    fmsub(type lhs, type rhs, type subtrahend)
+    {
+#    if defined(PSST_MATH_SIMD_FMA)
+        return {_mm_fmsub_pd(lhs.lo, rhs.lo, subtrahend.lo),
+                _mm_fmsub_pd(lhs.hi, rhs.hi, subtrahend.hi)};
+#    else
+        return sub(mul(lhs, rhs), subtrahend);
+#    endif
+    }
+    /**
+     * minuend - lhs * rhs
+     */
+    static type
+    fnmadd(type lhs, type rhs, type minuend)
+    {
+#    if defined(PSST_MATH_SIMD_FMA)
+        return {_mm_fnmadd_pd(lhs.lo, rhs.lo, minuend.lo),
+                _mm_fnmadd_pd(lhs.hi, rhs.hi, minuend.hi)};
+#    else
+        return sub(minuend, mul(lhs, rhs));
+#    endif
+    }
+
+    static type
+    min(type lhs, type rhs)
+    {
+        return {_mm_min_pd(lhs.lo, rhs.lo), _mm_min_pd(lhs.hi, rhs.hi)};
+    }
+    static type
+    max(type lhs, type rhs)
+    {
+        return {_mm_max_pd(lhs.lo, rhs.lo), _mm_max_pd(lhs.hi, rhs.hi)};
+    }
+    static type
+    abs(type v)
+    {
+        __m128d const sign = _mm_set1_pd(-0.0);
+        return {_mm_andnot_pd(sign, v.lo), _mm_andnot_pd(sign, v.hi)};
+    }
+#    if defined(PSST_MATH_SIMD_SSE41)
+    static constexpr bool has_floor = true;
+    static type
+    floor(type v)
+    {
+        return {_mm_floor_pd(v.lo), _mm_floor_pd(v.hi)};
+    }
+#    else
+    static constexpr bool has_floor = false;
+#    endif
+    static type
+    select(type mask, type a, type b)
+    {
+        return {select(mask.lo, a.lo, b.lo), select(mask.hi, a.hi, b.hi)};
+    }
+
+    static value_type
+    hmin(type v)
+    {
+        __m128d const s = _mm_min_pd(v.lo, high_half(v));
+        return _mm_cvtsd_f64(_mm_min_sd(s, _mm_unpackhi_pd(s, s)));
+    }
+    static value_type
+    hmax(type v)
+    {
+        __m128d const s = _mm_max_pd(v.lo, high_half(v));
+        return _mm_cvtsd_f64(_mm_max_sd(s, _mm_unpackhi_pd(s, s)));
+    }
+
+    static value_type
+    hsum(type v)
+    {
+        __m128d hi = v.hi;
+        if constexpr (Size == 3) {
+            hi = _mm_move_sd(_mm_setzero_pd(), hi);
+        }
+        __m128d s = _mm_add_pd(v.lo, hi);
+        return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+    }
+    static value_type
+    dot(type lhs, type rhs)
+    {
+        return hsum(mul(lhs, rhs));
+    }
+    static type
+    cross(type lhs, type rhs)
+    {
+        // lhs.lo = (x1, y1), lhs.hi = (z1, w1)
+        __m128d l_yz = _mm_shuffle_pd(lhs.lo, lhs.hi, 0b01);    // (y1, z1)
+        __m128d r_yz = _mm_shuffle_pd(rhs.lo, rhs.hi, 0b01);    // (y2, z2)
+        __m128d l_zx = _mm_shuffle_pd(lhs.hi, lhs.lo, 0b00);    // (z1, x1)
+        __m128d r_zx = _mm_shuffle_pd(rhs.hi, rhs.lo, 0b00);    // (z2, x2)
+        // (y1z2 - z1y2, z1x2 - x1z2)
+        __m128d xy = _mm_sub_pd(_mm_mul_pd(l_yz, r_zx), _mm_mul_pd(l_zx, r_yz));
+        // x1y2 - y1x2
+        __m128d z = _mm_sub_sd(_mm_mul_sd(lhs.lo, _mm_unpackhi_pd(rhs.lo, rhs.lo)),
+                               _mm_mul_sd(_mm_unpackhi_pd(lhs.lo, lhs.lo), rhs.lo));
+        return {xy, _mm_move_sd(_mm_setzero_pd(), z)};
+    }
+
+private:
+    static __m128d
+    select(__m128d mask, __m128d a, __m128d b)
+    {
+        __m128d const m = _mm_cmpneq_pd(mask, _mm_setzero_pd());
+#    if defined(PSST_MATH_SIMD_SSE41)
+        return _mm_blendv_pd(b, a, m);
+#    else
+        return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b));
+#    endif
+    }
+    static __m128d
+    high_half(type v)
+    {
+        if constexpr (Size == 3) {
+            return _mm_unpacklo_pd(v.hi, v.hi);
+        } else {
+            return v.hi;
+        }
+    }
+};
+
+#    endif
+//@}
+
+#endif /* PSST_MATH_SIMD_SSE2 */
+
+}    // namespace simd
+}    // namespace math
+}    // namespace psst
+
+#endif /* PSST_MATH_DETAIL_SIMD_HPP_ */
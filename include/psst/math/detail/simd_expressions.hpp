@@ -0,0 +1,477 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * simd_expressions.hpp
+ *
+ *  Created on: Feb 2, 2019
+ *      Author: ser-fedorov
+ */
+
+#ifndef PSST_MATH_DETAIL_SIMD_EXPRESSIONS_HPP_
+#define PSST_MATH_DETAIL_SIMD_EXPRESSIONS_HPP_
+
+#include <psst/math/detail/expressions.hpp>
+#include <psst/math/detail/simd.hpp>
+#include <psst/math/detail/value_policy.hpp>
+
+namespace psst {
+namespace math {
+namespace expr {
+
+inline namespace v {
+
+template <typename LHS, typename RHS>
+struct vector_sum;
+template <typename LHS, typename RHS>
+struct vector_diff;
+template <typename Components, typename LHS, typename RHS>
+struct vector_scalar_multiply;
+template <typename Components, typename LHS, typename RHS>
+struct vector_scalar_divide;
+template <typename Components, typename LHS, typename RHS>
+struct vector_vector_multiply;
+template <typename Vector>
+struct vector_fill;
+template <typename LHS, typename RHS>
+struct vector_min;
+template <typename LHS, typename RHS>
+struct vector_max;
+template <typename Expr>
+struct vector_abs;
+template <typename Expr>
+struct vector_floor;
+template <typename LHS, typename RHS>
+struct vector_hadamard_product;
+template <typename Mask, typename LHS, typename RHS>
+struct vector_select;
+
+//@{
+/** @name Expression is a multiplication of a vector by a scalar */
+template <typename Expr>
+struct is_vector_scalar_multiply : std::false_type {};
+template <typename Components, typename LHS, typename RHS>
+struct is_vector_scalar_multiply<vector_scalar_multiply<Components, LHS, RHS>> : std::true_type {};
+template <typename Expr>
+constexpr bool is_vector_scalar_multiply_v = is_vector_scalar_multiply<std::decay_t<Expr>>::value;
+//@}
+
+/**
+ * Tag type to select evaluation of a vector expression in SIMD registers
+ */
+struct simd_evaluation_tag {};
+
+/**
+ * Primary template for evaluating a vector expression in a SIMD register.
+ * An evaluator specialization provides a static eval function that returns
+ * the whole vector in a register.
+ */
+template <typename Expr, typename = utils::void_t<>>
+struct simd_evaluator {
+    static constexpr bool enabled = false;
+};
+
+//@{
+/** @name simd_evaluable */
+template <typename Expr>
+struct simd_evaluable : utils::bool_constant<simd_evaluator<std::decay_t<Expr>>::enabled> {};
+template <typename Expr>
+using simd_evaluable_t = typename simd_evaluable<Expr>::type;
+template <typename Expr>
+constexpr bool simd_evaluable_v = simd_evaluable_t<Expr>::value;
+//@}
+
+namespace detail {
+
+template <typename Expr>
+using simd_register_for
+    = simd::register_traits<typename std::decay_t<Expr>::value_type, std::decay_t<Expr>::size>;
+
+/**
+ * All the arguments can be evaluated in SIMD registers of the same type as
+ * the expression itself.
+ */
+template <typename Expr, typename... Args>
+constexpr bool simd_args_v
+    = simd_register_for<Expr>::enabled && (simd_evaluable_v<Args> && ...)
+      && (std::is_same<simd_register_for<Expr>, simd_register_for<Args>>::value && ...);
+
+/**
+ * The scalar argument can be broadcast to a register without changing the
+ * result of the arithmetic operation.
+ */
+template <typename T, typename Scalar>
+constexpr bool simd_scalar_arg_v
+    = std::is_same<T, typename std::decay_t<Scalar>::value_type>::value
+      || std::is_integral<typename std::decay_t<Scalar>::value_type>::value;
+
+template <typename T, typename Components>
+constexpr bool simd_plain_components_v
+    = !value_policy::components_have_value_policies_v<Components>
+      && !value_policy::components_have_default_value_policy_v<Components, T>;
+
+}    // namespace detail
+
+template <typename Expr>
+constexpr auto
+simd_eval(Expr const& expr)
+{
+    return simd_evaluator<std::decay_t<Expr>>::eval(expr);
+}
+
+/**
+ * Store the result of an expression to memory, the memory must have room for
+ * all components of the expression.
+ */
+template <typename T, typename Expr>
+void
+simd_store(T* p, Expr const& expr)
+{
+    detail::simd_register_for<Expr>::store(p, simd_eval(expr));
+}
+
+/**
+ * Store the result of an expression to memory aligned to the register
+ * alignment.
+ */
+template <typename T, typename Expr>
+void
+simd_store_aligned(T* p, Expr const& expr)
+{
+    detail::simd_register_for<Expr>::store_aligned(p, simd_eval(expr));
+}
+
+//@{
+/** @name Vector expression can be stored to a vector in one go */
+template <typename T, std::size_t Size, typename Components, typename Expr,
+          typename = utils::void_t<>>
+struct simd_assignable : std::false_type {};
+template <typename T, std::size_t Size, typename Components, typename Expr>
+struct simd_assignable<
+    T, Size, Components, Expr,
+    std::enable_if_t<simd_evaluable_v<
+                         Expr> && detail::simd_plain_components_v<T, Components>&& std::
+                         is_same<simd::register_traits<T, Size>,
+                                 detail::simd_register_for<Expr>>::value>> : std::true_type {};
+template <typename T, std::size_t Size, typename Components, typename Expr>
+using simd_assignable_t = typename simd_assignable<T, Size, Components, Expr>::type;
+template <typename T, std::size_t Size, typename Components, typename Expr>
+constexpr bool simd_assignable_v = simd_assignable_t<T, Size, Components, Expr>::value;
+//@}
+
+//@{
+/** @name simd_padded */
+/**
+ * A vector of Size components stored in a padded memory of StorageSize
+ * components can be loaded to and stored from the register of Size
+ * components as a whole with aligned memory operations.
+ */
+template <typename T, std::size_t Size, std::size_t StorageSize, std::size_t Alignment,
+          typename = utils::void_t<>>
+struct simd_padded : std::false_type {};
+template <typename T, std::size_t Size, std::size_t StorageSize, std::size_t Alignment>
+struct simd_padded<
+    T, Size, StorageSize, Alignment,
+    std::enable_if_t<simd::register_enabled_v<T, Size> && simd::register_enabled_v<T, StorageSize>>>
+    : utils::bool_constant<
+          std::is_same<typename simd::register_traits<T, Size>::type,
+                       typename simd::register_traits<T, StorageSize>::type>::value
+          && sizeof(typename simd::register_traits<T, StorageSize>::type) == sizeof(T) * StorageSize
+          && Alignment >= simd::register_traits<T, StorageSize>::alignment> {};
+template <typename T, std::size_t Size, std::size_t StorageSize, std::size_t Alignment>
+constexpr bool simd_padded_v = simd_padded<T, Size, StorageSize, Alignment>::value;
+//@}
+
+//@{
+/** @name Two vector expressions can be evaluated in the same register type */
+template <typename LHS, typename RHS, typename = utils::void_t<>>
+struct simd_binary : std::false_type {};
+template <typename LHS, typename RHS>
+struct simd_binary<LHS, RHS,
+                   std::enable_if_t<simd_evaluable_v<LHS> && simd_evaluable_v<RHS>>>
+    : std::is_same<detail::simd_register_for<LHS>, detail::simd_register_for<RHS>> {};
+template <typename LHS, typename RHS>
+using simd_binary_t = typename simd_binary<LHS, RHS>::type;
+template <typename LHS, typename RHS>
+constexpr bool simd_binary_v = simd_binary_t<LHS, RHS>::value;
+//@}
+
+template <typename LHS, typename RHS>
+auto
+simd_dot(LHS const& lhs, RHS const& rhs)
+{
+    return detail::simd_register_for<LHS>::dot(simd_eval(lhs), simd_eval(rhs));
+}
+
+//----------------------------------------------------------------------------
+template <typename Expr>
+struct simd_evaluator_base {
+    using expression_type = Expr;
+    using register_traits = detail::simd_register_for<Expr>;
+    using register_type   = typename register_traits::type;
+    using value_type      = typename register_traits::value_type;
+
+    static constexpr bool enabled = true;
+
+    /**
+     * Scalar operand of a multiplication broadcast to all register lanes
+     */
+    template <typename Components, typename LHS, typename RHS>
+    static register_type
+    scalar_arg(vector_scalar_multiply<Components, LHS, RHS> const& ex)
+    {
+        return register_traits::broadcast(static_cast<value_type>(ex.rhs().value()));
+    }
+};
+
+/**
+ * Vectors and vector views are loaded from memory. Vectors with storage
+ * aligned to the register are loaded with aligned loads.
+ */
+template <typename Vector>
+struct simd_evaluator<
+    Vector,
+    std::enable_if_t<traits::is_vector_v<Vector> && detail::simd_register_for<Vector>::enabled>>
+    : simd_evaluator_base<Vector> {
+    using base_type       = simd_evaluator_base<Vector>;
+    using register_type   = typename base_type::register_type;
+    using register_traits = typename base_type::register_traits;
+
+    static register_type
+    eval(Vector const& v)
+    {
+        if constexpr (!traits::is_vector_handle_v<Vector>
+                      && alignof(Vector) >= register_traits::alignment) {
+            return register_traits::load_aligned(v.data());
+        } else {
+            return register_traits::load(v.data());
+        }
+    }
+};
+
+template <typename Vector>
+struct simd_evaluator<vector_fill<Vector>,
+                      std::enable_if_t<detail::simd_register_for<vector_fill<Vector>>::enabled>>
+    : simd_evaluator_base<vector_fill<Vector>> {
+    using base_type     = simd_evaluator_base<vector_fill<Vector>>;
+    using register_type = typename base_type::register_type;
+
+    static register_type
+    eval(vector_fill<Vector> const& ex)
+    {
+        return base_type::register_traits::broadcast(ex.template at<0>());
+    }
+};
+
+template <typename LHS, typename RHS>
+struct simd_evaluator<vector_sum<LHS, RHS>,
+                      std::enable_if_t<detail::simd_args_v<vector_sum<LHS, RHS>, LHS, RHS>>>
+    : simd_evaluator_base<vector_sum<LHS, RHS>> {
+    using base_type     = simd_evaluator_base<vector_sum<LHS, RHS>>;
+    using register_type = typename base_type::register_type;
+
+    static register_type
+    eval(vector_sum<LHS, RHS> const& ex)
+    {
+        using register_traits = typename base_type::register_traits;
+        if constexpr (is_vector_scalar_multiply_v<LHS>) {
+            return register_traits::fmadd(simd_eval(ex.lhs().lhs()),
+                                          base_type::scalar_arg(ex.lhs()), simd_eval(ex.rhs()));
+        } else if constexpr (is_vector_scalar_multiply_v<RHS>) {
+            return register_traits::fmadd(simd_eval(ex.rhs().lhs()),
+                                          base_type::scalar_arg(ex.rhs()), simd_eval(ex.lhs()));
+        } else {
+            return register_traits::add(simd_eval(ex.lhs()), simd_eval(ex.rhs()));
+        }
+    }
+};
+
+template <typename LHS, typename RHS>
+struct simd_evaluator<vector_diff<LHS, RHS>,
+                      std::enable_if_t<detail::simd_args_v<vector_diff<LHS, RHS>, LHS, RHS>>>
+    : simd_evaluator_base<vector_diff<LHS, RHS>> {
+    using base_type     = simd_evaluator_base<vector_diff<LHS, RHS>>;
+    using register_type = typename base_type::register_type;
+
+    static register_type
+    eval(vector_diff<LHS, RHS> const& ex)
+    {
+        using register_traits = typename base_type::register_traits;
+        if constexpr (is_vector_scalar_multiply_v<LHS>) {
+            return register_traits::fmsub(simd_eval(ex.lhs().lhs()),
+                                          base_type::scalar_arg(ex.lhs()), simd_eval(ex.rhs()));
+        } else if constexpr (is_vector_scalar_multiply_v<RHS>) {
+            return register_traits::fnmadd(simd_eval(ex.rhs().lhs()),
+                                           base_type::scalar_arg(ex.rhs()), simd_eval(ex.lhs()));
+        } else {
+            return register_traits::sub(simd_eval(ex.lhs()), simd_eval(ex.rhs()));
+        }
+    }
+};
+
+template <typename Components, typename LHS, typename RHS>
+struct simd_evaluator<
+    vector_scalar_multiply<Components, LHS, RHS>,
+    std::enable_if_t<detail::simd_args_v<
+                         vector_scalar_multiply<Components, LHS, RHS>,
+                         LHS> && detail::simd_scalar_arg_v<typename std::decay_t<LHS>::value_type, RHS>>>
+    : simd_evaluator_base<vector_scalar_multiply<Components, LHS, RHS>> {
+    using base_type     = simd_evaluator_base<vector_scalar_multiply<Components, LHS, RHS>>;
+    using register_type = typename base_type::register_type;
+    using value_type    = typename base_type::value_type;
+
+    static register_type
+    eval(vector_scalar_multiply<Components, LHS, RHS> const& ex)
+    {
+        return base_type::register_traits::mul(simd_eval(ex.lhs()), base_type::scalar_arg(ex));
+    }
+};
+
+template <typename Components, typename LHS, typename RHS>
+struct simd_evaluator<
+    vector_scalar_divide<Components, LHS, RHS>,
+    std::enable_if_t<detail::simd_args_v<
+                         vector_scalar_divide<Components, LHS, RHS>,
+                         LHS> && detail::simd_scalar_arg_v<typename std::decay_t<LHS>::value_type, RHS>>>
+    : simd_evaluator_base<vector_scalar_divide<Components, LHS, RHS>> {
+    using base_type     = simd_evaluator_base<vector_scalar_divide<Components, LHS, RHS>>;
+    using register_type = typename base_type::register_type;
+    using value_type    = typename base_type::value_type;
+
+    static register_type
+    eval(vector_scalar_divide<Components, LHS, RHS> const& ex)
+    {
+        using register_traits = typename base_type::register_traits;
+        return register_traits::div(
+            simd_eval(ex.lhs()),
+            register_traits::broadcast(static_cast<value_type>(ex.rhs().value())));
+    }
+};
+
+/**
+ * Cross product of 3D vectors
+ */
+template <typename LHS, typename RHS>
+struct simd_evaluator<
+    vector_vector_multiply<components::xyzw, LHS, RHS>,
+    std::enable_if_t<
+        std::decay_t<LHS>::size == 3
+        && detail::simd_args_v<vector_vector_multiply<components::xyzw, LHS, RHS>, LHS, RHS>>>
+    : simd_evaluator_base<vector_vector_multiply<components::xyzw, LHS, RHS>> {
+    using base_type     = simd_evaluator_base<vector_vector_multiply<components::xyzw, LHS, RHS>>;
+    using register_type = typename base_type::register_type;
+
+    static register_type
+    eval(vector_vector_multiply<components::xyzw, LHS, RHS> const& ex)
+    {
+        return base_type::register_traits::cross(simd_eval(ex.lhs()), simd_eval(ex.rhs()));
+    }
+};
+
+//----------------------------------------------------------------------------
+/**
+ * Component-wise minimum. The SIMD instructions return the second operand
+ * if the operands are equal or unordered, the operands are swapped to get
+ * the same result as std::min.
+ */
+template <typename LHS, typename RHS>
+struct simd_evaluator<vector_min<LHS, RHS>,
+                      std::enable_if_t<detail::simd_args_v<vector_min<LHS, RHS>, LHS, RHS>>>
+    : simd_evaluator_base<vector_min<LHS, RHS>> {
+    using base_type     = simd_evaluator_base<vector_min<LHS, RHS>>;
+    using register_type = typename base_type::register_type;
+
+    static register_type
+    eval(vector_min<LHS, RHS> const& ex)
+    {
+        return base_type::register_traits::min(simd_eval(ex.rhs()), simd_eval(ex.lhs()));
+    }
+};
+
+/**
+ * Component-wise maximum, the operands are swapped to get the same result as
+ * std::max.
+ */
+template <typename LHS, typename RHS>
+struct simd_evaluator<vector_max<LHS, RHS>,
+                      std::enable_if_t<detail::simd_args_v<vector_max<LHS, RHS>, LHS, RHS>>>
+    : simd_evaluator_base<vector_max<LHS, RHS>> {
+    using base_type     = simd_evaluator_base<vector_max<LHS, RHS>>;
+    using register_type = typename base_type::register_type;
+
+    static register_type
+    eval(vector_max<LHS, RHS> const& ex)
+    {
+        return base_type::register_traits::max(simd_eval(ex.rhs()), simd_eval(ex.lhs()));
+    }
+};
+
+template <typename Expr>
+struct simd_evaluator<vector_abs<Expr>,
+                      std::enable_if_t<detail::simd_args_v<vector_abs<Expr>, Expr>>>
+    : simd_evaluator_base<vector_abs<Expr>> {
+    using base_type     = simd_evaluator_base<vector_abs<Expr>>;
+    using register_type = typename base_type::register_type;
+
+    static register_type
+    eval(vector_abs<Expr> const& ex)
+    {
+        return base_type::register_traits::abs(simd_eval(ex.arg()));
+    }
+};
+
+/**
+ * Rounding instructions require SSE4.1, otherwise the components are
+ * rounded one by one.
+ */
+template <typename Expr>
+struct simd_evaluator<vector_floor<Expr>,
+                      std::enable_if_t<detail::simd_args_v<vector_floor<Expr>, Expr>
+                                       && detail::simd_register_for<Expr>::has_floor>>
+    : simd_evaluator_base<vector_floor<Expr>> {
+    using base_type     = simd_evaluator_base<vector_floor<Expr>>;
+    using register_type = typename base_type::register_type;
+
+    static register_type
+    eval(vector_floor<Expr> const& ex)
+    {
+        return base_type::register_traits::floor(simd_eval(ex.arg()));
+    }
+};
+
+template <typename LHS, typename RHS>
+struct simd_evaluator<
+    vector_hadamard_product<LHS, RHS>,
+    std::enable_if_t<detail::simd_args_v<vector_hadamard_product<LHS, RHS>, LHS, RHS>>>
+    : simd_evaluator_base<vector_hadamard_product<LHS, RHS>> {
+    using base_type     = simd_evaluator_base<vector_hadamard_product<LHS, RHS>>;
+    using register_type = typename base_type::register_type;
+
+    static register_type
+    eval(vector_hadamard_product<LHS, RHS> const& ex)
+    {
+        return base_type::register_traits::mul(simd_eval(ex.lhs()), simd_eval(ex.rhs()));
+    }
+};
+
+template <typename Mask, typename LHS, typename RHS>
+struct simd_evaluator<
+    vector_select<Mask, LHS, RHS>,
+    std::enable_if_t<detail::simd_args_v<vector_select<Mask, LHS, RHS>, Mask, LHS, RHS>>>
+    : simd_evaluator_base<vector_select<Mask, LHS, RHS>> {
+    using base_type     = simd_evaluator_base<vector_select<Mask, LHS, RHS>>;
+    using register_type = typename base_type::register_type;
+
+    static register_type
+    eval(vector_select<Mask, LHS, RHS> const& ex)
+    {
+        return base_type::register_traits::select(simd_eval(ex.mask()), simd_eval(ex.lhs()),
+                                                  simd_eval(ex.rhs()));
+    }
+};
+
+}    // namespace v
+
+}    // namespace expr
+}    // namespace math
+}    // namespace psst
+
+#endif /* PSST_MATH_DETAIL_SIMD_EXPRESSIONS_HPP_ */
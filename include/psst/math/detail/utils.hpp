@@ -79,6 +79,17 @@ constexpr std::size_t min_v = min<V...>::value;
 template <std::size_t... V>
 using make_min_index_sequence = std::make_index_sequence<min_v<V...>>;
 
+template <std::size_t... V>
+struct max;
+template <std::size_t L, std::size_t R>
+struct max<L, R> : size_constant<(L < R) ? R : L> {};
+template <std::size_t L, std::size_t R, std::size_t... V>
+struct max<L, R, V...> : max<max<L, R>::value, max<V...>::value> {};
+template <std::size_t V>
+struct max<V> : size_constant<V> {};
+template <std::size_t... V>
+constexpr std::size_t max_v = max<V...>::value;
+
 using npos                   = size_constant<std::numeric_limits<std::size_t>::max()>;
 constexpr std::size_t npos_v = npos::value;
 
@@ -148,6 +159,37 @@ struct template_tuple<> {
 };
 //@}
 
+/**
+ * Absolute value usable in constant expressions, std::abs is not constexpr.
+ * A negative zero becomes a positive one, a NaN stays NaN.
+ */
+template <typename T>
+constexpr T
+abs_value(T v)
+{
+    if constexpr (std::is_unsigned_v<T>) {
+        return v;
+    } else {
+        return v < T{0} ? -v : v == T{0} ? T{0} : v;
+    }
+}
+
+/**
+ * Pointer type of an iterator that returns elements by value, e.g. views or
+ * references to elements. Holds the element for the member access through
+ * the iterator's operator->.
+ */
+template <typename T>
+struct arrow_proxy {
+    T*
+    operator->()
+    {
+        return &value;
+    }
+
+    T value;
+};
+
 }    // namespace utils
 }    // namespace math
 }    // namespace psst
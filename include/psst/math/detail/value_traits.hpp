@@ -23,6 +23,8 @@ namespace tag {
 struct scalar {};
 struct vector {};
 struct matrix {};
+struct dynamic_vector {};
+struct dynamic_matrix {};
 
 }    // namespace tag
 
@@ -49,8 +51,8 @@ template <typename T, std::size_t Size, typename Components>
 struct value_tag<vector<T, Size, Components>> {
     using type = tag::vector;
 };
-template <typename T, std::size_t RC, std::size_t CC, typename Components>
-struct value_tag<matrix<T, RC, CC, Components>> {
+template <typename T, std::size_t RC, std::size_t CC, typename Components, typename Layout>
+struct value_tag<matrix<T, RC, CC, Components, Layout>> {
     using type = tag::matrix;
 };
 
@@ -205,14 +207,20 @@ struct matrix_size {
 template <typename MatrixType>
 struct matrix_traits;
 
-template <typename T, std::size_t RC, std::size_t CC, typename Components>
-struct matrix_traits<matrix<T, RC, CC, Components>> {
-    using matrix_type      = matrix<T, RC, CC, Components>;
-    using transposed_type  = matrix<T, CC, RC, Components>;
+template <typename T, std::size_t RC, std::size_t CC, typename Components, typename Layout>
+struct matrix_traits<matrix<T, RC, CC, Components, Layout>> {
+    using matrix_type      = matrix<T, RC, CC, Components, Layout>;
+    using transposed_type  = matrix<T, CC, RC, Components, Layout>;
     using type             = matrix_type;
     using value_tag        = tag::matrix;
+    using layout_type      = Layout;
     using row_type         = vector<T, CC, Components>;
     using col_type         = vector<T, RC, Components>;
+    /**
+     * The vectors the matrix is stored as, rows or columns
+     */
+    using major_type
+        = std::conditional_t<std::is_same<Layout, layout::col_major>::value, col_type, row_type>;
     using size_type        = matrix_size<RC, CC>;
     using component_names  = Components;
     using element_type     = T;
@@ -234,6 +242,10 @@ struct matrix_traits<matrix<T, RC, CC, Components>> {
 
     using row_indexes_type = std::make_index_sequence<rows>;
     using col_indexes_type = std::make_index_sequence<cols>;
+
+    static constexpr bool        col_major   = std::is_same<Layout, layout::col_major>::value;
+    static constexpr std::size_t major_count = col_major ? cols : rows;
+    using major_indexes_type                 = std::make_index_sequence<major_count>;
 };
 
 //@{
@@ -272,6 +284,22 @@ template <typename T>
 using enable_if_vector = std::enable_if_t<is_vector_v<T>>;
 //@}
 
+//@{
+/** @name is_vector_handle trait */
+/**
+ * Lightweight vector types referring to memory owned by someone else. Handles
+ * are cheap to copy and are stored in expressions by value.
+ */
+template <typename T>
+struct is_vector_handle : std::false_type {};
+template <typename T, std::size_t S, typename Components>
+struct is_vector_handle<vector_view<T, S, Components>> : std::true_type {};
+template <typename T>
+using is_vector_handle_t = typename is_vector_handle<std::decay_t<T>>::type;
+template <typename T>
+constexpr bool is_vector_handle_v = is_vector_handle_t<T>::value;
+//@}
+
 //@{
 /** @name is_mutable_vector */
 template <typename T>
@@ -299,8 +327,8 @@ using enable_if_mutable_vector = std::enable_if_t<is_mutable_vector_v<T>>;
 /** @name is_matrix trait */
 template <typename T>
 struct is_matrix : std::false_type {};
-template <typename T, std::size_t RC, std::size_t CC, typename Components>
-struct is_matrix<matrix<T, RC, CC, Components>> : std::true_type {};
+template <typename T, std::size_t RC, std::size_t CC, typename Components, typename Layout>
+struct is_matrix<matrix<T, RC, CC, Components, Layout>> : std::true_type {};
 template <typename T>
 using is_matrix_t = typename is_matrix<std::decay_t<T>>::type;
 template <typename T>
@@ -391,6 +419,44 @@ template <typename... T>
 using enable_if_matrix_expressions = std::enable_if_t<(is_matrix_expression_v<T> && ...)>;
 //@}
 
+//@{
+/** @name is_dynamic_vector_expression trait */
+/**
+ * Runtime sized vector expressions. They are evaluated by loops and are
+ * not vector expressions in the sense of is_vector_expression.
+ */
+template <typename T>
+struct is_dynamic_vector_expression
+    : utils::bool_constant<std::is_same<value_tag_t<std::decay_t<T>>, tag::dynamic_vector>::value> {
+};
+template <typename T>
+using is_dynamic_vector_expression_t = typename is_dynamic_vector_expression<T>::type;
+template <typename T>
+constexpr bool is_dynamic_vector_expression_v = is_dynamic_vector_expression_t<T>::value;
+template <typename T>
+using enable_if_dynamic_vector_expression = std::enable_if_t<is_dynamic_vector_expression_v<T>>;
+template <typename... T>
+using enable_if_dynamic_vector_expressions
+    = std::enable_if_t<(is_dynamic_vector_expression_v<T> && ...)>;
+//@}
+
+//@{
+/** @name is_dynamic_matrix_expression trait */
+template <typename T>
+struct is_dynamic_matrix_expression
+    : utils::bool_constant<std::is_same<value_tag_t<std::decay_t<T>>, tag::dynamic_matrix>::value> {
+};
+template <typename T>
+using is_dynamic_matrix_expression_t = typename is_dynamic_matrix_expression<T>::type;
+template <typename T>
+constexpr bool is_dynamic_matrix_expression_v = is_dynamic_matrix_expression_t<T>::value;
+template <typename T>
+using enable_if_dynamic_matrix_expression = std::enable_if_t<is_dynamic_matrix_expression_v<T>>;
+template <typename... T>
+using enable_if_dynamic_matrix_expressions
+    = std::enable_if_t<(is_dynamic_matrix_expression_v<T> && ...)>;
+//@}
+
 //@{
 /** @name Components names trait */
 namespace detail {
@@ -667,10 +733,27 @@ detect_vector_exression_result()
 
 }    // namespace detail
 
+namespace detail {
+
+template <bool Dynamic, typename... T>
+struct vector_expression_result_impl {
+    using type = decltype(detect_vector_exression_result<T...>());
+};
 template <typename... T>
-struct vector_expression_result {
-    using type = decltype(detail::detect_vector_exression_result<std::decay_t<T>...>());
+struct vector_expression_result_impl<true, T...> {
+    using type = dynamic_vector<scalar_expression_result_t<T...>>;
 };
+
+}    // namespace detail
+
+/**
+ * Result of a vector expression. An expression of runtime sized vectors
+ * results in a dynamic vector.
+ */
+template <typename... T>
+struct vector_expression_result
+    : detail::vector_expression_result_impl<(is_dynamic_vector_expression_v<T> || ...),
+                                            std::decay_t<T>...> {};
 template <typename... T>
 using vector_expression_result_t = typename vector_expression_result<T...>::type;
 
@@ -11,7 +11,10 @@
 #include <psst/math/detail/component_access.hpp>
 #include <psst/math/detail/expressions.hpp>
 #include <psst/math/detail/scalar_expressions.hpp>
+#include <psst/math/detail/simd_expressions.hpp>
 
+#include <cmath>
+#include <functional>
 #include <stdexcept>
 
 namespace psst {
@@ -48,6 +51,26 @@ struct vector_expression
         "The number of components in vector expression is less than allowed by components names");
 };
 
+/**
+ * Vector expression over runtime sized vectors. The element-wise expressions
+ * are shared with the fixed size vectors, a dynamic expression is evaluated
+ * in loops by the runtime access at(std::size_t). The size is the size of
+ * the first operand, operand sizes are checked when the expression is built.
+ */
+template <typename Expression, typename T>
+struct vector_expression<Expression, dynamic_vector<T>> {
+    using expression_type = Expression;
+    using result_type     = dynamic_vector<T>;
+    using value_type      = T;
+    using value_tag       = traits::tag::dynamic_vector;
+
+    std::size_t
+    size() const
+    {
+        return first_operand(static_cast<Expression const&>(*this)).size();
+    }
+};
+
 template <template <typename> class Expression, typename Arg,
           typename Result = traits::vector_expression_result_t<Arg>>
 using unary_vector_expression = vector_expression<Expression<Arg>, Result>;
@@ -73,6 +96,17 @@ get(Expression const& exp)
     return static_cast<expression_type const&>(exp).template at<N>();
 }
 
+/**
+ * Evaluate a vector expression to a vector, e.g. to use it several times
+ * without recomputing the components.
+ */
+template <typename Expression, typename = traits::enable_if_vector_expression<Expression>>
+constexpr auto
+eval(Expression&& exp)
+{
+    return typename std::decay_t<Expression>::result_type{std::forward<Expression>(exp)};
+}
+
 template <typename Vector>
 struct vector_fill
     : vector_expression<vector_fill<Vector>, typename std::decay_t<Vector>::result_type> {
@@ -90,11 +124,45 @@ struct vector_fill
     {
         return arg_;
     }
+    constexpr value_type
+    at(std::size_t) const
+    {
+        return arg_;
+    }
 
 private:
     value_type arg_;
 };
 
+//----------------------------------------------------------------------------
+//@{
+/** @name Evaluation in loops */
+/**
+ * A vector expression that provides runtime access to the components with
+ * at(std::size_t) in addition to at<N>(). Large vectors are evaluated and
+ * compared in loops with it.
+ *
+ * @see unroll_threshold
+ */
+template <typename T>
+struct has_runtime_at : std::false_type {};
+template <typename T>
+constexpr bool has_runtime_at_v = has_runtime_at<std::decay_t<T>>::value;
+
+template <typename T, std::size_t Size, typename Components>
+struct has_runtime_at<vector<T, Size, Components>> : std::true_type {};
+template <typename Vector>
+struct has_runtime_at<vector_fill<Vector>> : std::true_type {};
+
+/**
+ * The vector expression is larger than the unroll threshold and is
+ * evaluated in a loop
+ */
+template <typename Expr>
+constexpr bool vector_loop_evaluable_v
+    = (traits::vector_expression_size_v<Expr> > unroll_threshold) && has_runtime_at_v<Expr>;
+//@}
+
 //----------------------------------------------------------------------------
 //@{
 /** @name Compare vector expressions */
@@ -137,6 +205,36 @@ struct vector_expression_cmp {
     }
 };
 
+/**
+ * Comparison of large vectors in a loop
+ */
+template <std::size_t Size, typename LHS, typename RHS>
+struct vector_loop_cmp {
+    using lhs_type    = std::decay_t<LHS>;
+    using rhs_type    = std::decay_t<RHS>;
+    using traits_type = traits::value_traits_t<typename lhs_type::value_type>;
+
+    constexpr static int
+    cmp(lhs_type const& lhs, rhs_type const& rhs)
+    {
+        for (std::size_t i = 0; i < Size; ++i) {
+            auto const res = traits_type::cmp(lhs.at(i), rhs.at(i));
+            if (res != 0) {
+                return res;
+            }
+        }
+        return 0;
+    }
+};
+
+/**
+ * Comparison of the first Size components of vector expressions
+ */
+template <std::size_t Size, typename LHS, typename RHS>
+using vector_cmp_t = std::conditional_t<
+    (Size > unroll_threshold && has_runtime_at_v<LHS> && has_runtime_at_v<RHS>),
+    vector_loop_cmp<Size, LHS, RHS>, vector_expression_cmp<Size - 1, LHS, RHS>>;
+
 }    // namespace detail
 
 template <typename LHS, typename RHS>
@@ -147,7 +245,7 @@ struct vector_cmp : binary_scalar_expression<vector_cmp, LHS, RHS, int>,
                   "Both sides to the comparison must be vector expressions");
     static constexpr std::size_t cmp_size = utils::min_v<traits::vector_expression_size_v<LHS>,
                                                          traits::vector_expression_size_v<RHS>>;
-    using cmp_type                        = detail::vector_expression_cmp<cmp_size - 1, LHS, RHS>;
+    using cmp_type                        = detail::vector_cmp_t<cmp_size, LHS, RHS>;
 
     using expression_base = binary_expression<LHS, RHS>;
     using expression_base::expression_base;
@@ -176,7 +274,7 @@ struct vector_eq : binary_scalar_expression<vector_eq, LHS, RHS, bool>,
                   "Both sides to the comparison must be vector expressions");
     static constexpr std::size_t cmp_size = utils::min_v<traits::vector_expression_size_v<LHS>,
                                                          traits::vector_expression_size_v<RHS>>;
-    using cmp_type                        = detail::vector_expression_cmp<cmp_size - 1, LHS, RHS>;
+    using cmp_type                        = detail::vector_cmp_t<cmp_size, LHS, RHS>;
 
     using expression_base = binary_expression<LHS, RHS>;
     using expression_base::expression_base;
@@ -217,7 +315,7 @@ struct vector_less : binary_scalar_expression<vector_less, LHS, RHS, bool>,
                   "Both sides to the comparison must be vector expressions");
     static constexpr std::size_t cmp_size = utils::min_v<traits::vector_expression_size_v<LHS>,
                                                          traits::vector_expression_size_v<RHS>>;
-    using cmp_type                        = detail::vector_expression_cmp<cmp_size - 1, LHS, RHS>;
+    using cmp_type                        = detail::vector_cmp_t<cmp_size, LHS, RHS>;
 
     using expression_base = binary_expression<LHS, RHS>;
     using expression_base::expression_base;
@@ -282,10 +380,41 @@ struct vector_sum : binary_vector_expression<vector_sum, LHS, RHS>, binary_expre
     at() const
     {
         static_assert(N < base_type::size, "Vector sum component index is out of range");
-        return this->lhs_.template at<N>() + this->rhs_.template at<N>();
+        if constexpr (!utils::fused_multiply_add_v<value_type>) {
+            return this->lhs_.template at<N>() + this->rhs_.template at<N>();
+        } else if constexpr (is_vector_scalar_multiply_v<LHS>) {
+            return utils::multiply_add<value_type>(this->lhs_.lhs().template at<N>(),
+                                                   this->lhs_.rhs().value(),
+                                                   this->rhs_.template at<N>());
+        } else if constexpr (is_vector_scalar_multiply_v<RHS>) {
+            return utils::multiply_add<value_type>(this->rhs_.lhs().template at<N>(),
+                                                   this->rhs_.rhs().value(),
+                                                   this->lhs_.template at<N>());
+        } else {
+            return this->lhs_.template at<N>() + this->rhs_.template at<N>();
+        }
+    }
+    constexpr value_type
+    at(std::size_t i) const
+    {
+        if constexpr (!utils::fused_multiply_add_v<value_type>) {
+            return this->lhs_.at(i) + this->rhs_.at(i);
+        } else if constexpr (is_vector_scalar_multiply_v<LHS>) {
+            return utils::multiply_add<value_type>(this->lhs_.lhs().at(i), this->lhs_.rhs().value(),
+                                                   this->rhs_.at(i));
+        } else if constexpr (is_vector_scalar_multiply_v<RHS>) {
+            return utils::multiply_add<value_type>(this->rhs_.lhs().at(i), this->rhs_.rhs().value(),
+                                                   this->lhs_.at(i));
+        } else {
+            return this->lhs_.at(i) + this->rhs_.at(i);
+        }
     }
 };
 
+template <typename LHS, typename RHS>
+struct has_runtime_at<vector_sum<LHS, RHS>>
+    : utils::bool_constant<has_runtime_at_v<LHS> && has_runtime_at_v<RHS>> {};
+
 template <typename LHS, typename RHS, typename = traits::enable_if_vector_expressions<LHS, RHS>,
           typename = traits::enable_for_compatible_components<LHS, RHS>,
           typename = traits::disable_for_components<LHS, components::polar, components::spherical,
@@ -315,10 +444,41 @@ struct vector_diff : binary_vector_expression<vector_diff, LHS, RHS>, binary_exp
     at() const
     {
         static_assert(N < base_type::size, "Vector difference component index is out of range");
-        return this->lhs_.template at<N>() - this->rhs_.template at<N>();
+        if constexpr (!utils::fused_multiply_add_v<value_type>) {
+            return this->lhs_.template at<N>() - this->rhs_.template at<N>();
+        } else if constexpr (is_vector_scalar_multiply_v<LHS>) {
+            return utils::multiply_add<value_type>(this->lhs_.lhs().template at<N>(),
+                                                   this->lhs_.rhs().value(),
+                                                   -this->rhs_.template at<N>());
+        } else if constexpr (is_vector_scalar_multiply_v<RHS>) {
+            return utils::multiply_add<value_type>(-this->rhs_.lhs().template at<N>(),
+                                                   this->rhs_.rhs().value(),
+                                                   this->lhs_.template at<N>());
+        } else {
+            return this->lhs_.template at<N>() - this->rhs_.template at<N>();
+        }
+    }
+    constexpr value_type
+    at(std::size_t i) const
+    {
+        if constexpr (!utils::fused_multiply_add_v<value_type>) {
+            return this->lhs_.at(i) - this->rhs_.at(i);
+        } else if constexpr (is_vector_scalar_multiply_v<LHS>) {
+            return utils::multiply_add<value_type>(this->lhs_.lhs().at(i), this->lhs_.rhs().value(),
+                                                   -this->rhs_.at(i));
+        } else if constexpr (is_vector_scalar_multiply_v<RHS>) {
+            return utils::multiply_add<value_type>(
+                -this->rhs_.lhs().at(i), this->rhs_.rhs().value(), this->lhs_.at(i));
+        } else {
+            return this->lhs_.at(i) - this->rhs_.at(i);
+        }
     }
 };
 
+template <typename LHS, typename RHS>
+struct has_runtime_at<vector_diff<LHS, RHS>>
+    : utils::bool_constant<has_runtime_at_v<LHS> && has_runtime_at_v<RHS>> {};
+
 template <typename LHS, typename RHS, typename = traits::enable_if_vector_expressions<LHS, RHS>,
           typename = traits::enable_for_compatible_components<LHS, RHS>,
           typename = traits::disable_for_components<LHS, components::polar, components::spherical,
@@ -353,7 +513,16 @@ struct vector_scalar_multiply
         static_assert(N < base_type::size, "Vector multiply component index is out of range");
         return this->lhs_.template at<N>() * this->rhs_;
     }
+    constexpr value_type
+    at(std::size_t i) const
+    {
+        return this->lhs_.at(i) * this->rhs_;
+    }
 };
+
+template <typename Components, typename LHS, typename RHS>
+struct has_runtime_at<vector_scalar_multiply<Components, LHS, RHS>>
+    : utils::bool_constant<has_runtime_at_v<LHS>> {};
 //@}
 
 //@{
@@ -449,8 +618,17 @@ struct vector_scalar_divide
         static_assert(N < base_type::size, "Vector divide component index is out of range");
         return this->lhs_.template at<N>() / this->rhs_;
     }
+    constexpr value_type
+    at(std::size_t i) const
+    {
+        return this->lhs_.at(i) / this->rhs_;
+    }
 };
 
+template <typename Components, typename LHS, typename RHS>
+struct has_runtime_at<vector_scalar_divide<Components, LHS, RHS>>
+    : utils::bool_constant<has_runtime_at_v<LHS>> {};
+
 template <typename LHS, typename RHS,
           typename
           = std::enable_if_t<traits::is_vector_expression_v<LHS> && traits::is_scalar_v<RHS>>>
@@ -493,6 +671,27 @@ private:
 };
 //@}
 
+//----------------------------------------------------------------------------
+namespace detail {
+
+/**
+ * Sum of products of vector components accumulated with fused multiply-add
+ * in several independent chains.
+ */
+template <typename T, typename LHS, typename RHS, std::size_t... Indexes>
+constexpr T
+sum_of_products(LHS const& lhs, RHS const& rhs, std::index_sequence<Indexes...>)
+{
+    return s::detail::multi_accumulate<T, sizeof...(Indexes)>(
+        [&](auto i) { return get<decltype(i)::value>(lhs) * get<decltype(i)::value>(rhs); },
+        [&](T acc, auto i) {
+            return utils::multiply_add<T>(get<decltype(i)::value>(lhs),
+                                          get<decltype(i)::value>(rhs), acc);
+        });
+}
+
+}    // namespace detail
+
 //----------------------------------------------------------------------------
 //@{
 /** @name Magnitude (squared and not) */
@@ -513,10 +712,7 @@ struct vector_magnitude_squared : scalar_expression<vector_magnitude_squared<Com
     constexpr value_type
     value() const
     {
-        if (value_cache_ == nval) {
-            value_cache_ = sum(source_index_type{});
-        }
-        return value_cache_;
+        return sum(source_index_type{});
     }
 
 private:
@@ -524,19 +720,25 @@ private:
     constexpr value_type
     sum(std::index_sequence<Indexes...>) const
     {
-        return s::detail::unchecked_scalar_sum(
-            (get<Indexes>(this->arg_) * get<Indexes>(this->arg_))...);
+        if constexpr (simd_binary_v<Vector, Vector> && simd::constant_evaluation_detected) {
+            if (!simd::is_constant_evaluated()) {
+                return simd_dot(this->arg_, this->arg_);
+            }
+        }
+        if constexpr (utils::fused_multiply_add_v<value_type>) {
+            return detail::sum_of_products<value_type>(this->arg_, this->arg_,
+                                                       source_index_type{});
+        } else {
+            return s::detail::unchecked_scalar_sum(
+                (get<Indexes>(this->arg_) * get<Indexes>(this->arg_))...);
+        }
     }
-    // TODO Optional
-    static constexpr value_type nval         = std::numeric_limits<value_type>::min();
-    mutable value_type          value_cache_ = nval;
 };
 
 template <typename Expr, typename = traits::enable_if_vector_expression<Expr>>
 constexpr auto
 magnitude_square(Expr&& expr)
 {
-    // TODO Special handling for non-cartesian coordinate systems
     using component_names = traits::component_names_t<Expr>;
     return make_unary_expression<
         select_unary_impl<component_names, vector_magnitude_squared>::template type>(
@@ -579,18 +781,29 @@ distance(LHS&& lhs, RHS&& rhs)
 template <typename Components, typename Expr>
 struct vector_normalize;
 
+/**
+ * Normalized vector.
+ *
+ * The result is evaluated right away, so that the magnitude is computed once
+ * from the same components that are scaled by it.
+ */
 template <typename Expr, typename = traits::enable_if_vector_expression<Expr>>
 constexpr auto
 normalize(Expr&& expr)
 {
-    // TODO Special handling for non-cartesian coordinate systems
     using component_names = traits::component_names_t<Expr>;
     if constexpr (utils::is_decl_complete_v<vector_normalize<component_names, Expr>>) {
-        return make_unary_expression<
-            select_unary_impl<component_names, vector_normalize>::template type>(
-            std::forward<Expr>(expr));
+        return eval(make_unary_expression<
+                    select_unary_impl<component_names, vector_normalize>::template type>(
+            std::forward<Expr>(expr)));
     } else {
-        return expr / magnitude(expr);
+        using value_type = typename std::decay_t<Expr>::value_type;
+        auto const mag   = eval(magnitude(expr));
+        if constexpr (std::is_floating_point_v<value_type>) {
+            return eval(std::forward<Expr>(expr) * (value_type{1} / mag));
+        } else {
+            return eval(std::forward<Expr>(expr) / mag);
+        }
     }
 }
 //@}
@@ -622,6 +835,512 @@ apply(Expr&& expr, Predicate&& pred)
     return make_binary_expression<vector_apply>(std::forward<Expr>(expr),
                                                 std::forward<Predicate>(pred));
 }
+
+//----------------------------------------------------------------------------
+//@{
+/**
+ * @name Element-wise functions
+ *
+ * Each component of the result depends only on the components of the
+ * arguments with the same index. The expressions are evaluated in SIMD
+ * registers when enabled, and in loops for large vectors.
+ */
+namespace detail {
+
+/**
+ * The same as std::min, the first argument if the arguments are equal
+ */
+struct minimum {
+    template <typename T>
+    constexpr T
+    operator()(T const& lhs, T const& rhs) const
+    {
+        return rhs < lhs ? rhs : lhs;
+    }
+};
+/**
+ * The same as std::max, the first argument if the arguments are equal
+ */
+struct maximum {
+    template <typename T>
+    constexpr T
+    operator()(T const& lhs, T const& rhs) const
+    {
+        return lhs < rhs ? rhs : lhs;
+    }
+};
+
+/**
+ * std::floor at run time. In a constant expression a value that can have a
+ * fraction is truncated and adjusted, larger values, infinities and NaNs
+ * are returned as is.
+ */
+template <typename T>
+constexpr T
+floor_value(T v)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        if (simd::is_constant_evaluated()) {
+            if (!(utils::abs_value(v) < T{4611686018427387904.0}) || v == T{0})
+                return v;
+            auto const t = static_cast<T>(static_cast<long long>(v));
+            return t > v ? t - T{1} : t;
+        }
+        using std::floor;
+        return floor(v);
+    } else {
+        return v;
+    }
+}
+
+/**
+ * A scalar argument of an element-wise function is broadcast to a vector of
+ * the same type as the other argument
+ */
+template <typename Vector, typename T>
+constexpr decltype(auto)
+elementwise_arg(T&& arg)
+{
+    if constexpr (traits::is_scalar_v<T>) {
+        using vector_type = traits::vector_expression_result_t<Vector>;
+        return vector_fill<vector_type>(
+            static_cast<typename vector_type::value_type>(std::forward<T>(arg)));
+    } else {
+        return std::forward<T>(arg);
+    }
+}
+
+template <typename Vector, typename T>
+constexpr bool elementwise_arg_v
+    = traits::is_scalar_v<T>
+      || (traits::is_vector_expression_v<T> && traits::compatible_components_v<Vector, T>);
+
+}    // namespace detail
+
+template <typename LHS, typename RHS>
+struct vector_min : binary_vector_expression<vector_min, LHS, RHS>, binary_expression<LHS, RHS> {
+    using base_type  = binary_vector_expression<vector_min, LHS, RHS>;
+    using value_type = typename base_type::value_type;
+
+    using expression_base = binary_expression<LHS, RHS>;
+    using expression_base::expression_base;
+
+    template <std::size_t N>
+    constexpr value_type
+    at() const
+    {
+        static_assert(N < base_type::size, "Vector min component index is out of range");
+        return detail::minimum{}(static_cast<value_type>(this->lhs_.template at<N>()),
+                                 static_cast<value_type>(this->rhs_.template at<N>()));
+    }
+    constexpr value_type
+    at(std::size_t i) const
+    {
+        return detail::minimum{}(static_cast<value_type>(this->lhs_.at(i)),
+                                 static_cast<value_type>(this->rhs_.at(i)));
+    }
+};
+
+template <typename LHS, typename RHS>
+struct has_runtime_at<vector_min<LHS, RHS>>
+    : utils::bool_constant<has_runtime_at_v<LHS> && has_runtime_at_v<RHS>> {};
+
+template <typename LHS, typename RHS>
+struct vector_max : binary_vector_expression<vector_max, LHS, RHS>, binary_expression<LHS, RHS> {
+    using base_type  = binary_vector_expression<vector_max, LHS, RHS>;
+    using value_type = typename base_type::value_type;
+
+    using expression_base = binary_expression<LHS, RHS>;
+    using expression_base::expression_base;
+
+    template <std::size_t N>
+    constexpr value_type
+    at() const
+    {
+        static_assert(N < base_type::size, "Vector max component index is out of range");
+        return detail::maximum{}(static_cast<value_type>(this->lhs_.template at<N>()),
+                                 static_cast<value_type>(this->rhs_.template at<N>()));
+    }
+    constexpr value_type
+    at(std::size_t i) const
+    {
+        return detail::maximum{}(static_cast<value_type>(this->lhs_.at(i)),
+                                 static_cast<value_type>(this->rhs_.at(i)));
+    }
+};
+
+template <typename LHS, typename RHS>
+struct has_runtime_at<vector_max<LHS, RHS>>
+    : utils::bool_constant<has_runtime_at_v<LHS> && has_runtime_at_v<RHS>> {};
+
+/**
+ * Component-wise minimum of two vectors or of a vector and a scalar
+ */
+template <typename LHS, typename RHS,
+          typename = std::enable_if_t<traits::is_vector_expression_v<LHS>
+                                      && detail::elementwise_arg_v<LHS, RHS>>,
+          typename = traits::disable_for_components<LHS, components::polar, components::spherical,
+                                                    components::cylindrical>>
+constexpr auto
+min(LHS&& lhs, RHS&& rhs)
+{
+    return make_binary_expression<vector_min>(
+        std::forward<LHS>(lhs), detail::elementwise_arg<LHS>(std::forward<RHS>(rhs)));
+}
+
+/**
+ * Component-wise maximum of two vectors or of a vector and a scalar
+ */
+template <typename LHS, typename RHS,
+          typename = std::enable_if_t<traits::is_vector_expression_v<LHS>
+                                      && detail::elementwise_arg_v<LHS, RHS>>,
+          typename = traits::disable_for_components<LHS, components::polar, components::spherical,
+                                                    components::cylindrical>>
+constexpr auto
+max(LHS&& lhs, RHS&& rhs)
+{
+    return make_binary_expression<vector_max>(
+        std::forward<LHS>(lhs), detail::elementwise_arg<LHS>(std::forward<RHS>(rhs)));
+}
+
+/**
+ * Components of a vector clamped to the range, the bounds are vectors or
+ * scalars. The same as std::clamp for each component.
+ */
+template <typename Expr, typename Low, typename High,
+          typename = std::enable_if_t<traits::is_vector_expression_v<Expr>
+                                      && detail::elementwise_arg_v<Expr, Low>
+                                      && detail::elementwise_arg_v<Expr, High>>,
+          typename = traits::disable_for_components<Expr, components::polar, components::spherical,
+                                                    components::cylindrical>>
+constexpr auto
+clamp(Expr&& expr, Low&& low, High&& high)
+{
+    return min(max(std::forward<Expr>(expr), std::forward<Low>(low)), std::forward<High>(high));
+}
+
+template <typename Expr>
+struct vector_abs : unary_vector_expression<vector_abs, Expr>, unary_expression<Expr> {
+    using base_type  = unary_vector_expression<vector_abs, Expr>;
+    using value_type = typename base_type::value_type;
+
+    using expression_base = unary_expression<Expr>;
+    using expression_base::expression_base;
+
+    template <std::size_t N>
+    constexpr value_type
+    at() const
+    {
+        static_assert(N < base_type::size, "Vector abs component index is out of range");
+        return utils::abs_value<value_type>(this->arg_.template at<N>());
+    }
+    constexpr value_type
+    at(std::size_t i) const
+    {
+        return utils::abs_value<value_type>(this->arg_.at(i));
+    }
+};
+
+template <typename Expr>
+struct has_runtime_at<vector_abs<Expr>> : utils::bool_constant<has_runtime_at_v<Expr>> {};
+
+template <typename Expr, typename = traits::enable_if_vector_expression<Expr>,
+          typename = traits::disable_for_components<Expr, components::polar, components::spherical,
+                                                    components::cylindrical>>
+constexpr auto
+abs(Expr&& expr)
+{
+    return make_unary_expression<vector_abs>(std::forward<Expr>(expr));
+}
+
+template <typename Expr>
+struct vector_floor : unary_vector_expression<vector_floor, Expr>, unary_expression<Expr> {
+    using base_type  = unary_vector_expression<vector_floor, Expr>;
+    using value_type = typename base_type::value_type;
+
+    using expression_base = unary_expression<Expr>;
+    using expression_base::expression_base;
+
+    template <std::size_t N>
+    constexpr value_type
+    at() const
+    {
+        static_assert(N < base_type::size, "Vector floor component index is out of range");
+        return detail::floor_value<value_type>(this->arg_.template at<N>());
+    }
+    constexpr value_type
+    at(std::size_t i) const
+    {
+        return detail::floor_value<value_type>(this->arg_.at(i));
+    }
+};
+
+template <typename Expr>
+struct has_runtime_at<vector_floor<Expr>> : utils::bool_constant<has_runtime_at_v<Expr>> {};
+
+template <typename Expr, typename = traits::enable_if_vector_expression<Expr>,
+          typename = traits::disable_for_components<Expr, components::polar, components::spherical,
+                                                    components::cylindrical>>
+constexpr auto
+floor(Expr&& expr)
+{
+    return make_unary_expression<vector_floor>(std::forward<Expr>(expr));
+}
+
+/**
+ * Component-wise product of two vectors
+ */
+template <typename LHS, typename RHS>
+struct vector_hadamard_product : binary_vector_expression<vector_hadamard_product, LHS, RHS>,
+                                 binary_expression<LHS, RHS> {
+    using base_type  = binary_vector_expression<vector_hadamard_product, LHS, RHS>;
+    using value_type = typename base_type::value_type;
+
+    using expression_base = binary_expression<LHS, RHS>;
+    using expression_base::expression_base;
+
+    template <std::size_t N>
+    constexpr value_type
+    at() const
+    {
+        static_assert(N < base_type::size, "Hadamard product component index is out of range");
+        return this->lhs_.template at<N>() * this->rhs_.template at<N>();
+    }
+    constexpr value_type
+    at(std::size_t i) const
+    {
+        return this->lhs_.at(i) * this->rhs_.at(i);
+    }
+};
+
+template <typename LHS, typename RHS>
+struct has_runtime_at<vector_hadamard_product<LHS, RHS>>
+    : utils::bool_constant<has_runtime_at_v<LHS> && has_runtime_at_v<RHS>> {};
+
+template <typename LHS, typename RHS, typename = traits::enable_if_vector_expressions<LHS, RHS>,
+          typename = traits::enable_for_compatible_components<LHS, RHS>,
+          typename = traits::disable_for_components<LHS, components::polar, components::spherical,
+                                                    components::cylindrical>>
+constexpr auto
+hadamard_product(LHS&& lhs, RHS&& rhs)
+{
+    return make_binary_expression<vector_hadamard_product>(std::forward<LHS>(lhs),
+                                                           std::forward<RHS>(rhs));
+}
+
+/**
+ * Components of the first vector where the components of the mask are not
+ * zero, components of the second vector otherwise
+ */
+template <typename Mask, typename LHS, typename RHS>
+struct vector_select : vector_expression<vector_select<Mask, LHS, RHS>,
+                                         traits::vector_expression_result_t<LHS, RHS>>,
+                       n_ary_expression<Mask, LHS, RHS> {
+    using base_type       = vector_expression<vector_select<Mask, LHS, RHS>,
+                                        traits::vector_expression_result_t<LHS, RHS>>;
+    using value_type      = typename base_type::value_type;
+    using expression_base = n_ary_expression<Mask, LHS, RHS>;
+    using expression_base::expression_base;
+
+    static_assert(traits::vector_expression_size_v<Mask> >= base_type::size,
+                  "The mask must have a component for each component of the result");
+
+    constexpr decltype(auto)
+    mask() const
+    {
+        return std::get<0>(this->args_);
+    }
+    constexpr decltype(auto)
+    lhs() const
+    {
+        return std::get<1>(this->args_);
+    }
+    constexpr decltype(auto)
+    rhs() const
+    {
+        return std::get<2>(this->args_);
+    }
+
+    template <std::size_t N>
+    constexpr value_type
+    at() const
+    {
+        static_assert(N < base_type::size, "Vector select component index is out of range");
+        return mask().template at<N>() != 0 ? static_cast<value_type>(lhs().template at<N>())
+                                            : static_cast<value_type>(rhs().template at<N>());
+    }
+    constexpr value_type
+    at(std::size_t i) const
+    {
+        return mask().at(i) != 0 ? static_cast<value_type>(lhs().at(i))
+                                 : static_cast<value_type>(rhs().at(i));
+    }
+};
+
+template <typename Mask, typename LHS, typename RHS>
+struct has_runtime_at<vector_select<Mask, LHS, RHS>>
+    : utils::bool_constant<has_runtime_at_v<Mask> && has_runtime_at_v<LHS>
+                           && has_runtime_at_v<RHS>> {};
+
+template <typename Mask, typename LHS, typename RHS,
+          typename = traits::enable_if_vector_expressions<Mask, LHS, RHS>,
+          typename = traits::enable_for_compatible_components<LHS, RHS>>
+constexpr auto
+select(Mask&& mask, LHS&& lhs, RHS&& rhs)
+{
+    return make_n_ary_expression<vector_select>(std::forward<Mask>(mask), std::forward<LHS>(lhs),
+                                                std::forward<RHS>(rhs));
+}
+//@}
+
+//----------------------------------------------------------------------------
+//@{
+/**
+ * @name Reductions of vector components
+ *
+ * The smallest and the largest components are reduced pairwise, or in a
+ * SIMD register when enabled. The index search is a scalar loop, it is
+ * vectorized by the compiler across the calls better than a lane mask
+ * search. The result for vectors with NaN components is unspecified.
+ */
+namespace detail {
+
+/**
+ * Index of the first component that is less than all previous ones
+ * according to the comparison
+ */
+template <typename Compare, typename Vector, std::size_t First, std::size_t... Indexes>
+constexpr std::size_t
+arg_extremum(Vector const& v, Compare cmp, std::index_sequence<First, Indexes...>)
+{
+    auto        best  = get<First>(v);
+    std::size_t index = First;
+    auto const  update = [&](std::size_t i, auto val) {
+        if (cmp(val, best)) {
+            best  = val;
+            index = i;
+        }
+    };
+    (update(Indexes, get<Indexes>(v)), ...);
+    return index;
+}
+
+}    // namespace detail
+
+template <typename Expr>
+struct vector_min_component : unary_scalar_expression<vector_min_component, Expr>,
+                              unary_expression<Expr> {
+    using base_type  = unary_scalar_expression<vector_min_component, Expr>;
+    using value_type = typename base_type::value_type;
+
+    using expression_base = unary_expression<Expr>;
+    using expression_base::expression_base;
+
+    constexpr value_type
+    value() const
+    {
+        if constexpr (simd_evaluable_v<Expr> && simd::constant_evaluation_detected) {
+            if (!simd::is_constant_evaluated()) {
+                return detail::simd_register_for<Expr>::hmin(simd_eval(this->arg_));
+            }
+        }
+        return s::detail::tree_reduce<0, std::decay_t<Expr>::size>(
+            detail::minimum{}, [this](auto i) { return get<decltype(i)::value>(this->arg_); });
+    }
+};
+
+template <typename Expr>
+struct vector_max_component : unary_scalar_expression<vector_max_component, Expr>,
+                              unary_expression<Expr> {
+    using base_type  = unary_scalar_expression<vector_max_component, Expr>;
+    using value_type = typename base_type::value_type;
+
+    using expression_base = unary_expression<Expr>;
+    using expression_base::expression_base;
+
+    constexpr value_type
+    value() const
+    {
+        if constexpr (simd_evaluable_v<Expr> && simd::constant_evaluation_detected) {
+            if (!simd::is_constant_evaluated()) {
+                return detail::simd_register_for<Expr>::hmax(simd_eval(this->arg_));
+            }
+        }
+        return s::detail::tree_reduce<0, std::decay_t<Expr>::size>(
+            detail::maximum{}, [this](auto i) { return get<decltype(i)::value>(this->arg_); });
+    }
+};
+
+template <typename Expr>
+struct vector_argmin : unary_scalar_expression<vector_argmin, Expr, std::size_t>,
+                       unary_expression<Expr> {
+    using expression_base = unary_expression<Expr>;
+    using expression_base::expression_base;
+
+    constexpr std::size_t
+    value() const
+    {
+        return detail::arg_extremum(this->arg_, std::less<>{},
+                                    typename std::decay_t<Expr>::index_sequence_type{});
+    }
+};
+
+template <typename Expr>
+struct vector_argmax : unary_scalar_expression<vector_argmax, Expr, std::size_t>,
+                       unary_expression<Expr> {
+    using expression_base = unary_expression<Expr>;
+    using expression_base::expression_base;
+
+    constexpr std::size_t
+    value() const
+    {
+        return detail::arg_extremum(this->arg_, std::greater<>{},
+                                    typename std::decay_t<Expr>::index_sequence_type{});
+    }
+};
+
+/**
+ * The smallest component of a vector
+ */
+template <typename Expr, typename = traits::enable_if_vector_expression<Expr>>
+constexpr auto
+min_component(Expr&& expr)
+{
+    return make_unary_expression<vector_min_component>(std::forward<Expr>(expr));
+}
+
+/**
+ * The largest component of a vector
+ */
+template <typename Expr, typename = traits::enable_if_vector_expression<Expr>>
+constexpr auto
+max_component(Expr&& expr)
+{
+    return make_unary_expression<vector_max_component>(std::forward<Expr>(expr));
+}
+
+/**
+ * Index of the smallest component of a vector, the first one if there are
+ * several
+ */
+template <typename Expr, typename = traits::enable_if_vector_expression<Expr>>
+constexpr auto
+argmin(Expr&& expr)
+{
+    return make_unary_expression<vector_argmin>(std::forward<Expr>(expr));
+}
+
+/**
+ * Index of the largest component of a vector, the first one if there are
+ * several
+ */
+template <typename Expr, typename = traits::enable_if_vector_expression<Expr>>
+constexpr auto
+argmax(Expr&& expr)
+{
+    return make_unary_expression<vector_argmax>(std::forward<Expr>(expr));
+}
+//@}
 //----------------------------------------------------------------------------
 //@{
 /** @name Dot product of two vectors */
@@ -645,10 +1364,7 @@ struct vector_dot_product : binary_scalar_expression<vector_dot_product, LHS, RH
     constexpr value_type
     value() const
     {
-        if (value_cache_ == nval) {
-            value_cache_ = sum(source_index_type{});
-        }
-        return value_cache_;
+        return sum(source_index_type{});
     }
 
 private:
@@ -656,12 +1372,19 @@ private:
     constexpr value_type
     sum(std::index_sequence<Indexes...>) const
     {
-        return s::detail::unchecked_scalar_sum(
-            (get<Indexes>(this->lhs_) * get<Indexes>(this->rhs_))...);
+        if constexpr (simd_binary_v<LHS, RHS> && simd::constant_evaluation_detected) {
+            if (!simd::is_constant_evaluated()) {
+                return simd_dot(this->lhs_, this->rhs_);
+            }
+        }
+        if constexpr (utils::fused_multiply_add_v<value_type>) {
+            return detail::sum_of_products<value_type>(this->lhs_, this->rhs_,
+                                                       source_index_type{});
+        } else {
+            return s::detail::unchecked_scalar_sum(
+                (get<Indexes>(this->lhs_) * get<Indexes>(this->rhs_))...);
+        }
     }
-    // TODO Optional
-    static constexpr value_type nval         = std::numeric_limits<value_type>::min();
-    mutable value_type          value_cache_ = nval;
 };
 
 template <typename LHS, typename RHS, typename = traits::enable_if_vector_expressions<LHS, RHS>,
@@ -716,15 +1439,15 @@ slerp(Start&& start, End&& end, U&& percent)
     using std::cos;
     using std::sin;
 
-    auto s_mag = magnitude(start);
+    auto s_mag = eval(magnitude(start));
     auto s_n   = start / s_mag;    // normalized
 
-    auto e_mag = magnitude(end);
+    auto e_mag = eval(magnitude(end));
     auto e_n   = end / e_mag;    // normalized
     // Lerp magnitude
     auto res_mag = s_mag + (e_mag - s_mag) * percent;
 
-    auto dot = dot_product(s_n, e_n);
+    auto dot = eval(dot_product(s_n, e_n));
     if (value_traits::eq(dot, 0)) {
         // Perpendicular vectors
         auto theta = acos(dot) * percent;
@@ -15,9 +15,10 @@ namespace psst {
 namespace math {
 namespace detail {
 
-template <typename T, std::size_t Size, typename Components>
+template <typename T, std::size_t Size, typename Components,
+          typename VectorType = vector<T, Size, Components>>
 struct vector_ops {
-    using vector_type      = vector<T, Size, Components>;
+    using vector_type      = VectorType;
     using value_traits     = traits::scalar_value_traits<T>;
     using value_type       = typename value_traits::value_type;
     using lvalue_reference = typename value_traits::lvalue_reference;
@@ -109,7 +110,11 @@ struct vector_ops {
         value_type m = magnitude();
         if (m != 0) {
             if (m != 1) {
-                rebind() /= m;
+                if constexpr (std::is_floating_point<value_type>::value) {
+                    rebind() *= value_type{1} / m;
+                } else {
+                    rebind() /= m;
+                }
             }
         } else {
             throw std::runtime_error("Cannot normalize a zero vector");
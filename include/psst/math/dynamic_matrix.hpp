@@ -0,0 +1,253 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * dynamic_matrix.hpp
+ *
+ *  Created on: Feb 8, 2019
+ *      Author: ser-fedorov
+ */
+
+#ifndef PSST_MATH_DYNAMIC_MATRIX_HPP_
+#define PSST_MATH_DYNAMIC_MATRIX_HPP_
+
+#include <psst/math/dynamic_vector.hpp>
+#include <psst/math/matrix.hpp>
+
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace psst {
+namespace math {
+
+/**
+ * Heap allocated row-major matrix with the sizes known at runtime.
+ *
+ * Participates in the dynamic expressions, that are evaluated in loops.
+ * Can be constructed from a fixed size matrix expression.
+ */
+template <typename T>
+struct dynamic_matrix : expr::dynamic_matrix_expression<dynamic_matrix<T>, T> {
+    using this_type        = dynamic_matrix<T>;
+    using storage_type     = std::vector<T>;
+    using value_type       = T;
+    using lvalue_reference = typename storage_type::reference;
+    using const_reference  = typename storage_type::const_reference;
+    using pointer          = typename storage_type::pointer;
+    using const_pointer    = typename storage_type::const_pointer;
+    using init_list        = std::initializer_list<std::initializer_list<value_type>>;
+
+    dynamic_matrix() = default;
+    /**
+     * Construct a matrix of the given size with all elements set to the same
+     * value.
+     */
+    dynamic_matrix(std::size_t rows, std::size_t cols, value_type v = value_type{0})
+        : rows_{rows}, cols_{cols}, data_(rows * cols, v)
+    {}
+    /**
+     * Construct a matrix from rows
+     * @throws std::runtime_error if the rows are not of the same size
+     */
+    dynamic_matrix(init_list args)
+        : rows_{args.size()}, cols_{args.size() > 0 ? args.begin()->size() : 0}
+    {
+        data_.reserve(rows_ * cols_);
+        for (auto const& row : args) {
+            if (row.size() != cols_)
+                throw std::runtime_error("Dynamic matrix rows must be of the same size");
+            data_.insert(data_.end(), row.begin(), row.end());
+        }
+    }
+
+    template <typename Expression,
+              typename = math::traits::enable_if_dynamic_matrix_expression<Expression>>
+    dynamic_matrix(Expression&& rhs)
+    {
+        assign(std::forward<Expression>(rhs));
+    }
+    template <typename Expression, typename = math::traits::enable_if_matrix_expression<Expression>,
+              typename = void>
+    explicit dynamic_matrix(Expression const& rhs)
+        : rows_{std::decay_t<Expression>::rows},
+          cols_{std::decay_t<Expression>::cols},
+          data_(rows_ * cols_)
+    {
+        // The fixed size matrix is evaluated, its elements are accessible by
+        // runtime indexes
+        auto const m = expr::eval(rhs);
+        for (std::size_t r = 0; r < rows_; ++r) {
+            for (std::size_t c = 0; c < cols_; ++c) {
+                data_[r * cols_ + c] = m[r][c];
+            }
+        }
+    }
+
+    dynamic_matrix(dynamic_matrix const&) = default;
+    dynamic_matrix(dynamic_matrix&&)      = default;
+    dynamic_matrix&
+    operator=(dynamic_matrix const&)
+        = default;
+    dynamic_matrix&
+    operator=(dynamic_matrix&&)
+        = default;
+
+    template <typename Expression,
+              typename = math::traits::enable_if_dynamic_matrix_expression<Expression>>
+    dynamic_matrix&
+    operator=(Expression&& rhs)
+    {
+        assign(std::forward<Expression>(rhs));
+        return *this;
+    }
+
+    static dynamic_matrix
+    identity(std::size_t size)
+    {
+        dynamic_matrix res(size, size);
+        for (std::size_t i = 0; i < size; ++i) {
+            res.data_[i * size + i] = value_type{1};
+        }
+        return res;
+    }
+
+    std::size_t
+    rows() const
+    {
+        return rows_;
+    }
+    std::size_t
+    cols() const
+    {
+        return cols_;
+    }
+    std::size_t
+    size() const
+    {
+        return data_.size();
+    }
+
+    value_type
+    element(std::size_t r, std::size_t c) const
+    {
+        return data_[r * cols_ + c];
+    }
+
+    /**
+     * Pointer to the beginning of a row, so that m[r][c] works as for the
+     * fixed size matrices
+     */
+    pointer operator[](std::size_t r) { return data_.data() + r * cols_; }
+    const_pointer operator[](std::size_t r) const { return data_.data() + r * cols_; }
+
+    pointer
+    data()
+    {
+        return data_.data();
+    }
+    const_pointer
+    data() const
+    {
+        return data_.data();
+    }
+
+    template <typename Expression,
+              typename = math::traits::enable_if_dynamic_matrix_expression<Expression>>
+    dynamic_matrix&
+    operator+=(Expression const& rhs)
+    {
+        expr::dyn::detail::check_dynamic_size(rows_, rhs.rows());
+        expr::dyn::detail::check_dynamic_size(cols_, rhs.cols());
+        if constexpr (expr::is_elementwise_v<Expression>) {
+            for (std::size_t r = 0; r < rows_; ++r) {
+                for (std::size_t c = 0; c < cols_; ++c) {
+                    data_[r * cols_ + c] += rhs.element(r, c);
+                }
+            }
+            return *this;
+        } else {
+            // The expression may read this matrix at other positions
+            return *this += this_type{rhs};
+        }
+    }
+    template <typename Expression,
+              typename = math::traits::enable_if_dynamic_matrix_expression<Expression>>
+    dynamic_matrix&
+    operator-=(Expression const& rhs)
+    {
+        expr::dyn::detail::check_dynamic_size(rows_, rhs.rows());
+        expr::dyn::detail::check_dynamic_size(cols_, rhs.cols());
+        if constexpr (expr::is_elementwise_v<Expression>) {
+            for (std::size_t r = 0; r < rows_; ++r) {
+                for (std::size_t c = 0; c < cols_; ++c) {
+                    data_[r * cols_ + c] -= rhs.element(r, c);
+                }
+            }
+            return *this;
+        } else {
+            // The expression may read this matrix at other positions
+            return *this -= this_type{rhs};
+        }
+    }
+    dynamic_matrix&
+    operator*=(value_type s)
+    {
+        for (auto& v : data_) {
+            v *= s;
+        }
+        return *this;
+    }
+    dynamic_matrix&
+    operator/=(value_type s)
+    {
+        for (auto& v : data_) {
+            v /= s;
+        }
+        return *this;
+    }
+
+private:
+    template <typename Expression>
+    void
+    assign(Expression&& rhs)
+    {
+        if constexpr (std::is_same<std::decay_t<Expression>, this_type>::value) {
+            rows_ = rhs.rows_;
+            cols_ = rhs.cols_;
+            data_ = std::forward<Expression>(rhs).data_;
+        } else if constexpr (expr::use_blocked_dynamic_product_v<Expression>
+                             && std::is_same<typename std::decay_t<Expression>::value_type,
+                                             value_type>::value) {
+            auto const&  a = rhs.lhs();
+            auto const&  b = rhs.rhs();
+            storage_type tmp(a.rows() * b.cols());
+            math::detail::gemm(a.rows(), b.cols(), a.cols(), a.data(), a.cols(), b.data(),
+                               b.cols(), tmp.data(), b.cols());
+            rows_ = a.rows();
+            cols_ = b.cols();
+            data_.swap(tmp);
+        } else {
+            // Evaluate to a temporary, the expression may refer to this matrix
+            auto const   rows = rhs.rows();
+            auto const   cols = rhs.cols();
+            storage_type tmp(rows * cols);
+            for (std::size_t r = 0; r < rows; ++r) {
+                for (std::size_t c = 0; c < cols; ++c) {
+                    tmp[r * cols + c] = rhs.element(r, c);
+                }
+            }
+            rows_ = rows;
+            cols_ = cols;
+            data_.swap(tmp);
+        }
+    }
+
+    std::size_t  rows_ = 0;
+    std::size_t  cols_ = 0;
+    storage_type data_;
+};
+
+}    // namespace math
+}    // namespace psst
+
+#endif /* PSST_MATH_DYNAMIC_MATRIX_HPP_ */
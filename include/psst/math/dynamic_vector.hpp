@@ -0,0 +1,214 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * dynamic_vector.hpp
+ *
+ *  Created on: Feb 8, 2019
+ *      Author: ser-fedorov
+ */
+
+#ifndef PSST_MATH_DYNAMIC_VECTOR_HPP_
+#define PSST_MATH_DYNAMIC_VECTOR_HPP_
+
+#include <psst/math/detail/dynamic_expressions.hpp>
+#include <psst/math/detail/vector_expressions.hpp>
+
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace psst {
+namespace math {
+
+/**
+ * Heap allocated vector with the size known at runtime.
+ *
+ * Participates in the dynamic expressions, that are evaluated in loops.
+ * Can be constructed from a fixed size vector expression.
+ */
+template <typename T>
+struct dynamic_vector : expr::dynamic_vector_expression<dynamic_vector<T>, T> {
+    using this_type        = dynamic_vector<T>;
+    using storage_type     = std::vector<T>;
+    using value_type       = T;
+    using lvalue_reference = typename storage_type::reference;
+    using const_reference  = typename storage_type::const_reference;
+    using pointer          = typename storage_type::pointer;
+    using const_pointer    = typename storage_type::const_pointer;
+    using iterator         = typename storage_type::iterator;
+    using const_iterator   = typename storage_type::const_iterator;
+    using init_list        = std::initializer_list<value_type>;
+
+    dynamic_vector() = default;
+    /**
+     * Construct a vector of the given size with all components set to the
+     * same value.
+     */
+    explicit dynamic_vector(std::size_t size, value_type v = value_type{0}) : data_(size, v) {}
+    dynamic_vector(init_list args) : data_(args) {}
+
+    template <typename Expression,
+              typename = math::traits::enable_if_dynamic_vector_expression<Expression>>
+    dynamic_vector(Expression&& rhs)
+    {
+        assign(std::forward<Expression>(rhs));
+    }
+    template <typename Expression, typename = math::traits::enable_if_vector_expression<Expression>,
+              typename = void>
+    explicit dynamic_vector(Expression const& rhs)
+        : dynamic_vector(rhs, typename std::decay_t<Expression>::index_sequence_type{})
+    {}
+
+    dynamic_vector(dynamic_vector const&) = default;
+    dynamic_vector(dynamic_vector&&)      = default;
+    dynamic_vector&
+    operator=(dynamic_vector const&)
+        = default;
+    dynamic_vector&
+    operator=(dynamic_vector&&)
+        = default;
+
+    template <typename Expression,
+              typename = math::traits::enable_if_dynamic_vector_expression<Expression>>
+    dynamic_vector&
+    operator=(Expression&& rhs)
+    {
+        assign(std::forward<Expression>(rhs));
+        return *this;
+    }
+
+    std::size_t
+    size() const
+    {
+        return data_.size();
+    }
+    bool
+    empty() const
+    {
+        return data_.empty();
+    }
+    void
+    resize(std::size_t size, value_type v = value_type{0})
+    {
+        data_.resize(size, v);
+    }
+
+    value_type
+    at(std::size_t idx) const
+    {
+        return data_[idx];
+    }
+
+    lvalue_reference operator[](std::size_t idx) { return data_[idx]; }
+    const_reference operator[](std::size_t idx) const { return data_[idx]; }
+
+    pointer
+    data()
+    {
+        return data_.data();
+    }
+    const_pointer
+    data() const
+    {
+        return data_.data();
+    }
+
+    iterator
+    begin()
+    {
+        return data_.begin();
+    }
+    const_iterator
+    begin() const
+    {
+        return data_.begin();
+    }
+    iterator
+    end()
+    {
+        return data_.end();
+    }
+    const_iterator
+    end() const
+    {
+        return data_.end();
+    }
+
+    template <typename Expression,
+              typename = math::traits::enable_if_dynamic_vector_expression<Expression>>
+    dynamic_vector&
+    operator+=(Expression const& rhs)
+    {
+        expr::dyn::detail::check_dynamic_size(size(), rhs.size());
+        if constexpr (expr::is_elementwise_v<Expression>) {
+            for (std::size_t i = 0; i < data_.size(); ++i) {
+                data_[i] += rhs.at(i);
+            }
+            return *this;
+        } else {
+            // The expression may read this vector at other positions
+            return *this += this_type{rhs};
+        }
+    }
+    template <typename Expression,
+              typename = math::traits::enable_if_dynamic_vector_expression<Expression>>
+    dynamic_vector&
+    operator-=(Expression const& rhs)
+    {
+        expr::dyn::detail::check_dynamic_size(size(), rhs.size());
+        if constexpr (expr::is_elementwise_v<Expression>) {
+            for (std::size_t i = 0; i < data_.size(); ++i) {
+                data_[i] -= rhs.at(i);
+            }
+            return *this;
+        } else {
+            // The expression may read this vector at other positions
+            return *this -= this_type{rhs};
+        }
+    }
+    dynamic_vector&
+    operator*=(value_type s)
+    {
+        for (auto& v : data_) {
+            v *= s;
+        }
+        return *this;
+    }
+    dynamic_vector&
+    operator/=(value_type s)
+    {
+        for (auto& v : data_) {
+            v /= s;
+        }
+        return *this;
+    }
+
+private:
+    template <typename Expression, std::size_t... Indexes>
+    dynamic_vector(Expression const& rhs, std::index_sequence<Indexes...>)
+        : data_{static_cast<value_type>(expr::get<Indexes>(rhs))...}
+    {}
+
+    template <typename Expression>
+    void
+    assign(Expression&& rhs)
+    {
+        if constexpr (std::is_same<std::decay_t<Expression>, this_type>::value) {
+            data_ = std::forward<Expression>(rhs).data_;
+        } else {
+            // Evaluate to a temporary, the expression may refer to this vector
+            auto const   n = rhs.size();
+            storage_type tmp(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                tmp[i] = rhs.at(i);
+            }
+            data_.swap(tmp);
+        }
+    }
+
+    storage_type data_;
+};
+
+}    // namespace math
+}    // namespace psst
+
+#endif /* PSST_MATH_DYNAMIC_VECTOR_HPP_ */
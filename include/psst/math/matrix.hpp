@@ -8,6 +8,7 @@
 #ifndef PSST_MATH_MATRIX_HPP_
 #define PSST_MATH_MATRIX_HPP_
 
+#include <psst/math/detail/alignment.hpp>
 #include <psst/math/detail/component_access.hpp>
 #include <psst/math/detail/matrix_expressions.hpp>
 #include <psst/math/vector.hpp>
@@ -17,25 +18,107 @@
 namespace psst {
 namespace math {
 
+/**
+ * A row of a column-major matrix, the elements are Stride values apart in
+ * the matrix storage. The view is a vector expression that refers to the
+ * matrix, a mutable view is assignable from a vector expression.
+ */
+template <typename T, std::size_t Size, std::size_t Stride, typename Components>
+struct matrix_row_view
+    : expr::vector_expression<matrix_row_view<T, Size, Stride, Components>,
+                              vector<std::remove_const_t<T>, Size, Components>> {
+    using this_type = matrix_row_view<T, Size, Stride, Components>;
+    using base_expression_type
+        = expr::vector_expression<this_type, vector<std::remove_const_t<T>, Size, Components>>;
+    using value_type          = typename base_expression_type::value_type;
+    using result_type         = typename base_expression_type::result_type;
+    using index_sequence_type = typename base_expression_type::index_sequence_type;
+    using reference           = T&;
+
+    static constexpr auto size = Size;
+
+    constexpr explicit matrix_row_view(T* p) : data_{p} {}
+    matrix_row_view(matrix_row_view const&) = default;
+
+    /**
+     * Assign the elements of the row, not the view
+     */
+    matrix_row_view const&
+    operator=(matrix_row_view const& rhs) const
+    {
+        return *this = result_type{rhs};
+    }
+    template <typename Expression, typename = math::traits::enable_if_vector_expression<Expression>>
+    matrix_row_view const&
+    operator=(Expression const& rhs) const
+    {
+        // The expression can refer to the same matrix, e.g. m[0] = m[1] * 2
+        result_type const tmp{rhs};
+        assign(tmp, index_sequence_type{});
+        return *this;
+    }
+
+    template <std::size_t N>
+    constexpr reference
+    at() const
+    {
+        static_assert(N < size, "Invalid component index in matrix row");
+        return data_[N * Stride];
+    }
+
+    constexpr reference operator[](std::size_t idx) const
+    {
+        assert(idx < size);
+        return data_[idx * Stride];
+    }
+
+private:
+    template <std::size_t... Indexes>
+    void
+    assign(result_type const& rhs, std::index_sequence<Indexes...>) const
+    {
+        ((at<Indexes>() = rhs.template at<Indexes>()), ...);
+    }
+
+private:
+    T* data_;
+};
+
+namespace traits {
+
+template <typename T, std::size_t Size, std::size_t Stride, typename Components>
+struct is_vector_handle<matrix_row_view<T, Size, Stride, Components>> : std::true_type {};
+
+}    // namespace traits
+
 /**
  * Matrix template.
+ *
+ * The matrix is stored as an array of rows or, for the column-major layout,
+ * as an array of columns. Element access, expressions and initializer lists
+ * are row-first in both layouts, data() and the constructors from a pointer
+ * use the storage order. A row of a column-major matrix is accessed with a
+ * matrix_row_view.
+ *
  * @tparam T type of value in a matrix cell
  * @tparam RC row count
  * @tparam CC column count;
+ * @tparam Layout layout::row_major or layout::col_major
  */
-template <typename T, std::size_t RC, std::size_t CC, typename Components>
-struct matrix : expr::matrix_expression<matrix<T, RC, CC, Components>> {    //,
-    // detail::component_names_t<RC, Components, matrix<T, RC, CC, Components, vector<T, CC,
-    // Components>>
-    // {
-
-    using this_type       = matrix<T, RC, CC, Components>;
-    using transposed_type = matrix<T, CC, RC, Components>;
+template <typename T, std::size_t RC, std::size_t CC, typename Components, typename Layout>
+struct matrix : expr::matrix_expression<matrix<T, RC, CC, Components, Layout>> {
+
+    using this_type       = matrix<T, RC, CC, Components, Layout>;
+    using transposed_type = matrix<T, CC, RC, Components, Layout>;
     using traits          = traits::matrix_traits<this_type>;
+    using layout_type     = Layout;
 
-    using row_type         = typename traits::row_type;
-    using row_indexes_type = typename traits::row_indexes_type;
-    using col_indexes_type = typename traits::col_indexes_type;
+    using row_type           = typename traits::row_type;
+    using col_type           = typename traits::col_type;
+    using major_type         = typename traits::major_type;
+    using row_indexes_type   = typename traits::row_indexes_type;
+    using col_indexes_type   = typename traits::col_indexes_type;
+    using major_indexes_type = typename traits::major_indexes_type;
 
     using value_type           = typename traits::value_type;
     using lvalue_reference     = typename traits::lvalue_reference;
@@ -44,17 +127,37 @@ struct matrix : expr::matrix_expression<matrix<T, RC, CC, Components>> {    //,
     using const_pointer        = typename traits::const_pointer;
     using iterator             = typename traits::iterator;
     using const_iterator       = typename traits::const_iterator;
-    using row_iterator         = row_type*;
-    using const_row_iterator   = row_type const*;
-    using lvalue_row_reference = std::add_lvalue_reference_t<row_type>;
-    using const_row_reference  = std::add_lvalue_reference_t<std::add_const_t<row_type>>;
+    using row_iterator         = major_type*;
+    using const_row_iterator   = major_type const*;
 
-    static constexpr std::size_t rows = traits::rows;
-    static constexpr std::size_t cols = traits::cols;
-    static constexpr std::size_t size = traits::size;
+    static constexpr std::size_t rows      = traits::rows;
+    static constexpr std::size_t cols      = traits::cols;
+    static constexpr std::size_t size      = traits::size;
+    static constexpr bool        col_major = traits::col_major;
+    /**
+     * Number of values between the starts of consecutive rows (columns for
+     * the column-major layout) in the storage, the vectors can be padded
+     */
+    static constexpr std::size_t major_stride = sizeof(major_type) / sizeof(value_type);
+    static_assert(sizeof(major_type) % sizeof(value_type) == 0,
+                  "Matrix rows must be a whole number of elements apart");
+
+    using row_view       = matrix_row_view<value_type, cols, major_stride, Components>;
+    using const_row_view = matrix_row_view<value_type const, cols, major_stride, Components>;
+    using lvalue_row_reference
+        = std::conditional_t<col_major, row_view, std::add_lvalue_reference_t<row_type>>;
+    using const_row_reference
+        = std::conditional_t<col_major, const_row_view,
+                             std::add_lvalue_reference_t<std::add_const_t<row_type>>>;
+    /**
+     * Alignment of the matrix storage
+     * @see alignment_policy
+     */
+    static constexpr std::size_t alignment
+        = utils::max_v<alignment_policy_v<this_type>, alignof(major_type)>;
 
-    using multi_dim_type       = value_type[cols];
-    using const_multi_dim_type = value_type const[cols];
+    using multi_dim_type       = value_type[major_type::size];
+    using const_multi_dim_type = value_type const[major_type::size];
     using multi_dim_ptr        = multi_dim_type*;
     using const_multi_dim_ptr  = const_multi_dim_type const*;
 
@@ -62,26 +165,45 @@ struct matrix : expr::matrix_expression<matrix<T, RC, CC, Components>> {    //,
 
     constexpr matrix() = default;
 
-    constexpr explicit matrix(value_type val) : matrix(val, col_indexes_type{}) {}
-
-    constexpr explicit matrix(const_pointer p) : matrix(p, row_indexes_type{}) {}
-
-    constexpr explicit matrix(const_multi_dim_ptr p) : matrix(p, row_indexes_type{}) {}
+    constexpr explicit matrix(value_type val) : matrix(val, major_indexes_type{}) {}
+    /**
+     * Construct from values in the storage order, rows for the row-major
+     * layout and columns for the column-major layout
+     */
+    constexpr explicit matrix(const_pointer p) : matrix(p, major_indexes_type{}) {}
 
-    constexpr matrix(init_list const& args) : matrix(args, row_indexes_type{}) {}
+    constexpr explicit matrix(const_multi_dim_ptr p) : matrix(p, major_indexes_type{}) {}
+    /**
+     * Construct from the rows, in both layouts
+     */
+    constexpr matrix(init_list const& args) : matrix(args, major_indexes_type{}) {}
 
-    template <typename Expression, typename = math::traits::enable_if_matrix_expression<Expression>>
+    template <typename Expression, typename = math::traits::enable_if_matrix_expression<Expression>,
+              typename
+              = std::enable_if_t<!expr::use_product_kernel_for_v<Expression, this_type>>>
     constexpr matrix(Expression&& rhs)
-        : matrix(std::forward<Expression>(rhs),
-                 utils::make_min_index_sequence<rows, expr::matrix_row_count_v<Expression>>{})
+        : matrix(std::forward<Expression>(rhs), expression_init_tag<Expression>{})
     {}
+    /**
+     * Large products are evaluated with the blocked multiply, 4x4 products
+     * with the SIMD kernels, if the matrix is of the size of the product
+     * @see expr::blocked_product_threshold
+     * @see expr::use_simd_product
+     */
+    template <typename Expression,
+              typename = std::enable_if_t<expr::use_product_kernel_for_v<Expression, this_type>>,
+              typename = void, typename = void>
+    matrix(Expression&& rhs)
+    {
+        expr::m::detail::product_kernel(rhs, *this);
+    }
 
-    pointer
+    constexpr pointer
     data()
     {
         return std::get<0>(data_).data();
     }
-    const_pointer
+    constexpr const_pointer
     data() const
     {
         return std::get<0>(data_).data();
@@ -92,7 +214,11 @@ struct matrix : expr::matrix_expression<matrix<T, RC, CC, Components>> {    //,
     at()
     {
         static_assert(R < rows, "Invalid matrix row index");
-        return std::get<R>(data_);
+        if constexpr (col_major) {
+            return row_view{data() + R};
+        } else {
+            return std::get<R>(data_);
+        }
     }
 
     template <std::size_t R>
@@ -100,22 +226,59 @@ struct matrix : expr::matrix_expression<matrix<T, RC, CC, Components>> {    //,
     at() const
     {
         static_assert(R < rows, "Invalid matrix row index");
-        return std::get<R>(data_);
+        if constexpr (col_major) {
+            return const_row_view{data() + R};
+        } else {
+            return std::get<R>(data_);
+        }
     }
 
     template <std::size_t R, std::size_t C>
     lvalue_reference
     element()
     {
+        static_assert(R < rows, "Invalid matrix row index");
         static_assert(C < cols, "Invalid matrix column index");
-        return at<R>().template at<C>();
+        if constexpr (col_major) {
+            return std::get<C>(data_).template at<R>();
+        } else {
+            return std::get<R>(data_).template at<C>();
+        }
     }
     template <std::size_t R, std::size_t C>
     const_reference
     element() const
     {
+        static_assert(R < rows, "Invalid matrix row index");
         static_assert(C < cols, "Invalid matrix column index");
-        return at<R>().template at<C>();
+        if constexpr (col_major) {
+            return std::get<C>(data_).template at<R>();
+        } else {
+            return std::get<R>(data_).template at<C>();
+        }
+    }
+    /**
+     * Runtime access to an element, e.g. in loops over large matrices
+     */
+    constexpr lvalue_reference
+    element(std::size_t r, std::size_t c)
+    {
+        assert(r < rows && c < cols);
+        if constexpr (col_major) {
+            return data_[c][r];
+        } else {
+            return data_[r][c];
+        }
+    }
+    constexpr const_reference
+    element(std::size_t r, std::size_t c) const
+    {
+        assert(r < rows && c < cols);
+        if constexpr (col_major) {
+            return data_[c][r];
+        } else {
+            return data_[r][c];
+        }
     }
 
     iterator
@@ -150,6 +313,10 @@ struct matrix : expr::matrix_expression<matrix<T, RC, CC, Components>> {    //,
         return data_.back().end();
     }
 
+    /**
+     * Iterators over the stored vectors, rows or columns depending on the
+     * layout
+     */
     row_iterator
     row_begin()
     {
@@ -172,52 +339,70 @@ struct matrix : expr::matrix_expression<matrix<T, RC, CC, Components>> {    //,
         return data_.end();
     }
 
-    lvalue_row_reference operator[](std::size_t idx)
+    constexpr lvalue_row_reference operator[](std::size_t idx)
     {
         assert(idx < rows);
-        return data_[idx];
+        if constexpr (col_major) {
+            return row_view{data() + idx};
+        } else {
+            return data_[idx];
+        }
     }
-    const_row_reference operator[](std::size_t idx) const
+    constexpr const_row_reference operator[](std::size_t idx) const
     {
         assert(idx < rows);
-        return data_[idx];
+        if constexpr (col_major) {
+            return const_row_view{data() + idx};
+        } else {
+            return data_[idx];
+        }
     }
 
-    // TODO Make it an expression
-    this_type
-    operator-()
+    /**
+     * Assign a matrix expression. An element-wise expression is written in
+     * place, other expressions are evaluated to a temporary first, as they
+     * can refer to this matrix, e.g. m = m * n.
+     *
+     * @see expr::is_elementwise
+     * @see noalias
+     */
+    template <typename Expression, typename = math::traits::enable_if_matrix_expression<Expression>>
+    this_type&
+    operator=(Expression const& rhs)
     {
-        this_type res(*this);
-        res *= -1;
-        return res;
+        return assign(rhs);
     }
 
-    template <typename U>
+    /**
+     * Compound assignments update the matrix in place when the right hand
+     * side is element-wise
+     */
+    template <typename Expression, typename = math::traits::enable_if_matrix_expression<Expression>>
     this_type&
-    operator+=(matrix<U, RC, CC, Components> const& rhs)
+    operator+=(Expression const& rhs)
     {
-        return *this = *this + rhs;
+        return assign(*this + rhs);
     }
 
-    template <typename U>
+    template <typename Expression, typename = math::traits::enable_if_matrix_expression<Expression>>
     this_type&
-    operator-=(matrix<U, RC, CC, Components> const& rhs)
+    operator-=(Expression const& rhs)
     {
-        return *this = *this - rhs;
+        return assign(*this - rhs);
     }
 
     template <typename U>
     this_type&
     operator*=(U s)
     {
-        return *this = *this * s;
+        return assign(*this * s);
     }
 
     template <typename U>
     this_type&
     operator/=(U s)
     {
-        return *this = *this / s;
+        return assign(*this / s);
     }
 
     transposed_type
@@ -236,45 +421,152 @@ struct matrix : expr::matrix_expression<matrix<T, RC, CC, Components>> {    //,
     operator const_pointer() const { return data(); }
 
     template <typename U = T>
-    constexpr static typename std::enable_if<RC == CC, matrix<U, RC, CC, Components>>::type
+    constexpr static typename std::enable_if<RC == CC, matrix<U, RC, CC, Components, Layout>>::type
     identity()
     {
         return expr::identity<this_type>();
     }
 
 private:
-    template <std::size_t... RI>
-    constexpr matrix(value_type val, std::index_sequence<RI...>)
-        : data_({utils::value_fill<RI, row_type>{row_type(val)}.value...})
+    template <typename Expression>
+    this_type&
+    assign(Expression const& rhs)
+    {
+        if constexpr (expr::is_elementwise_v<Expression>) {
+            expr::m::detail::assign_elements(*this, rhs);
+        } else {
+            *this = this_type{rhs};
+        }
+        return *this;
+    }
+
+    template <typename Expression>
+    using expression_major_indexes = utils::make_min_index_sequence<
+        traits::major_count,
+        (col_major ? std::decay_t<Expression>::cols : std::decay_t<Expression>::rows)>;
+    /**
+     * Large matrices without component value policies are initialized from
+     * an expression of the same size in a loop
+     * @see expr::unroll_threshold
+     */
+    template <typename Expression>
+    using expression_init_tag = std::conditional_t<
+        expr::matrix_loop_evaluable_v<Expression> && std::decay_t<Expression>::rows == rows
+            && std::decay_t<Expression>::cols == cols
+            && expr::v::detail::simd_plain_components_v<T, Components>,
+        expr::loop_evaluation_tag, expression_major_indexes<Expression>>;
+
+    template <std::size_t... MI>
+    constexpr matrix(value_type val, std::index_sequence<MI...>)
+        : data_({utils::value_fill<MI, major_type>{major_type(val)}.value...})
     {}
-    template <std::size_t... RI>
-    constexpr matrix(init_list const& args, std::index_sequence<RI...>)
-        : data_({row_type(*(args.begin() + RI))...})
+    template <std::size_t... MI>
+    constexpr matrix(init_list const& args, std::index_sequence<MI...>)
+        : data_({init_major<MI>(args)...})
     {}
-    template <std::size_t... RI>
-    constexpr matrix(const_pointer p, std::index_sequence<RI...>)
-        : data_({row_type(p + RI * cols)...})
+    template <std::size_t... MI>
+    constexpr matrix(const_pointer p, std::index_sequence<MI...>)
+        : data_({major_type(p + MI * major_type::size)...})
     {}
-    template <std::size_t... RI>
-    constexpr matrix(const_multi_dim_ptr p, std::index_sequence<RI...>)
-        : data_({row_type(p[RI])...})
+    template <std::size_t... MI>
+    constexpr matrix(const_multi_dim_ptr p, std::index_sequence<MI...>)
+        : data_({major_type(p[MI])...})
     {}
-    template <typename Expr, std::size_t... RI>
-    constexpr matrix(Expr&& rhs, std::index_sequence<RI...>) : data_({expr::row<RI>(rhs)...})
+    template <typename Expr, std::size_t... MI>
+    constexpr matrix(Expr&& rhs, std::index_sequence<MI...>) : data_({expr_major<MI>(rhs)...})
     {}
+    template <typename Expr>
+    constexpr matrix(Expr const& rhs, expr::loop_evaluation_tag) : data_{}
+    {
+        expr::m::detail::assign_elements(*this, rhs);
+    }
+
+    template <std::size_t M>
+    static constexpr major_type
+    init_major(init_list const& args)
+    {
+        if constexpr (col_major) {
+            return init_col<M>(args, row_indexes_type{});
+        } else {
+            return major_type(*(args.begin() + M));
+        }
+    }
+    template <std::size_t C, std::size_t... RI>
+    static constexpr major_type
+    init_col(init_list const& args, std::index_sequence<RI...>)
+    {
+        return major_type{*((args.begin() + RI)->begin() + C)...};
+    }
+    template <std::size_t M, typename Expr>
+    static constexpr major_type
+    expr_major(Expr const& rhs)
+    {
+        if constexpr (col_major) {
+            return major_type(expr::col<M>(rhs));
+        } else {
+            return major_type(expr::row<M>(rhs));
+        }
+    }
 
 private:
-    using data_type = std::array<row_type, rows>;
-    data_type data_;
+    using data_type = std::array<major_type, traits::major_count>;
+    alignas(alignment) data_type data_;
 };
 
-template <std::size_t R, typename T, std::size_t RC, std::size_t CC, typename Components>
-constexpr auto&
-get(matrix<T, RC, CC, Components>& mtx)
+template <std::size_t R, typename T, std::size_t RC, std::size_t CC, typename Components,
+          typename Layout>
+constexpr decltype(auto)
+get(matrix<T, RC, CC, Components, Layout>& mtx)
 {
     return mtx.template at<R>();
 }
 
+/**
+ * Assignment to a matrix that is not referenced by the assigned expression.
+ * The expression is evaluated directly to the matrix without a temporary,
+ * e.g. noalias(m) = a * b or noalias(m) += a * b.
+ *
+ * The result is undefined if the expression refers to the matrix and is not
+ * element-wise, e.g. noalias(m) = m * n.
+ */
+template <typename Matrix>
+struct noalias_matrix {
+    template <typename Expression, typename = traits::enable_if_matrix_expression<Expression>>
+    Matrix&
+    operator=(Expression const& rhs) const
+    {
+        if constexpr (expr::use_product_kernel_for_v<Expression, Matrix>) {
+            expr::m::detail::product_kernel(rhs, m);
+        } else {
+            expr::m::detail::assign_elements(m, rhs);
+        }
+        return m;
+    }
+    template <typename Expression, typename = traits::enable_if_matrix_expression<Expression>>
+    Matrix&
+    operator+=(Expression const& rhs) const
+    {
+        expr::m::detail::assign_elements(m, m + rhs);
+        return m;
+    }
+    template <typename Expression, typename = traits::enable_if_matrix_expression<Expression>>
+    Matrix&
+    operator-=(Expression const& rhs) const
+    {
+        expr::m::detail::assign_elements(m, m - rhs);
+        return m;
+    }
+
+    Matrix& m;
+};
+
+template <typename T, std::size_t RC, std::size_t CC, typename Components, typename Layout>
+noalias_matrix<matrix<T, RC, CC, Components, Layout>>
+noalias(matrix<T, RC, CC, Components, Layout>& m)
+{
+    return {m};
+}
+
 }    // namespace math
 } /* namespace psst */
 
@@ -0,0 +1,591 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * matrix_decomposition.hpp
+ *
+ *  Created on: Feb 6, 2019
+ *      Author: ser-fedorov
+ */
+
+#ifndef PSST_MATH_MATRIX_DECOMPOSITION_HPP_
+#define PSST_MATH_MATRIX_DECOMPOSITION_HPP_
+
+#include <psst/math/matrix.hpp>
+#include <psst/math/vector.hpp>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace psst {
+namespace math {
+
+namespace detail {
+
+/**
+ * Evaluate a right hand side of a linear system, a vector or a matrix
+ * expression, to a value.
+ */
+template <typename Expr>
+constexpr auto
+eval_rhs(Expr&& expr)
+{
+    using expression_type = std::decay_t<Expr>;
+    if constexpr (traits::is_vector_expression_v<expression_type>) {
+        return typename expression_type::result_type{std::forward<Expr>(expr)};
+    } else {
+        static_assert(traits::is_matrix_expression_v<expression_type>,
+                      "Right hand side must be a vector or a matrix expression");
+        return typename expression_type::matrix_type{std::forward<Expr>(expr)};
+    }
+}
+
+/**
+ * Number of right hand side rows and columns, a vector is a single column
+ */
+template <typename RHS>
+struct rhs_shape {
+    static constexpr std::size_t rows = RHS::rows;
+    static constexpr std::size_t cols = RHS::cols;
+};
+
+template <typename T, std::size_t Size, typename Components>
+struct rhs_shape<vector<T, Size, Components>> {
+    static constexpr std::size_t rows = Size;
+    static constexpr std::size_t cols = 1;
+};
+
+template <typename RHS>
+constexpr std::size_t rhs_rows_v = rhs_shape<RHS>::rows;
+template <typename RHS>
+constexpr std::size_t rhs_cols_v = rhs_shape<RHS>::cols;
+
+template <typename RHS>
+constexpr decltype(auto)
+rhs_element(RHS& rhs, std::size_t r, std::size_t c)
+{
+    if constexpr (traits::is_vector_v<RHS>) {
+        return rhs[r];
+    } else {
+        return rhs[r][c];
+    }
+}
+
+}    // namespace detail
+
+/**
+ * LU decomposition with partial pivoting of a square matrix, P * A = L * U.
+ *
+ * L is unit lower triangular and U is upper triangular, both are stored in
+ * a single matrix. The pivots are selected relative to the maximums of the
+ * rows. A pivot within n * epsilon of the maximum of its row makes the
+ * matrix singular, it is decomposed as well, so that the factors still
+ * satisfy P * A = L * U, but the determinant is zero and solving throws.
+ * A matrix with a NaN or an infinite element is singular as well, as in the
+ * batched solve. The decomposition of a row-major matrix can be a constant expression.
+ */
+template <typename Matrix>
+class lu_decomposition {
+public:
+    using matrix_type = Matrix;
+    using value_type  = typename matrix_type::value_type;
+
+    static constexpr std::size_t size = matrix_type::rows;
+    static_assert(matrix_type::rows == matrix_type::cols,
+                  "LU decomposition is defined only for square matrices");
+    static_assert(std::is_floating_point_v<value_type>,
+                  "LU decomposition is defined only for floating point matrices");
+
+    using permutation_type = std::array<std::size_t, size>;
+
+    template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
+    constexpr explicit lu_decomposition(Expr&& expr) : lu_{std::forward<Expr>(expr)}
+    {
+        auto scales = expr::m::detail::row_scales(lu_);
+        for (std::size_t i = 0; i < size; ++i) {
+            perm_[i] = i;
+            for (std::size_t c = 0; c < size; ++c) {
+                // False for NaN and infinity
+                if (!(utils::abs_value(lu_[i][c]) <= std::numeric_limits<value_type>::max()))
+                    singular_ = true;
+            }
+        }
+        for (std::size_t k = 0; k < size; ++k) {
+            auto const pivot = expr::m::detail::pivot_row(lu_, scales, k);
+            if (expr::m::detail::negligible_pivot(lu_[pivot][k], scales[pivot], size)) {
+                // The step is still completed with the selected pivot, so
+                // that the factors of a singular matrix satisfy P * A = L * U
+                singular_ = true;
+                if (lu_[pivot][k] == value_type{0})
+                    continue;    // The column is zero from row k down
+            }
+            if (pivot != k) {
+                expr::m::detail::swap_rows(lu_, k, pivot);
+                expr::m::detail::swap_elements(scales, k, pivot);
+                expr::m::detail::swap_elements(perm_, k, pivot);
+                sign_ = -sign_;
+            }
+            auto const inv = value_type{1} / lu_[k][k];
+            for (std::size_t r = k + 1; r < size; ++r) {
+                auto const f = lu_[r][k] *= inv;
+                if (f == value_type{0})
+                    continue;
+                for (std::size_t c = k + 1; c < size; ++c) {
+                    lu_[r][c] -= f * lu_[k][c];
+                }
+            }
+        }
+    }
+
+    constexpr bool
+    singular() const
+    {
+        return singular_;
+    }
+
+    /**
+     * Combined L and U factors, the unit diagonal of L is not stored
+     */
+    constexpr matrix_type const&
+    factors() const
+    {
+        return lu_;
+    }
+
+    /**
+     * Row permutation, row i of P * A is row permutation()[i] of A
+     */
+    constexpr permutation_type const&
+    permutation() const
+    {
+        return perm_;
+    }
+
+    constexpr matrix_type
+    lower() const
+    {
+        matrix_type res;
+        for (std::size_t r = 0; r < size; ++r) {
+            for (std::size_t c = 0; c < r; ++c) {
+                res[r][c] = lu_[r][c];
+            }
+            res[r][r] = value_type{1};
+        }
+        return res;
+    }
+
+    constexpr matrix_type
+    upper() const
+    {
+        matrix_type res;
+        for (std::size_t r = 0; r < size; ++r) {
+            for (std::size_t c = r; c < size; ++c) {
+                res[r][c] = lu_[r][c];
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Permutation matrix P
+     */
+    constexpr matrix_type
+    p() const
+    {
+        matrix_type res;
+        for (std::size_t r = 0; r < size; ++r) {
+            res[r][perm_[r]] = value_type{1};
+        }
+        return res;
+    }
+
+    constexpr value_type
+    determinant() const
+    {
+        if (singular_)
+            return value_type{0};
+        value_type res{sign_};
+        for (std::size_t i = 0; i < size; ++i) {
+            res *= lu_[i][i];
+        }
+        return res;
+    }
+
+    /**
+     * Solve A * x = b, b is a vector or a matrix with a column per system
+     * @throws std::runtime_error if the matrix is singular
+     */
+    template <typename Expr>
+    constexpr auto
+    solve(Expr&& b) const
+    {
+        auto const rhs    = detail::eval_rhs(std::forward<Expr>(b));
+        using result_type = std::decay_t<decltype(rhs)>;
+        static_assert(detail::rhs_rows_v<result_type> == size,
+                      "Right hand side must have the same number of rows as the matrix");
+        if (singular_)
+            throw std::runtime_error("Cannot solve a system with a singular matrix");
+
+        result_type x;
+        for (std::size_t c = 0; c < detail::rhs_cols_v<result_type>; ++c) {
+            // Forward substitution with the unit lower triangular factor
+            for (std::size_t r = 0; r < size; ++r) {
+                auto v = detail::rhs_element(rhs, perm_[r], c);
+                for (std::size_t k = 0; k < r; ++k) {
+                    v -= lu_[r][k] * detail::rhs_element(x, k, c);
+                }
+                detail::rhs_element(x, r, c) = v;
+            }
+            // Back substitution with the upper triangular factor
+            for (std::size_t r = size; r-- > 0;) {
+                auto v = detail::rhs_element(x, r, c);
+                for (std::size_t k = r + 1; k < size; ++k) {
+                    v -= lu_[r][k] * detail::rhs_element(x, k, c);
+                }
+                detail::rhs_element(x, r, c) = v / lu_[r][r];
+            }
+        }
+        return x;
+    }
+
+    /**
+     * @throws std::runtime_error if the matrix is singular
+     */
+    constexpr matrix_type
+    inverse() const
+    {
+        return solve(matrix_type::identity());
+    }
+
+private:
+    matrix_type      lu_;
+    permutation_type perm_{};
+    value_type       sign_     = value_type{1};
+    bool             singular_ = false;
+};
+
+template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
+lu_decomposition(Expr&&)->lu_decomposition<typename std::decay_t<Expr>::matrix_type>;
+
+/**
+ * Householder QR decomposition of a matrix with at least as many rows as
+ * columns, A = Q * R.
+ *
+ * The Householder vectors are stored below the diagonal of the factored
+ * matrix, the diagonal of R is stored separately. Q and R are built on
+ * request. Solving a system with more rows than columns gives the least
+ * squares solution. A diagonal element of R within n * epsilon of the norm
+ * of the same column of A makes the matrix rank deficient.
+ */
+template <typename Matrix>
+class qr_decomposition {
+public:
+    using matrix_type = Matrix;
+    using value_type  = typename matrix_type::value_type;
+
+    static constexpr std::size_t rows = matrix_type::rows;
+    static constexpr std::size_t cols = matrix_type::cols;
+    static_assert(rows >= cols, "QR decomposition requires at least as many rows as columns");
+    static_assert(std::is_floating_point_v<value_type>,
+                  "QR decomposition is defined only for floating point matrices");
+
+    using q_type = matrix<value_type, rows, rows>;
+    using r_type = matrix<value_type, rows, cols>;
+
+    template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
+    explicit qr_decomposition(Expr&& expr)
+        : qr_{std::forward<Expr>(expr)}
+    {
+        constexpr auto factor = expr::m::detail::singular_tolerance_factor<value_type>(rows);
+        for (std::size_t c = 0; c < cols; ++c) {
+            value_type norm{0};
+            for (std::size_t r = 0; r < rows; ++r) {
+                norm += qr_[r][c] * qr_[r][c];
+            }
+            tolerance_[c] = factor * std::sqrt(norm);
+        }
+        for (std::size_t k = 0; k < cols; ++k) {
+            value_type norm{0};
+            for (std::size_t r = k; r < rows; ++r) {
+                norm += qr_[r][k] * qr_[r][k];
+            }
+            norm = std::sqrt(norm);
+            if (!negligible(norm, k)) {
+                if (qr_[k][k] < value_type{0})
+                    norm = -norm;
+                for (std::size_t r = k; r < rows; ++r) {
+                    qr_[r][k] /= norm;
+                }
+                qr_[k][k] += value_type{1};
+                for (std::size_t c = k + 1; c < cols; ++c) {
+                    value_type s{0};
+                    for (std::size_t r = k; r < rows; ++r) {
+                        s += qr_[r][k] * qr_[r][c];
+                    }
+                    s = -s / qr_[k][k];
+                    for (std::size_t r = k; r < rows; ++r) {
+                        qr_[r][c] += s * qr_[r][k];
+                    }
+                }
+                rdiag_[k] = -norm;
+            } else {
+                // Rank deficient, the column is left without a reflection
+                rdiag_[k] = qr_[k][k];
+            }
+        }
+    }
+
+    bool
+    full_rank() const
+    {
+        for (std::size_t i = 0; i < cols; ++i) {
+            if (negligible(rdiag_[i], i))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * Orthogonal factor
+     */
+    q_type
+    q() const
+    {
+        q_type res = q_type::identity();
+        for (std::size_t k = cols; k-- > 0;) {
+            if (negligible(rdiag_[k], k))
+                continue;
+            for (std::size_t c = k; c < rows; ++c) {
+                value_type s{0};
+                for (std::size_t r = k; r < rows; ++r) {
+                    s += qr_[r][k] * res[r][c];
+                }
+                s = -s / qr_[k][k];
+                for (std::size_t r = k; r < rows; ++r) {
+                    res[r][c] += s * qr_[r][k];
+                }
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Upper triangular factor
+     */
+    r_type
+    r() const
+    {
+        r_type res;
+        for (std::size_t r = 0; r < cols; ++r) {
+            res[r][r] = rdiag_[r];
+            for (std::size_t c = r + 1; c < cols; ++c) {
+                res[r][c] = qr_[r][c];
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Solve A * x = b in the least squares sense, b is a vector or a matrix
+     * with a column per system.
+     * @throws std::runtime_error if the matrix is rank deficient
+     */
+    template <typename Expr>
+    auto
+    solve(Expr&& b) const
+    {
+        auto rhs          = detail::eval_rhs(std::forward<Expr>(b));
+        using rhs_type    = std::decay_t<decltype(rhs)>;
+        using result_type = std::conditional_t<
+            traits::is_vector_v<rhs_type>, vector<value_type, cols>,
+            matrix<value_type, cols, detail::rhs_cols_v<rhs_type>>>;
+        static_assert(detail::rhs_rows_v<rhs_type> == rows,
+                      "Right hand side must have the same number of rows as the matrix");
+        if (!full_rank())
+            throw std::runtime_error("Cannot solve a system with a rank deficient matrix");
+
+        result_type x;
+        for (std::size_t c = 0; c < detail::rhs_cols_v<rhs_type>; ++c) {
+            // Apply the Householder reflections, Q^T * b
+            for (std::size_t k = 0; k < cols; ++k) {
+                value_type s{0};
+                for (std::size_t r = k; r < rows; ++r) {
+                    s += qr_[r][k] * detail::rhs_element(rhs, r, c);
+                }
+                s = -s / qr_[k][k];
+                for (std::size_t r = k; r < rows; ++r) {
+                    detail::rhs_element(rhs, r, c) += s * qr_[r][k];
+                }
+            }
+            // Back substitution with R
+            for (std::size_t r = cols; r-- > 0;) {
+                auto v = detail::rhs_element(rhs, r, c);
+                for (std::size_t k = r + 1; k < cols; ++k) {
+                    v -= qr_[r][k] * detail::rhs_element(x, k, c);
+                }
+                detail::rhs_element(x, r, c) = v / rdiag_[r];
+            }
+        }
+        return x;
+    }
+
+private:
+    bool
+    negligible(value_type v, std::size_t col) const
+    {
+        return std::abs(v) <= tolerance_[col];
+    }
+
+    matrix_type                  qr_;
+    std::array<value_type, cols> tolerance_{};
+    std::array<value_type, cols> rdiag_{};
+};
+
+template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
+qr_decomposition(Expr&&)->qr_decomposition<typename std::decay_t<Expr>::matrix_type>;
+
+/**
+ * Cholesky decomposition of a symmetric positive definite matrix,
+ * A = L * L^T.
+ *
+ * Only the lower triangle of the matrix is read. A pivot within
+ * n * epsilon of the diagonal element of the matrix makes it not positive
+ * definite, e.g. a numerically semidefinite matrix. If the matrix is not
+ * positive definite the decomposition stops and solving throws.
+ */
+template <typename Matrix>
+class cholesky_decomposition {
+public:
+    using matrix_type = Matrix;
+    using value_type  = typename matrix_type::value_type;
+
+    static constexpr std::size_t size = matrix_type::rows;
+    static_assert(matrix_type::rows == matrix_type::cols,
+                  "Cholesky decomposition is defined only for square matrices");
+    static_assert(std::is_floating_point_v<value_type>,
+                  "Cholesky decomposition is defined only for floating point matrices");
+
+    template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
+    explicit cholesky_decomposition(Expr&& expr)
+    {
+        constexpr auto factor = expr::m::detail::singular_tolerance_factor<value_type>(size);
+        matrix_type const a{std::forward<Expr>(expr)};
+        for (std::size_t c = 0; c < size; ++c) {
+            auto d = a[c][c];
+            for (std::size_t k = 0; k < c; ++k) {
+                d -= l_[c][k] * l_[c][k];
+            }
+            if (!(d > factor * std::abs(a[c][c]))) {
+                positive_definite_ = false;
+                det_               = symmetric_determinant(a);
+                return;
+            }
+            auto const l_cc = std::sqrt(d);
+            l_[c][c]        = l_cc;
+            for (std::size_t r = c + 1; r < size; ++r) {
+                auto v = a[r][c];
+                for (std::size_t k = 0; k < c; ++k) {
+                    v -= l_[r][k] * l_[c][k];
+                }
+                l_[r][c] = v / l_cc;
+            }
+        }
+    }
+
+    bool
+    positive_definite() const
+    {
+        return positive_definite_;
+    }
+
+    /**
+     * Lower triangular factor
+     */
+    matrix_type const&
+    lower() const
+    {
+        return l_;
+    }
+
+    /**
+     * Determinant of the symmetric matrix. If the matrix is not positive
+     * definite, the determinant is computed by an LU decomposition, it is
+     * zero for a singular matrix as lu_decomposition::determinant() is.
+     */
+    value_type
+    determinant() const
+    {
+        if (!positive_definite_)
+            return det_;
+        value_type res{1};
+        for (std::size_t i = 0; i < size; ++i) {
+            res *= l_[i][i];
+        }
+        return res * res;
+    }
+
+    /**
+     * Solve A * x = b, b is a vector or a matrix with a column per system
+     * @throws std::runtime_error if the matrix is not positive definite
+     */
+    template <typename Expr>
+    auto
+    solve(Expr&& b) const
+    {
+        auto x         = detail::eval_rhs(std::forward<Expr>(b));
+        using rhs_type = std::decay_t<decltype(x)>;
+        static_assert(detail::rhs_rows_v<rhs_type> == size,
+                      "Right hand side must have the same number of rows as the matrix");
+        if (!positive_definite_)
+            throw std::runtime_error("Matrix is not positive definite");
+
+        for (std::size_t c = 0; c < detail::rhs_cols_v<rhs_type>; ++c) {
+            // L * y = b
+            for (std::size_t r = 0; r < size; ++r) {
+                auto v = detail::rhs_element(x, r, c);
+                for (std::size_t k = 0; k < r; ++k) {
+                    v -= l_[r][k] * detail::rhs_element(x, k, c);
+                }
+                detail::rhs_element(x, r, c) = v / l_[r][r];
+            }
+            // L^T * x = y
+            for (std::size_t r = size; r-- > 0;) {
+                auto v = detail::rhs_element(x, r, c);
+                for (std::size_t k = r + 1; k < size; ++k) {
+                    v -= l_[k][r] * detail::rhs_element(x, k, c);
+                }
+                detail::rhs_element(x, r, c) = v / l_[r][r];
+            }
+        }
+        return x;
+    }
+
+private:
+    /**
+     * Determinant of the symmetric matrix with the lower triangle of a
+     */
+    static value_type
+    symmetric_determinant(matrix_type const& a)
+    {
+        matrix_type full;
+        for (std::size_t r = 0; r < size; ++r) {
+            for (std::size_t c = 0; c < size; ++c) {
+                full[r][c] = c <= r ? a[r][c] : a[c][r];
+            }
+        }
+        return lu_decomposition<matrix_type>{full}.determinant();
+    }
+
+    matrix_type l_;
+    value_type  det_{0};
+    bool        positive_definite_ = true;
+};
+
+template <typename Expr, typename = traits::enable_if_matrix_expression<Expr>>
+cholesky_decomposition(Expr&&)->cholesky_decomposition<typename std::decay_t<Expr>::matrix_type>;
+
+}    // namespace math
+}    // namespace psst
+
+#endif /* PSST_MATH_MATRIX_DECOMPOSITION_HPP_ */
@@ -13,10 +13,38 @@
 namespace psst {
 namespace math {
 
+/**
+ * Storage layout policies of a matrix
+ */
+namespace layout {
+
+/**
+ * Rows are stored one after another, the default
+ */
+struct row_major {};
+/**
+ * Columns are stored one after another, e.g. for graphics APIs that consume
+ * column-major matrices
+ */
+struct col_major {};
+
+}    // namespace layout
+
 template <typename T, size_t RC, size_t CC,
-          typename Components = components::default_components_t<(CC > RC) ? CC : RC>>
+          typename Components = components::default_components_t<(CC > RC) ? CC : RC>,
+          typename Layout     = layout::row_major>
 struct matrix;
 
+/**
+ * Matrix stored by columns
+ */
+template <typename T, size_t RC, size_t CC,
+          typename Components = components::default_components_t<(CC > RC) ? CC : RC>>
+using col_major_matrix = matrix<T, RC, CC, Components, layout::col_major>;
+
+template <typename T>
+struct dynamic_matrix;
+
 } /* namespace math */
 } /* namespace psst */
 
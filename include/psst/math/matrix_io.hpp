@@ -58,7 +58,8 @@ private:
 
 }    // namespace detail
 
-template <typename Expression, typename Result>
+template <typename Expression, typename Result,
+          typename = std::enable_if_t<traits::is_matrix_v<Result>>>
 std::ostream&
 operator<<(std::ostream& os, matrix_expression<Expression, Result> const& m)
 {
@@ -136,6 +137,21 @@ operator>>(std::istream& is, matrix<T, RC, CC, Components>& mtx)
     return is;
 }
 
+/**
+ * Columns of a column-major matrix are not stored as rows, the matrix is
+ * read to a row-major matrix first
+ */
+template <typename T, std::size_t RC, std::size_t CC, typename Components>
+std::istream&
+operator>>(std::istream& is, col_major_matrix<T, RC, CC, Components>& mtx)
+{
+    matrix<T, RC, CC, Components> tmp;
+    if (is >> tmp) {
+        mtx = tmp;
+    }
+    return is;
+}
+
 }    // namespace math
 } /* namespace psst */
 
@@ -0,0 +1,282 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * matrix_solve.hpp
+ *
+ *  Created on: Feb 7, 2019
+ *      Author: ser-fedorov
+ */
+
+#ifndef PSST_MATH_MATRIX_SOLVE_HPP_
+#define PSST_MATH_MATRIX_SOLVE_HPP_
+
+#include <psst/math/matrix_decomposition.hpp>
+#include <psst/math/vector_transform.hpp>
+#include <psst/math/vector_view.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace psst {
+namespace math {
+
+namespace detail {
+
+/**
+ * A block of up to Lanes systems up to 4x4 solved by Gaussian elimination
+ * with partial pivoting.
+ *
+ * The systems are copied to lane-interleaved arrays, a[r][c][lane]. Each
+ * lane selects its own pivot rows, the rows are swapped by selecting the
+ * values instead of branching, so the loops over the lanes have no branches
+ * and no dependencies between the lanes and the compiler can vectorize them
+ * across the systems. As in the LU decomposition the pivots are selected
+ * relative to the maximums of the rows, and a pivot within n * epsilon of
+ * the maximum of its row makes the matrix singular. The arrays are members
+ * of one object, so the compiler knows they don't alias.
+ */
+template <typename T, std::size_t N, std::size_t Lanes>
+struct elimination_solve_block {
+    static_assert(N > 0 && N <= 4, "Block elimination is used for sizes up to 4x4");
+
+    /**
+     * The lanes after the last system of an incomplete block are identity
+     * matrices, so that they are eliminated without dividing by zero
+     */
+    template <typename Matrix>
+    void
+    load(Matrix const* m, T const* rhs, std::size_t lanes)
+    {
+        for (std::size_t l = 0; l < lanes; ++l) {
+            for (std::size_t r = 0; r < N; ++r) {
+                for (std::size_t c = 0; c < N; ++c) {
+                    a[r][c][l] = m[l][r][c];
+                }
+                b[r][l] = rhs[l * N + r];
+            }
+        }
+        for (std::size_t l = lanes; l < Lanes; ++l) {
+            for (std::size_t r = 0; r < N; ++r) {
+                for (std::size_t c = 0; c < N; ++c) {
+                    a[r][c][l] = r == c ? T{1} : T{0};
+                }
+                b[r][l] = T{0};
+            }
+        }
+    }
+
+    /**
+     * @throws std::runtime_error if one of the first lanes matrices is
+     *         numerically singular
+     */
+    void
+    solve(std::size_t lanes)
+    {
+        for (std::size_t l = 0; l < Lanes; ++l) {
+            for (std::size_t r = 0; r < N; ++r) {
+                scale[r][l] = std::abs(a[r][0][l]);
+                for (std::size_t c = 1; c < N; ++c) {
+                    scale[r][l] = std::max(scale[r][l], std::abs(a[r][c][l]));
+                }
+            }
+            margin[l] = std::numeric_limits<T>::max();
+        }
+        eliminate(std::make_index_sequence<N>{});
+        if (std::any_of(margin, margin + lanes, [](T v) { return !(v > T{0}); }))
+            throw std::runtime_error("Cannot solve a system with a singular matrix");
+        back_substitute(std::make_index_sequence<N>{});
+    }
+
+    void
+    store(T* res, std::size_t lanes) const
+    {
+        for (std::size_t l = 0; l < lanes; ++l) {
+            for (std::size_t r = 0; r < N; ++r) {
+                res[l * N + r] = x[r][l];
+            }
+        }
+    }
+
+    T a[N][N][Lanes]{};
+    T b[N][Lanes]{};
+    T x[N][Lanes];
+
+private:
+    template <std::size_t... K>
+    void
+    eliminate(std::index_sequence<K...>)
+    {
+        (eliminate_col<K>(), ...);
+    }
+
+    /**
+     * Select the pivot row for column K in each lane and eliminate the
+     * column from the rows below it. The loops over the lanes are outermost
+     * and contain only loops over the rows and columns with constant bounds,
+     * that are unrolled, so the compiler vectorizes them across the lanes.
+     */
+    template <std::size_t K>
+    void
+    eliminate_col()
+    {
+        constexpr auto factor = expr::m::detail::singular_tolerance_factor<T>(N);
+        for (std::size_t l = 0; l < Lanes; ++l) {
+            for (std::size_t r = K + 1; r < N; ++r) {
+                // |v| / scale_r > |pivot| / scale_k without the division
+                auto const pivot = std::abs(a[K][K][l]);
+                auto const v     = std::abs(a[r][K][l]);
+                bool const swap
+                    = v * scale[K][l] > pivot * scale[r][l] || (pivot == T{0} && v > T{0});
+                for (std::size_t c = K; c < N; ++c) {
+                    select_swap(a[K][c][l], a[r][c][l], swap);
+                }
+                select_swap(b[K][l], b[r][l], swap);
+                select_swap(scale[K][l], scale[r][l], swap);
+            }
+        }
+        for (std::size_t l = 0; l < Lanes; ++l) {
+            // The pivot is negligible if the margin is not positive. A NaN
+            // margin, e.g. of a matrix with NaN or infinite elements, is
+            // kept, std::min would drop it.
+            auto const m = std::abs(a[K][K][l]) - factor * scale[K][l];
+            margin[l]    = m > margin[l] ? margin[l] : m;
+            d[K][l]   = T{1} / a[K][K][l];
+        }
+        for (std::size_t l = 0; l < Lanes; ++l) {
+            for (std::size_t r = K + 1; r < N; ++r) {
+                auto const f = a[r][K][l] * d[K][l];
+                for (std::size_t c = K + 1; c < N; ++c) {
+                    a[r][c][l] -= f * a[K][c][l];
+                }
+                b[r][l] -= f * b[K][l];
+            }
+        }
+    }
+
+    template <std::size_t... R>
+    void
+    back_substitute(std::index_sequence<R...>)
+    {
+        (back_substitute_row<N - 1 - R>(), ...);
+    }
+
+    template <std::size_t R>
+    void
+    back_substitute_row()
+    {
+        for (std::size_t l = 0; l < Lanes; ++l) {
+            auto v = b[R][l];
+            for (std::size_t c = R + 1; c < N; ++c) {
+                v -= a[R][c][l] * x[c][l];
+            }
+            x[R][l] = v * d[R][l];
+        }
+    }
+
+    static void
+    select_swap(T& p, T& q, bool swap)
+    {
+        auto const u = p;
+        auto const v = q;
+        p            = swap ? v : u;
+        q            = swap ? u : v;
+    }
+
+    T scale[N][Lanes];
+    T d[N][Lanes];
+    T margin[Lanes];
+};
+
+/**
+ * Number of systems in a block of the batched solve. A few vector registers
+ * wide, so that the scalar stores copying the systems to the block retire
+ * before the vectorized loops load them.
+ */
+constexpr std::size_t solve_batch_block_size = 16;
+
+}    // namespace detail
+
+/**
+ * Solve a linear system A * x = b with a square matrix with an LU
+ * decomposition with partial pivoting.
+ *
+ * @param a Matrix of the system
+ * @param b Right hand side, a vector or a matrix with a column per system
+ * @throws std::runtime_error if the matrix is singular
+ */
+template <typename MatrixExpr, typename RHS,
+          typename = traits::enable_if_matrix_expression<MatrixExpr>>
+auto
+solve(MatrixExpr&& a, RHS&& b)
+{
+    using matrix_type = typename std::decay_t<MatrixExpr>::matrix_type;
+    static_assert(matrix_type::rows == matrix_type::cols,
+                  "Linear solve is defined only for square matrices");
+    return lu_decomposition<matrix_type>{std::forward<MatrixExpr>(a)}.solve(std::forward<RHS>(b));
+}
+
+/**
+ * Solve a batch of independent linear systems A[i] * x[i] = b[i].
+ *
+ * Systems up to 4x4 are copied to lane-interleaved blocks and solved by
+ * Gaussian elimination with partial pivoting several at a time, so that the
+ * arithmetic is vectorized across the systems. The pivots are selected as
+ * in the LU decomposition used by the single system solve, so the solutions
+ * are as accurate. Larger systems are solved one by one with an LU
+ * decomposition.
+ *
+ * @param x Output buffer for the solutions
+ * @param a Matrices of the systems, a contiguous range with data() and
+ *          size(), e.g. a std::vector, of the same size as the output buffer
+ * @param b Right hand sides, must be of the same size as the output buffer
+ * @throws std::runtime_error if the sizes are different or a matrix is
+ *         singular, the systems before the block with the singular matrix
+ *         are solved
+ */
+template <typename T, std::size_t N, typename Components, typename Matrices, typename U,
+          typename RHSComponents>
+void
+solve(memory_vector_view<T*, N, Components> const& x, Matrices const& a,
+      memory_vector_view<U*, N, RHSComponents> const& b)
+{
+    static_assert(!std::is_const<T>::value, "Cannot solve to a constant memory buffer");
+    static_assert(std::is_same<std::remove_const_t<U>, T>::value,
+                  "Right hand side must have the same value type as the solution");
+    using value_type  = T;
+    using matrix_type = std::decay_t<decltype(*a.data())>;
+    static_assert(traits::is_matrix_v<matrix_type>,
+                  "Matrices of the systems must be a range of matrices");
+    static_assert(matrix_type::rows == N && matrix_type::cols == N,
+                  "Matrices of the systems must be square with the size of the solution");
+    static_assert(std::is_same<typename matrix_type::value_type, value_type>::value,
+                  "Matrices of the systems must have the same value type as the solution");
+    detail::check_memory_view_sizes(x.size(), a, b);
+
+    auto const count = x.size();
+    auto const m     = a.data();
+    auto       dst   = x.data();
+    auto       src   = b.data();
+    if constexpr (N <= 4 && std::is_floating_point_v<value_type>) {
+        constexpr auto lanes = detail::solve_batch_block_size;
+        detail::elimination_solve_block<value_type, N, lanes> block;
+        for (std::size_t i = 0; i < count; i += lanes, src += lanes * N, dst += lanes * N) {
+            auto const n = std::min(lanes, count - i);
+            block.load(m + i, src, n);
+            block.solve(n);
+            block.store(dst, n);
+        }
+    } else {
+        for (std::size_t i = 0; i < count; ++i, src += N, dst += N) {
+            vector<value_type, N> const res
+                = lu_decomposition<matrix_type>{m[i]}.solve(vector<value_type, N>{src});
+            detail::store_vector(dst, res, std::make_index_sequence<N>{});
+        }
+    }
+}
+
+}    // namespace math
+}    // namespace psst
+
+#endif /* PSST_MATH_MATRIX_SOLVE_HPP_ */
@@ -0,0 +1,274 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * padded_vector.hpp
+ *
+ *  Created on: Feb 6, 2019
+ *      Author: ser-fedorov
+ */
+
+#ifndef PSST_MATH_PADDED_VECTOR_HPP_
+#define PSST_MATH_PADDED_VECTOR_HPP_
+
+#include <psst/math/vector.hpp>
+
+namespace psst {
+namespace math {
+
+namespace detail {
+
+constexpr std::size_t
+padded_size(std::size_t size)
+{
+    std::size_t res = 1;
+    while (res < size)
+        res *= 2;
+    return res;
+}
+
+constexpr bool
+is_power_of_two(std::size_t v)
+{
+    return v != 0 && (v & (v - 1)) == 0;
+}
+
+}    // namespace detail
+
+/**
+ * Vector with storage padded to a power of two number of components, e.g. a 3
+ * component vector of floats occupies 16 bytes and is aligned to 16 bytes.
+ *
+ * The padding components are not part of the vector value, they are never
+ * read in expressions and are not guaranteed to keep any value. A padded
+ * vector can be used in any vector expression together with plain vectors of
+ * the same size and is implicitly converted from/to them.
+ *
+ * With SIMD evaluation enabled the whole padded storage is loaded and stored
+ * with aligned register operations, without assembling the components one by
+ * one.
+ */
+template <typename T, std::size_t Size,
+          typename Components = components::default_components_t<Size>>
+struct padded_vector
+    : expr::vector_expression<padded_vector<T, Size, Components>, vector<T, Size, Components>>,
+      detail::vector_ops<T, Size, Components, padded_vector<T, Size, Components>> {
+
+    using this_type            = padded_vector<T, Size, Components>;
+    using result_type          = vector<T, Size, Components>;
+    using base_expression_type = expr::vector_expression<this_type, result_type>;
+    using traits               = traits::vector_traits<result_type>;
+    using value_type           = typename traits::value_type;
+    using lvalue_reference     = typename traits::lvalue_reference;
+    using const_reference      = typename traits::const_reference;
+    using pointer              = typename traits::pointer;
+    using const_pointer        = typename traits::const_pointer;
+    using index_sequence_type  = typename traits::index_sequence_type;
+    using init_list            = std::initializer_list<value_type>;
+    using component_access     = typename base_expression_type::component_access;
+    template <std::size_t N>
+    using value_policy = typename component_access::template value_policy<N>;
+
+    static constexpr auto size = traits::size;
+    /**
+     * Number of components in the storage, including padding
+     */
+    static constexpr std::size_t storage_size = detail::padded_size(Size);
+    /**
+     * Alignment of the vector storage, the size of the storage if it is a
+     * power of two.
+     */
+    static constexpr std::size_t alignment
+        = detail::is_power_of_two(sizeof(T) * storage_size)
+              ? utils::max_v<sizeof(T) * storage_size, alignof(T)>
+              : alignof(T);
+
+    using iterator       = pointer;
+    using const_iterator = const_pointer;
+
+    constexpr padded_vector() : padded_vector{T{0}, index_sequence_type{}} {}
+    constexpr explicit padded_vector(value_type val) : padded_vector(val, index_sequence_type{})
+    {}
+    constexpr padded_vector(init_list const& args)
+        : padded_vector(args.begin(), index_sequence_type{})
+    {}
+    constexpr padded_vector(const_pointer p) : padded_vector(p, index_sequence_type{}) {}
+
+    template <typename Expression, typename = math::traits::enable_if_vector_expression<Expression>,
+              typename = math::traits::enable_for_compatible_components<this_type, Expression>>
+    constexpr /* implicit */ padded_vector(Expression&& rhs)
+        : padded_vector(std::forward<Expression>(rhs), expression_init_tag<Expression>{})
+    {}
+
+    pointer
+    data()
+    {
+        return data_.data();
+    }
+    constexpr const_pointer
+    data() const
+    {
+        return data_.data();
+    }
+
+    template <std::size_t N>
+    typename value_policy<N>::accessor_type
+    at()
+    {
+        static_assert(N < size, "Invalid component index in padded_vector");
+        return value_policy<N>::accessor(std::get<N>(data_));
+    }
+
+    template <std::size_t N>
+    constexpr const_reference
+    at() const
+    {
+        static_assert(N < size, "Invalid component index in padded_vector");
+        return std::get<N>(data_);
+    }
+
+    iterator
+    begin()
+    {
+        return data();
+    }
+    constexpr const_iterator
+    begin() const
+    {
+        return cbegin();
+    }
+    constexpr const_iterator
+    cbegin() const
+    {
+        return data();
+    }
+
+    iterator
+    end()
+    {
+        return data() + size;
+    }
+    constexpr const_iterator
+    end() const
+    {
+        return cend();
+    }
+    constexpr const_iterator
+    cend() const
+    {
+        return data() + size;
+    }
+
+    lvalue_reference operator[](std::size_t idx)
+    {
+        assert(idx < size);
+        return data_[idx];
+    }
+    constexpr const_reference operator[](std::size_t idx) const
+    {
+        assert(idx < size);
+        return data_[idx];
+    }
+
+    /**
+     * Copy of the vector without padding
+     */
+    constexpr result_type
+    value() const
+    {
+        return result_type{*this};
+    }
+
+private:
+    template <std::size_t... Indexes>
+    constexpr padded_vector(value_type val, std::index_sequence<Indexes...>)
+        : data_{{value_policy<Indexes>::apply(utils::value_fill<Indexes, T>{val}.value)...}}
+    {}
+    template <std::size_t... Indexes>
+    constexpr padded_vector(const_pointer p, std::index_sequence<Indexes...>)
+        : data_{{value_policy<Indexes>::apply(*(p + Indexes))...}}
+    {}
+    template <typename Expr, std::size_t... Indexes>
+    constexpr padded_vector(Expr&& rhs, std::index_sequence<Indexes...>)
+        : data_{{value_policy<Indexes>::apply(expr::get<Indexes>(std::forward<Expr>(rhs)))...}}
+    {}
+    /**
+     * Evaluate the whole expression in a SIMD register and store all the
+     * register lanes, including the padding.
+     */
+    template <typename Expr>
+    constexpr padded_vector(Expr&& rhs, expr::simd_evaluation_tag) : data_{}
+    {
+        if (simd::is_constant_evaluated()) {
+            assign_components(rhs, index_sequence_type{});
+        } else {
+            simd::register_traits<T, storage_size>::store_aligned(data_.data(),
+                                                                  expr::simd_eval(rhs));
+        }
+    }
+    /**
+     * Component-wise evaluation of a SIMD assignable expression in a constant
+     * expression, the padding stays zero
+     */
+    template <typename Expr, std::size_t... Indexes>
+    constexpr void
+    assign_components(Expr const& rhs, std::index_sequence<Indexes...>)
+    {
+        ((data_[Indexes] = expr::get<Indexes>(rhs)), ...);
+    }
+
+    template <typename Expr>
+    using expression_init_tag = std::conditional_t<
+        expr::simd_assignable_v<T, Size, Components, Expr>
+            && expr::simd_padded_v<T, Size, storage_size, alignment>
+            && simd::constant_evaluation_detected,
+        expr::simd_evaluation_tag,
+        utils::make_min_index_sequence<Size, math::traits::vector_expression_size_v<Expr>>>;
+
+private:
+    using data_type = std::array<T, storage_size>;
+    alignas(alignment) data_type data_;
+};
+
+template <std::size_t N, typename T, std::size_t Size, typename Components>
+constexpr typename padded_vector<T, Size, Components>::template value_policy<N>::accessor_type
+get(padded_vector<T, Size, Components>& v)
+{
+    return v.template at<N>();
+}
+
+namespace traits {
+
+template <typename T, std::size_t S, typename Components>
+struct is_mutable_vector<padded_vector<T, S, Components>> : std::true_type {};
+
+}    // namespace traits
+
+namespace expr {
+inline namespace v {
+
+/**
+ * Padded vectors are loaded to a SIMD register as a whole
+ */
+template <typename T, std::size_t Size, typename Components>
+struct simd_evaluator<
+    padded_vector<T, Size, Components>,
+    std::enable_if_t<simd_padded_v<T, Size, padded_vector<T, Size, Components>::storage_size,
+                                   padded_vector<T, Size, Components>::alignment>>>
+    : simd_evaluator_base<padded_vector<T, Size, Components>> {
+    using base_type     = simd_evaluator_base<padded_vector<T, Size, Components>>;
+    using register_type = typename base_type::register_type;
+
+    static register_type
+    eval(padded_vector<T, Size, Components> const& v)
+    {
+        return simd::register_traits<T, padded_vector<T, Size, Components>::storage_size>::
+            load_aligned(v.data());
+    }
+};
+
+}    // namespace v
+}    // namespace expr
+
+}    // namespace math
+}    // namespace psst
+
+#endif /* PSST_MATH_PADDED_VECTOR_HPP_ */
@@ -0,0 +1,286 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * point_transform.hpp
+ *
+ *  Created on: Feb 10, 2019
+ *      Author: ser-fedorov
+ */
+
+#ifndef PSST_MATH_POINT_TRANSFORM_HPP_
+#define PSST_MATH_POINT_TRANSFORM_HPP_
+
+#include <psst/math/matrix.hpp>
+#include <psst/math/vector_transform.hpp>
+#include <psst/math/vector_view.hpp>
+
+#include <algorithm>
+#include <vector>
+
+/**
+ * Splitting buffer transforms between threads is opt-in. Define
+ * PSST_MATH_ENABLE_THREADS (or configure the project with
+ * -DPSST_MATH_ENABLE_THREADS=ON, that links the threads library) to enable
+ * it, otherwise the number of threads is ignored.
+ */
+#if defined(PSST_MATH_ENABLE_THREADS)
+#    include <thread>
+#endif
+
+namespace psst {
+namespace math {
+
+namespace detail {
+
+/**
+ * A transform of a buffer of 3 or 4 component vectors by a matrix up to
+ * 4x4. The matrix is extended to 4x4 with the rows and columns of the
+ * identity matrix and is stored by columns. A 3-component vector is
+ * extended with the homogeneous coordinate w, 1 for points and 0 for
+ * direction vectors.
+ */
+template <typename T>
+struct buffer_transform {
+    using value_type = T;
+
+    template <typename Matrix>
+    buffer_transform(Matrix const& m, value_type w) : w{w}
+    {
+        using matrix_type = typename Matrix::matrix_type;
+        static_assert((matrix_type::rows == 3 || matrix_type::rows == 4)
+                          && (matrix_type::cols == 3 || matrix_type::cols == 4),
+                      "Buffers are transformed by matrices from 3x3 to 4x4");
+        matrix_type const mtx{m};
+        for (std::size_t c = 0; c < 4; ++c) {
+            for (std::size_t r = 0; r < 4; ++r) {
+                if (r < matrix_type::rows && c < matrix_type::cols) {
+                    cols[c][r] = static_cast<value_type>(mtx[r][c]);
+                } else {
+                    cols[c][r] = r == c ? value_type{1} : value_type{0};
+                }
+            }
+        }
+    }
+
+    /**
+     * Transform count vectors of Size components. The output can be the
+     * same buffer as the input.
+     */
+    template <std::size_t Size>
+    void
+    apply(value_type const* src, value_type* dst, std::size_t count) const
+    {
+        using register_traits = simd::register_traits<value_type, 4>;
+        if constexpr (simd::register_enabled_v<value_type, 4>
+                      && simd::register_enabled_v<value_type, Size>) {
+            // The columns of the matrix are scaled by the components
+            // broadcast to the registers and summed. A 3-component vector is
+            // stored from the register of 4 components.
+            auto const c0 = register_traits::load(cols[0]);
+            auto const c1 = register_traits::load(cols[1]);
+            auto const c2 = register_traits::load(cols[2]);
+            auto const c3 = register_traits::load(cols[3]);
+            auto const cw = register_traits::mul(c3, register_traits::broadcast(w));
+            for (std::size_t i = 0; i < count; ++i, src += Size, dst += Size) {
+                auto res = cw;
+                if constexpr (Size == 4) {
+                    res = register_traits::mul(c3, register_traits::broadcast(src[3]));
+                }
+                res = register_traits::fmadd(c0, register_traits::broadcast(src[0]), res);
+                res = register_traits::fmadd(c1, register_traits::broadcast(src[1]), res);
+                res = register_traits::fmadd(c2, register_traits::broadcast(src[2]), res);
+                simd::register_traits<value_type, Size>::store(dst, res);
+            }
+        } else {
+            // A local copy of the matrix doesn't alias the output, so it is
+            // not reloaded after each store
+            value_type m[4][Size];
+            for (std::size_t c = 0; c < 4; ++c) {
+                std::copy(cols[c], cols[c] + Size, m[c]);
+            }
+            auto const hw = w;
+            for (std::size_t i = 0; i < count; ++i, src += Size, dst += Size) {
+                value_type v[4]{src[0], src[1], src[2], hw};
+                if constexpr (Size == 4) {
+                    v[3] = src[3];
+                }
+                transform_vector(m, v, dst, std::make_index_sequence<Size>{});
+            }
+        }
+    }
+
+    alignas(simd::storage_alignment_v<value_type, 4>) value_type cols[4][4];
+    value_type w;
+
+private:
+    template <std::size_t Size, std::size_t... Rows>
+    static void
+    transform_vector(value_type const (&m)[4][Size], value_type const (&v)[4], value_type* dst,
+                     std::index_sequence<Rows...>)
+    {
+        // The rows are unrolled, so that the matrix stays in registers
+        value_type const res[]{utils::multiply_add<value_type>(
+            m[2][Rows], v[2],
+            utils::multiply_add<value_type>(
+                m[1][Rows], v[1],
+                utils::multiply_add<value_type>(m[0][Rows], v[0], m[3][Rows] * v[3])))...};
+        std::copy(res, res + Size, dst);
+    }
+};
+
+/**
+ * Minimal number of elements transformed by a thread, a smaller buffer is
+ * not split between threads. The threads are started and joined by each
+ * call, there is no thread pool, so a block must be large enough to pay
+ * for creating a thread, that takes tens of microseconds.
+ */
+constexpr std::size_t transform_thread_block_size = 1 << 14;
+
+/**
+ * Transform the elements of a buffer, split between threads if threading is
+ * enabled
+ * @param threads Number of threads, 0 for the hardware concurrency
+ */
+template <typename T, std::size_t Size, typename Components, typename U, typename InComponents>
+void
+transform_buffer(buffer_transform<std::remove_const_t<T>> const& tr,
+                 memory_vector_view<U*, Size, InComponents> const& in,
+                 memory_vector_view<T*, Size, Components> const& out, std::size_t threads)
+{
+    static_assert(!std::is_const<T>::value, "Cannot transform to a constant memory buffer");
+    static_assert(std::is_same<std::remove_const_t<U>, T>::value,
+                  "Input and output buffers must have the same value type");
+    static_assert(Size == 3 || Size == 4, "Buffers of 3 or 4 component vectors are transformed");
+    check_memory_view_sizes(out.size(), in);
+
+    auto const count = out.size();
+#if defined(PSST_MATH_ENABLE_THREADS)
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    threads = std::min(threads, std::max(count / transform_thread_block_size, std::size_t{1}));
+    if (threads <= 1) {
+        tr.template apply<Size>(in.data(), out.data(), count);
+        return;
+    }
+
+    auto const               block = (count + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    // Elements before started are transformed by the calling thread and
+    // the started workers
+    std::size_t started = block;
+    try {
+        for (; started < count; started += block) {
+            auto const n = std::min(block, count - started);
+            workers.emplace_back([&tr, src = in.data() + started * Size,
+                                  dst = out.data() + started * Size,
+                                  n]() { tr.template apply<Size>(src, dst, n); });
+        }
+    } catch (...) {
+        // A thread could not be started, the workers that are running must
+        // be joined, the rest of the buffer is transformed below
+    }
+    // The first block is transformed by the calling thread, as well as the
+    // blocks that didn't get a thread
+    tr.template apply<Size>(in.data(), out.data(), std::min(block, count));
+    if (started < count) {
+        tr.template apply<Size>(in.data() + started * Size, out.data() + started * Size,
+                                count - started);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+#else
+    (void)threads;
+    tr.template apply<Size>(in.data(), out.data(), count);
+#endif
+}
+
+}    // namespace detail
+
+/**
+ * Transform a buffer of points by a matrix.
+ *
+ * 3-component points are transformed as homogeneous coordinates with w = 1,
+ * the last row of a 4x4 matrix is not used, i.e. the matrix is an affine
+ * transform. 4-component vectors are multiplied by the whole matrix. A 3x3
+ * matrix is a linear transform without translation.
+ *
+ * With SIMD enabled the vectors are transformed in registers. With
+ * PSST_MATH_ENABLE_THREADS defined large buffers can be split between
+ * several threads.
+ *
+ * @param m Transform matrix, 3x3, 3x4 or 4x4
+ * @param in Input buffer
+ * @param out Output buffer, must be of the same size as the input buffer.
+ *        Can be the same buffer as the input, must not overlap it otherwise.
+ * @param threads Number of threads, 0 for the hardware concurrency. A
+ *        thread transforms at least detail::transform_thread_block_size
+ *        elements.
+ */
+template <typename Matrix, typename T, std::size_t Size, typename Components, typename U,
+          typename InComponents, typename = traits::enable_if_matrix_expression<Matrix>>
+void
+transform_points(Matrix const& m, memory_vector_view<U*, Size, InComponents> const& in,
+                 memory_vector_view<T*, Size, Components> const& out, std::size_t threads = 1)
+{
+    detail::transform_buffer(detail::buffer_transform<std::remove_const_t<T>>{m, 1}, in, out,
+                             threads);
+}
+
+/**
+ * Transform a buffer of direction vectors by a matrix.
+ *
+ * 3-component vectors are transformed as homogeneous coordinates with
+ * w = 0, so the translation of an affine transform doesn't apply. Otherwise
+ * the same as transform_points.
+ *
+ * @see transform_points
+ */
+template <typename Matrix, typename T, std::size_t Size, typename Components, typename U,
+          typename InComponents, typename = traits::enable_if_matrix_expression<Matrix>>
+void
+transform_vectors(Matrix const& m, memory_vector_view<U*, Size, InComponents> const& in,
+                  memory_vector_view<T*, Size, Components> const& out, std::size_t threads = 1)
+{
+    detail::transform_buffer(detail::buffer_transform<std::remove_const_t<T>>{m, 0}, in, out,
+                             threads);
+}
+
+/**
+ * Transform a buffer of 3-component surface normals by the inverse
+ * transpose of the linear part (the upper left 3x3 block) of a matrix.
+ *
+ * The inverse is computed once per call. The normals are not normalized,
+ * a transform with scaling changes their length.
+ *
+ * @see transform_points
+ * @throws std::runtime_error if the linear part of the matrix is singular
+ */
+template <typename Matrix, typename T, typename Components, typename U, typename InComponents,
+          typename = traits::enable_if_matrix_expression<Matrix>>
+void
+transform_normals(Matrix const& m, memory_vector_view<U*, 3, InComponents> const& in,
+                  memory_vector_view<T*, 3, Components> const& out, std::size_t threads = 1)
+{
+    using value_type  = std::remove_const_t<T>;
+    using matrix_type = typename Matrix::matrix_type;
+    using linear_type = matrix<value_type, 3, 3>;
+    static_assert(matrix_type::rows >= 3 && matrix_type::cols >= 3,
+                  "The matrix must have a 3x3 linear part");
+
+    matrix_type const mtx{m};
+    linear_type       linear;
+    for (std::size_t r = 0; r < 3; ++r) {
+        for (std::size_t c = 0; c < 3; ++c) {
+            linear[r][c] = static_cast<value_type>(mtx[r][c]);
+        }
+    }
+    detail::transform_buffer(
+        detail::buffer_transform<value_type>{transpose(inverse(linear)), 0}, in, out, threads);
+}
+
+}    // namespace math
+}    // namespace psst
+
+#endif /* PSST_MATH_POINT_TRANSFORM_HPP_ */
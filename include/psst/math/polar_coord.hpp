@@ -79,6 +79,9 @@ struct vector_scalar_multiply<components::polar, LHS, RHS>
     }
 };
 
+template <typename LHS, typename RHS>
+struct has_runtime_at<vector_scalar_multiply<components::polar, LHS, RHS>> : std::false_type {};
+
 //@}
 //@{
 /** @name Vector scalar division for polar coordinates */
@@ -106,6 +109,9 @@ struct vector_scalar_divide<components::polar, LHS, RHS>
         }
     }
 };
+
+template <typename LHS, typename RHS>
+struct has_runtime_at<vector_scalar_divide<components::polar, LHS, RHS>> : std::false_type {};
 //@}
 //@{
 /** @name Magnitude squared for polar coordinates */
@@ -150,27 +150,46 @@ struct vector_normalize<components::wxyz, Expr>
     using base_type  = unary_vector_expression_components<vector_normalize, components::wxyz, Expr>;
     using value_type = typename base_type::value_type;
     using expression_base = unary_expression<Expr>;
-    using expression_base::expression_base;
+    using arg_type        = typename expression_base::arg_type;
+
+    explicit constexpr vector_normalize(arg_type arg)
+        : expression_base{std::forward<arg_type>(arg)},
+          mag_{checked_magnitude(this->arg_)},
+          inv_mag_{value_type{1} / mag_}
+    {}
 
     template <std::size_t N>
     constexpr auto
     at() const
     {
         static_assert(N < base_type::size, "Invalid quaternion component index");
-        value_type mag = magnitude(this->arg_);
-        if (mag == 0)
-            throw std::runtime_error("Cannot normalise a zero quaternion");
         if constexpr (N == components::wxyz::w) {
-            return this->arg_.template at<N>() / mag;
+            return this->arg_.template at<N>() * inv_mag_;
         } else {
             auto val = this->arg_.template at<N>();
-            if (val == mag) {
-                return -val / mag;
+            if (val == mag_) {
+                return -val * inv_mag_;
             } else {
-                return val / mag;
+                return val * inv_mag_;
             }
         }
     }
+
+private:
+    template <typename Arg>
+    static constexpr value_type
+    checked_magnitude(Arg const& arg)
+    {
+        value_type mag = magnitude(arg);
+        if (mag == 0)
+            throw std::runtime_error("Cannot normalise a zero quaternion");
+        return mag;
+    }
+
+    // Magnitude is evaluated once, normalize evaluates the expression right
+    // after it is built
+    value_type mag_;
+    value_type inv_mag_;
 };
 //@}
 
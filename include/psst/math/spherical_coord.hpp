@@ -82,6 +82,9 @@ struct vector_scalar_multiply<components::spherical, LHS, RHS>
         }
     }
 };
+
+template <typename LHS, typename RHS>
+struct has_runtime_at<vector_scalar_multiply<components::spherical, LHS, RHS>> : std::false_type {};
 //@}
 
 //@{
@@ -110,6 +113,9 @@ struct vector_scalar_divide<components::spherical, LHS, RHS>
         }
     }
 };
+
+template <typename LHS, typename RHS>
+struct has_runtime_at<vector_scalar_divide<components::spherical, LHS, RHS>> : std::false_type {};
 //@}
 
 //@{
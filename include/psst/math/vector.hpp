@@ -8,6 +8,7 @@
 #ifndef PSST_MATH_VECTOR_HPP_
 #define PSST_MATH_VECTOR_HPP_
 
+#include <psst/math/detail/alignment.hpp>
 #include <psst/math/detail/conversion.hpp>
 #include <psst/math/detail/vector_expressions.hpp>
 #include <psst/math/detail/vector_ops.hpp>
@@ -44,6 +45,12 @@ struct vector : expr::vector_expression<vector<T, Size, Components>>,
     using value_policy = typename component_access::template value_policy<N>;
 
     static constexpr auto size = traits::size;
+    /**
+     * Alignment of the vector storage
+     * @see alignment_policy
+     */
+    static constexpr std::size_t alignment
+        = utils::max_v<alignment_policy_v<this_type>, alignof(T)>;
 
     constexpr vector() : vector{T{0}, index_sequence_type{}} {}
 
@@ -67,13 +74,10 @@ struct vector : expr::vector_expression<vector<T, Size, Components>>,
     template <typename Expression, typename = math::traits::enable_if_vector_expression<Expression>,
               typename = math::traits::enable_for_compatible_components<this_type, Expression>>
     constexpr /* implicit */ vector(Expression&& rhs)
-        : vector(
-            std::forward<Expression>(rhs),
-            utils::make_min_index_sequence<Size,
-                                           math::traits::vector_expression_size_v<Expression>>{})
+        : vector(std::forward<Expression>(rhs), expression_init_tag<Expression>{})
     {}
 
-    pointer
+    constexpr pointer
     data()
     {
         return data_.data();
@@ -136,7 +140,7 @@ struct vector : expr::vector_expression<vector<T, Size, Components>>,
     }
 
     // FIXME Apply accessors
-    lvalue_reference operator[](std::size_t idx)
+    constexpr lvalue_reference operator[](std::size_t idx)
     {
         assert(idx < size);
         return data_[idx];
@@ -147,6 +151,15 @@ struct vector : expr::vector_expression<vector<T, Size, Components>>,
         assert(idx < size);
         return data_[idx];
     }
+    /**
+     * Runtime access to a component, e.g. in loops over large vectors
+     */
+    constexpr const_reference
+    at(std::size_t idx) const
+    {
+        assert(idx < size);
+        return data_[idx];
+    }
     // TODO Make converter a CRTP base
     template <typename U>
     U
@@ -180,10 +193,62 @@ private:
     constexpr vector(Expr&& rhs, std::index_sequence<Indexes...>)
         : data_({value_policy<Indexes>::apply(expr::get<Indexes>(std::forward<Expr>(rhs)))...})
     {}
+    /**
+     * Evaluate a large expression in a loop, the components have no value
+     * policies
+     */
+    template <typename Expr>
+    constexpr vector(Expr const& rhs, expr::loop_evaluation_tag) : data_{}
+    {
+        constexpr std::size_t count
+            = utils::min<Size, math::traits::vector_expression_size_v<Expr>>::value;
+        for (std::size_t i = 0; i < count; ++i) {
+            data_[i] = static_cast<value_type>(rhs.at(i));
+        }
+    }
+    /**
+     * Evaluate the whole expression in SIMD registers and store the result
+     */
+    template <typename Expr>
+    constexpr vector(Expr&& rhs, expr::simd_evaluation_tag) : data_{}
+    {
+        if (simd::is_constant_evaluated()) {
+            assign_components(rhs, index_sequence_type{});
+        } else if constexpr (alignment >= simd::register_traits<T, Size>::alignment) {
+            expr::simd_store_aligned(data_.data(), rhs);
+        } else {
+            expr::simd_store(data_.data(), rhs);
+        }
+    }
+    /**
+     * Component-wise evaluation of a SIMD assignable expression in a constant
+     * expression
+     */
+    template <typename Expr, std::size_t... Indexes>
+    constexpr void
+    assign_components(Expr const& rhs, std::index_sequence<Indexes...>)
+    {
+        ((data_[Indexes] = expr::get<Indexes>(rhs)), ...);
+    }
+
+    /**
+     * Large expressions are evaluated in a loop when the components have no
+     * value policies
+     * @see expr::unroll_threshold
+     */
+    template <typename Expr>
+    using expression_init_tag = std::conditional_t<
+        expr::simd_assignable_v<T, Size, Components, Expr> && simd::constant_evaluation_detected,
+        expr::simd_evaluation_tag,
+        std::conditional_t<
+            expr::vector_loop_evaluable_v<Expr>
+                && expr::v::detail::simd_plain_components_v<T, Components>,
+            expr::loop_evaluation_tag,
+            utils::make_min_index_sequence<Size, math::traits::vector_expression_size_v<Expr>>>>;
 
 private:
     using data_type = std::array<T, size>;
-    data_type data_;
+    alignas(alignment) data_type data_;
 };
 
 template <std::size_t N, typename T, std::size_t Size, typename Components>
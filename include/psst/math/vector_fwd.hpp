@@ -29,6 +29,9 @@ template <typename T, std::size_t Size,
           typename Components = components::default_components_t<Size>>
 struct vector_view;
 
+template <typename T>
+struct dynamic_vector;
+
 } /* namespace math */
 } /* namespace psst */
 
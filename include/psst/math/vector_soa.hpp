@@ -0,0 +1,582 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * vector_soa.hpp
+ *
+ *  Created on: Feb 3, 2019
+ *      Author: ser-fedorov
+ */
+
+#ifndef PSST_MATH_VECTOR_SOA_HPP_
+#define PSST_MATH_VECTOR_SOA_HPP_
+
+#include <psst/math/vector.hpp>
+#include <psst/math/vector_view.hpp>
+
+#include <array>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+namespace psst {
+namespace math {
+
+/**
+ * Reference to an element of a structure-of-arrays container. Holds a
+ * pointer to the element's value in each of the component lanes.
+ *
+ * For a const pointer the reference is read-only.
+ */
+template <typename T, std::size_t Size, typename Components>
+struct vector_soa_reference;
+
+template <typename T, std::size_t Size, typename Components>
+struct vector_soa_reference<T*, Size, Components>
+    : expr::vector_expression<vector_soa_reference<T*, Size, Components>,
+                              vector<std::remove_const_t<T>, Size, Components>> {
+
+    using this_type            = vector_soa_reference<T*, Size, Components>;
+    using base_expression_type = expr::vector_expression<
+        this_type, vector<std::remove_const_t<T>, Size, Components>>;
+    using result_type = typename base_expression_type::result_type;
+
+    using traits           = traits::vector_traits<result_type>;
+    using value_type       = typename traits::value_type;
+    using const_reference  = typename traits::const_reference;
+    using pointer          = T*;
+    using pointers_type    = std::array<pointer, Size>;
+    using component_access = typename base_expression_type::component_access;
+    template <std::size_t N>
+    using value_policy = typename component_access::template value_policy<N>;
+
+    static constexpr auto size = traits::size;
+
+    constexpr explicit vector_soa_reference(pointers_type const& p) : data_{p} {}
+    constexpr vector_soa_reference(vector_soa_reference const&) = default;
+
+    /**
+     * Assigns values, not the pointers
+     */
+    vector_soa_reference&
+    operator=(vector_soa_reference const& rhs)
+    {
+        return assign(result_type{rhs}, typename traits::index_sequence_type{});
+    }
+
+    template <typename Expression, typename = math::traits::enable_if_vector_expression<Expression>,
+              typename = math::traits::enable_for_compatible_components<this_type, Expression>>
+    vector_soa_reference&
+    operator=(Expression const& rhs)
+    {
+        // Evaluate to a temporary first, the expression can refer to this
+        // element of the container
+        return assign(result_type{rhs}, typename traits::index_sequence_type{});
+    }
+
+    template <std::size_t N>
+    T&
+    at()
+    {
+        static_assert(N < size, "Invalid component index in vector_soa_reference");
+        return *std::get<N>(data_);
+    }
+
+    template <std::size_t N>
+    constexpr const_reference
+    at() const
+    {
+        static_assert(N < size, "Invalid component index in vector_soa_reference");
+        return *std::get<N>(data_);
+    }
+
+    T& operator[](std::size_t idx)
+    {
+        assert(idx < size);
+        return *data_[idx];
+    }
+
+    constexpr const_reference operator[](std::size_t idx) const
+    {
+        assert(idx < size);
+        return *data_[idx];
+    }
+
+    /**
+     * Copy of the referenced element
+     */
+    constexpr result_type
+    value() const
+    {
+        return result_type{*this};
+    }
+
+private:
+    template <std::size_t... Indexes>
+    vector_soa_reference&
+    assign(result_type const& rhs, std::index_sequence<Indexes...>)
+    {
+        static_assert(!std::is_const<T>::value, "Cannot assign to a constant vector_soa element");
+        ((this->template at<Indexes>() = rhs.template at<Indexes>()), ...);
+        return *this;
+    }
+
+private:
+    pointers_type data_;
+};
+
+namespace traits {
+
+template <typename T, std::size_t S, typename Components>
+struct is_vector_handle<vector_soa_reference<T, S, Components>> : std::true_type {};
+
+template <typename T, std::size_t S, typename Components>
+struct is_mutable_vector<vector_soa_reference<T*, S, Components>>
+    : utils::bool_constant<!std::is_const<T>::value> {};
+
+}    // namespace traits
+
+/**
+ * Structure-of-arrays container of vectors. Each component of the vectors is
+ * stored in a separate contiguous array (lane), so that an operation on a
+ * component can be vectorized across elements.
+ *
+ * Elements are accessed via vector_soa_reference, that can be used in vector
+ * expressions and assigned from them.
+ */
+template <typename T, std::size_t Size,
+          typename Components = components::default_components_t<Size>>
+struct vector_soa {
+    using this_type       = vector_soa<T, Size, Components>;
+    using value_type      = T;
+    using vector_type     = vector<T, Size, Components>;
+    using lane_type       = std::vector<T>;
+    using size_type       = std::size_t;
+    using reference       = vector_soa_reference<T*, Size, Components>;
+    using const_reference = vector_soa_reference<T const*, Size, Components>;
+
+    static constexpr std::size_t component_count = Size;
+
+    template <typename P>
+    struct base_iterator {
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = vector_soa_reference<P, Size, Components>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = utils::arrow_proxy<value_type>;
+        using reference         = value_type;
+        using pointers_type     = typename value_type::pointers_type;
+
+        base_iterator(pointers_type const& p) : p_{p} {}
+
+        bool
+        operator==(base_iterator const& rhs) const
+        {
+            return p_[0] == rhs.p_[0];
+        }
+        bool
+        operator!=(base_iterator const& rhs) const
+        {
+            return p_[0] != rhs.p_[0];
+        }
+        bool
+        operator<(base_iterator const& rhs) const
+        {
+            return p_[0] < rhs.p_[0];
+        }
+        bool
+        operator>(base_iterator const& rhs) const
+        {
+            return rhs < *this;
+        }
+        bool
+        operator<=(base_iterator const& rhs) const
+        {
+            return !(rhs < *this);
+        }
+        bool
+        operator>=(base_iterator const& rhs) const
+        {
+            return !(*this < rhs);
+        }
+
+        base_iterator&
+        operator++()
+        {
+            return *this += 1;
+        }
+        base_iterator
+        operator++(int)
+        {
+            base_iterator i{p_};
+            *this += 1;
+            return i;
+        }
+        base_iterator
+        operator+(difference_type d) const
+        {
+            base_iterator i{p_};
+            return i += d;
+        }
+        friend base_iterator
+        operator+(difference_type d, base_iterator const& it)
+        {
+            return it + d;
+        }
+        base_iterator&
+        operator+=(difference_type d)
+        {
+            for (auto& p : p_) {
+                p += d;
+            }
+            return *this;
+        }
+
+        base_iterator&
+        operator--()
+        {
+            return *this -= 1;
+        }
+        base_iterator
+        operator--(int)
+        {
+            base_iterator i{p_};
+            *this -= 1;
+            return i;
+        }
+        base_iterator
+        operator-(difference_type d) const
+        {
+            base_iterator i{p_};
+            return i -= d;
+        }
+        difference_type
+        operator-(base_iterator const& rhs) const
+        {
+            return p_[0] - rhs.p_[0];
+        }
+        base_iterator&
+        operator-=(difference_type d)
+        {
+            return *this += -d;
+        }
+
+        value_type operator[](difference_type index) const { return *(*this + index); }
+
+        value_type operator*() const { return value_type{p_}; }
+        pointer operator->() const { return pointer{value_type{p_}}; }
+
+    private:
+        pointers_type p_;
+    };
+
+    using iterator       = base_iterator<T*>;
+    using const_iterator = base_iterator<T const*>;
+
+    vector_soa() = default;
+    explicit vector_soa(size_type n) { resize(n); }
+    vector_soa(size_type n, vector_type const& val) { resize(n, val); }
+    vector_soa(std::initializer_list<vector_type> args)
+    {
+        reserve(args.size());
+        for (auto const& v : args) {
+            push_back(v);
+        }
+    }
+    /**
+     * Copy vectors from an array-of-structures buffer
+     */
+    template <typename U>
+    explicit vector_soa(memory_vector_view<U*, Size, Components> const& mem)
+    {
+        assign(mem);
+    }
+
+    /**
+     * Number of vectors in the container
+     * @return
+     */
+    size_type
+    size() const
+    {
+        return lanes_[0].size();
+    }
+    bool
+    empty() const
+    {
+        return lanes_[0].empty();
+    }
+    size_type
+    capacity() const
+    {
+        return lanes_[0].capacity();
+    }
+
+    void
+    reserve(size_type n)
+    {
+        for (auto& lane : lanes_) {
+            lane.reserve(n);
+        }
+    }
+    void
+    resize(size_type n)
+    {
+        for (auto& lane : lanes_) {
+            lane.resize(n);
+        }
+    }
+    void
+    resize(size_type n, vector_type const& val)
+    {
+        for (size_type c = 0; c < component_count; ++c) {
+            lanes_[c].resize(n, val[c]);
+        }
+    }
+    void
+    clear()
+    {
+        for (auto& lane : lanes_) {
+            lane.clear();
+        }
+    }
+
+    template <typename Expression, typename = math::traits::enable_if_vector_expression<Expression>>
+    void
+    push_back(Expression const& rhs)
+    {
+        vector_type v{rhs};
+        for (size_type c = 0; c < component_count; ++c) {
+            lanes_[c].push_back(v[c]);
+        }
+    }
+
+    reference operator[](size_type index) { return *(begin() + index); }
+    const_reference operator[](size_type index) const { return *(begin() + index); }
+
+    iterator
+    begin()
+    {
+        return iterator{lane_pointers(typename vector_type::index_sequence_type{})};
+    }
+    const_iterator
+    begin() const
+    {
+        return cbegin();
+    }
+    const_iterator
+    cbegin() const
+    {
+        return const_iterator{lane_pointers(typename vector_type::index_sequence_type{})};
+    }
+
+    iterator
+    end()
+    {
+        return begin() + size();
+    }
+    const_iterator
+    end() const
+    {
+        return cend();
+    }
+    const_iterator
+    cend() const
+    {
+        return cbegin() + size();
+    }
+
+    //@{
+    /** @name Access to component lanes */
+    template <std::size_t N>
+    value_type*
+    lane()
+    {
+        static_assert(N < component_count, "Invalid component index in vector_soa");
+        return std::get<N>(lanes_).data();
+    }
+    template <std::size_t N>
+    value_type const*
+    lane() const
+    {
+        static_assert(N < component_count, "Invalid component index in vector_soa");
+        return std::get<N>(lanes_).data();
+    }
+    value_type*
+    lane(size_type n)
+    {
+        assert(n < component_count);
+        return lanes_[n].data();
+    }
+    value_type const*
+    lane(size_type n) const
+    {
+        assert(n < component_count);
+        return lanes_[n].data();
+    }
+    //@}
+
+    //@{
+    /** @name Conversion from/to array-of-structures buffers */
+    /**
+     * Replace contents with vectors from the memory buffer
+     */
+    template <typename U>
+    void
+    assign(memory_vector_view<U*, Size, Components> const& mem)
+    {
+        static_assert((std::is_same<std::remove_const_t<U>, value_type>{}),
+                      "Incompatible memory buffer type");
+        auto const n = mem.size();
+        resize(n);
+        auto src = mem.data();
+        for (size_type c = 0; c < component_count; ++c) {
+            auto dst = lanes_[c].data();
+            for (size_type i = 0; i < n; ++i) {
+                dst[i] = src[i * component_count + c];
+            }
+        }
+    }
+    /**
+     * Copy vectors to the memory buffer. The buffer must have room for all
+     * vectors of the container.
+     */
+    void
+    copy_to(memory_vector_view<value_type*, Size, Components> const& mem) const
+    {
+        if (mem.size() < size())
+            throw std::runtime_error{"The buffer is too small for vector_soa contents"};
+        auto const n   = size();
+        auto       dst = mem.data();
+        for (size_type c = 0; c < component_count; ++c) {
+            auto src = lanes_[c].data();
+            for (size_type i = 0; i < n; ++i) {
+                dst[i * component_count + c] = src[i];
+            }
+        }
+    }
+    //@}
+
+private:
+    template <std::size_t... Indexes>
+    typename reference::pointers_type
+    lane_pointers(std::index_sequence<Indexes...>)
+    {
+        return {std::get<Indexes>(lanes_).data()...};
+    }
+    template <std::size_t... Indexes>
+    typename const_reference::pointers_type
+    lane_pointers(std::index_sequence<Indexes...>) const
+    {
+        return {std::get<Indexes>(lanes_).data()...};
+    }
+
+private:
+    std::array<lane_type, Size> lanes_;
+};
+
+namespace detail {
+
+template <typename T, std::size_t Size, typename Vector, std::size_t... Indexes>
+void
+store_lanes(std::array<T*, Size> const& dst, std::size_t index, Vector const& v,
+            std::index_sequence<Indexes...>)
+{
+    ((std::get<Indexes>(dst)[index] = v.template at<Indexes>()), ...);
+}
+
+/**
+ * Evaluate the component N of the result of the function for all elements
+ * and store it to the output lane
+ */
+template <std::size_t N, typename T, typename Function, typename... Iterators>
+void
+transform_lane(T* dst, std::size_t n, Function& func, Iterators const&... in)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        dst[i] = func(in[i]...).template at<N>();
+    }
+}
+
+/**
+ * Store the result of the function lane by lane, the output lanes must not
+ * be the input lanes. A loop per lane stores to a single output lane, so the
+ * loop reads only the input lanes the component depends on and the compiler
+ * has few pairs of lanes to check for overlap before it vectorizes the loop.
+ */
+template <typename T, std::size_t Size, typename Function, std::size_t... Indexes,
+          typename... Iterators>
+void
+transform_lanes(std::array<T*, Size> const& dst, std::size_t n, Function& func,
+                std::index_sequence<Indexes...>, Iterators const&... in)
+{
+    (transform_lane<Indexes>(std::get<Indexes>(dst), n, func, in...), ...);
+}
+
+}    // namespace detail
+
+/**
+ * Evaluate an expression for each element of one or more vector_soa
+ * containers and store the result to the output container.
+ *
+ * The function is called with references to the elements of the input
+ * containers with the same index and must return a vector expression, e.g.
+ * @code
+ * transform(out, [s](auto a, auto b) { return a * s + b; }, a, b);
+ * @endcode
+ *
+ * When the output container is not one of the inputs, the output lanes are
+ * filled one by one, a loop over the elements per lane evaluates a single
+ * component of the expression. The components are loaded from and stored
+ * to the same index of their lanes, so the compiler can vectorize the loops
+ * across elements, a component of several elements per SIMD register. A
+ * subexpression that is evaluated as a whole, e.g. normalize, is evaluated
+ * in each of the loops. When the output container is one of the inputs each
+ * element is evaluated to a temporary vector before it is stored.
+ *
+ * @param out Output container
+ * @param func Function building an expression
+ * @param in Input containers, must be of the same size as the output
+ *           container
+ * @throws std::runtime_error if the sizes are different
+ */
+template <typename T, std::size_t Size, typename Components, typename Function,
+          typename... Containers>
+void
+transform(vector_soa<T, Size, Components>& out, Function&& func, Containers const&... in)
+{
+    using container_type  = vector_soa<T, Size, Components>;
+    using result_type     = typename container_type::vector_type;
+    using expression_type = decltype(func(in[0]...));
+    static_assert(traits::is_vector_expression_v<expression_type>,
+                  "Transform function must return a vector expression");
+
+    auto const n = out.size();
+    if (((in.size() != n) || ...))
+        throw std::runtime_error{"vector_soa containers have different sizes"};
+
+    std::array<T*, Size> dst;
+    for (std::size_t c = 0; c < Size; ++c) {
+        dst[c] = out.lane(c);
+    }
+    // Work with a copy of the function, so that the compiler can see that
+    // the captured values are not changed by the stores to the output lanes
+    std::decay_t<Function> fn{std::forward<Function>(func)};
+    constexpr bool direct_store = expr::v::detail::simd_plain_components_v<T, Components>;
+    bool const     in_place
+        = ((static_cast<void const*>(&in) == static_cast<void const*>(&out)) || ...);
+    if (direct_store && !in_place) {
+        detail::transform_lanes(dst, n, fn, std::make_index_sequence<Size>{},
+                                in.cbegin()...);
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            // Evaluate to a temporary first, the output can be an input or
+            // the components have value policies
+            result_type const res = fn(in[i]...);
+            detail::store_lanes(dst, i, res, std::make_index_sequence<Size>{});
+        }
+    }
+}
+
+}    // namespace math
+}    // namespace psst
+
+#endif /* PSST_MATH_VECTOR_SOA_HPP_ */
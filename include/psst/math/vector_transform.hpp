@@ -0,0 +1,276 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * vector_transform.hpp
+ *
+ *  Created on: Feb 4, 2019
+ *      Author: ser-fedorov
+ */
+
+#ifndef PSST_MATH_VECTOR_TRANSFORM_HPP_
+#define PSST_MATH_VECTOR_TRANSFORM_HPP_
+
+#include <psst/math/vector.hpp>
+#include <psst/math/vector_view.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+namespace psst {
+namespace math {
+
+namespace detail {
+
+template <typename View>
+struct memory_view_element;
+
+template <typename T, std::size_t Size, typename Components>
+struct memory_view_element<memory_vector_view<T*, Size, Components>> {
+    using view_type = vector_view<T const*, Size, Components>;
+
+    static constexpr view_type
+    get(T const* p, std::size_t index)
+    {
+        return view_type{p + index * Size};
+    }
+};
+
+template <typename T, typename Vector, std::size_t... Indexes>
+void
+store_vector(T* p, Vector const& v, std::index_sequence<Indexes...>)
+{
+    ((p[Indexes] = v.template at<Indexes>()), ...);
+}
+
+template <typename... Views>
+void
+check_memory_view_sizes(std::size_t size, Views const&... views)
+{
+    if (((views.size() != size) || ...))
+        throw std::runtime_error{"Memory vector views have different sizes"};
+}
+
+/**
+ * Store the result of the function component by component, the output
+ * buffer must not overlap the input buffers
+ */
+template <std::size_t Size, typename T, typename Function, typename... Views>
+void
+transform_direct(T* dst, std::size_t n, Function& func, Views const&... in)
+{
+    for (std::size_t i = 0; i < n; ++i, dst += Size) {
+        store_vector(dst, func(memory_view_element<Views>::get(in.data(), i)...),
+                     std::make_index_sequence<Size>{});
+    }
+}
+
+/**
+ * The memory of the output buffer overlaps one of the input buffers
+ */
+template <typename T, std::size_t Size, typename Components, typename... Views>
+bool
+memory_views_overlap(memory_vector_view<T*, Size, Components> const& out, Views const&... in)
+{
+    std::less<void const*> const less;
+    void const* const            begin = out.data();
+    void const* const            end   = out.data() + out.size() * Size;
+    auto const                   overlaps
+        = [&](void const* in_begin, void const* in_end) {
+              return less(in_begin, end) && less(begin, in_end);
+          };
+    return (overlaps(in.data(), in.data() + in.size() * in.component_count) || ...);
+}
+
+/**
+ * Fold the components of the buffer elements with the same index. The
+ * elements are folded into several independent sets of accumulators, which
+ * are combined at the end, so that the loop is not bound by the latency of
+ * a single dependency chain. The function must be associative and
+ * commutative, e.g. a minimum or a maximum.
+ */
+template <typename T, std::size_t Size, typename Components, typename Function>
+vector<std::remove_const_t<T>, Size, Components>
+reduce_buffer(memory_vector_view<T*, Size, Components> const& buf, Function func)
+{
+    using value_type                 = std::remove_const_t<T>;
+    constexpr std::size_t chains     = expr::s::detail::sum_accumulators;
+    constexpr std::size_t block_size = chains * Size;
+    if (buf.size() == 0)
+        throw std::runtime_error{"Cannot reduce an empty memory vector view"};
+
+    // Each set of accumulators is seeded with its own element, a buffer
+    // shorter than the number of sets is folded into the first set only
+    auto const n      = buf.size();
+    auto const seeded = n < chains ? 1 : chains;
+    auto       src    = buf.data();
+    value_type acc[block_size];
+    for (std::size_t c = 0; c < seeded * Size; ++c) {
+        acc[c] = src[c];
+    }
+    std::size_t i = seeded;
+    for (src += seeded * Size; i + chains <= n; i += chains, src += block_size) {
+        for (std::size_t c = 0; c < block_size; ++c) {
+            acc[c] = func(acc[c], src[c]);
+        }
+    }
+    for (; i < n; ++i, src += Size) {
+        for (std::size_t c = 0; c < Size; ++c) {
+            acc[c] = func(acc[c], src[c]);
+        }
+    }
+    for (std::size_t c = Size; c < seeded * Size; ++c) {
+        acc[c % Size] = func(acc[c % Size], acc[c]);
+    }
+    return vector<value_type, Size, Components>{acc};
+}
+
+}    // namespace detail
+
+/**
+ * Evaluate an expression for each element of one or more memory buffers and
+ * store the result to the output buffer.
+ *
+ * The function is called with a vector_view to the elements of the input
+ * buffers with the same index and must return a vector expression, e.g.
+ * @code
+ * transform(out, [s](auto a, auto b) { return a * s + b; }, a_view, b_view);
+ * @endcode
+ *
+ * The expression is evaluated once per element in a single loop over the
+ * buffers, the expression tree is resolved at compile time and is inlined
+ * into the loop body. When the output buffer doesn't overlap the input
+ * buffers, the result is stored directly to the output buffer component by
+ * component, so that the compiler can vectorize the loop across elements.
+ * The output buffer can be the same as one of the input buffers, then each
+ * element is evaluated in a SIMD register or to a temporary vector before
+ * it is stored.
+ *
+ * @param out Output buffer
+ * @param func Function building an expression
+ * @param in Input buffers, must be of the same size as the output buffer
+ */
+template <typename T, std::size_t Size, typename Components, typename Function,
+          typename... Views>
+void
+transform(memory_vector_view<T*, Size, Components> const& out, Function&& func,
+          Views const&... in)
+{
+    static_assert(!std::is_const<T>::value, "Cannot transform to a constant memory buffer");
+    using result_type = vector<T, Size, Components>;
+    using expression_type
+        = decltype(func(detail::memory_view_element<Views>::get(in.data(), 0)...));
+    static_assert(traits::is_vector_expression_v<expression_type>,
+                  "Transform function must return a vector expression");
+
+    detail::check_memory_view_sizes(out.size(), in...);
+
+    // Work with a copy of the function, so that the compiler can see that
+    // the captured values are not changed by the stores to the output buffer
+    std::decay_t<Function> fn{std::forward<Function>(func)};
+    auto const             n   = out.size();
+    auto                   dst = out.data();
+    constexpr bool direct_store = expr::v::detail::simd_plain_components_v<T, Components>;
+    if (direct_store && !detail::memory_views_overlap(out, in...)) {
+        detail::transform_direct<Size>(dst, n, fn, in...);
+    } else if constexpr (expr::simd_assignable_v<T, Size, Components, expression_type>) {
+        // The whole element is evaluated in a register before it is stored
+        if (out.is_aligned(simd::register_traits<T, Size>::alignment)) {
+            for (std::size_t i = 0; i < n; ++i, dst += Size) {
+                expr::simd_store_aligned(
+                    dst, fn(detail::memory_view_element<Views>::get(in.data(), i)...));
+            }
+        } else {
+            for (std::size_t i = 0; i < n; ++i, dst += Size) {
+                expr::simd_store(dst,
+                                 fn(detail::memory_view_element<Views>::get(in.data(), i)...));
+            }
+        }
+    } else {
+        for (std::size_t i = 0; i < n; ++i, dst += Size) {
+            // Evaluate to a temporary first, the output can alias the input
+            // or the components have value policies
+            result_type const res = fn(detail::memory_view_element<Views>::get(in.data(), i)...);
+            detail::store_vector(dst, res, std::make_index_sequence<Size>{});
+        }
+    }
+}
+
+/**
+ * Assign a vector expression to all elements of the buffer
+ * @param out Output buffer
+ * @param expr Vector expression
+ */
+template <typename T, std::size_t Size, typename Components, typename Expression,
+          typename = traits::enable_if_vector_expression<Expression>>
+void
+assign(memory_vector_view<T*, Size, Components> const& out, Expression const& expr)
+{
+    static_assert(!std::is_const<T>::value, "Cannot assign to a constant memory buffer");
+    vector<T, Size, Components> const val = expr;
+
+    auto const n   = out.size();
+    auto       dst = out.data();
+    for (std::size_t i = 0; i < n; ++i, dst += Size) {
+        detail::store_vector(dst, val, std::make_index_sequence<Size>{});
+    }
+}
+
+/**
+ * Normalize all vectors in the buffer in place.
+ *
+ * The magnitude is computed once per element.
+ * @param buf Buffer of vectors
+ */
+template <typename T, std::size_t Size, typename Components>
+void
+normalize(memory_vector_view<T*, Size, Components> const& buf)
+{
+    transform(buf, [](auto v) { return normalize(v); }, buf);
+}
+
+/**
+ * Clamp the components of all vectors in the buffer in place.
+ *
+ * @param buf Buffer of vectors
+ * @param low Lower bound, a vector or a scalar for all components
+ * @param high Upper bound, a vector or a scalar for all components
+ */
+template <typename T, std::size_t Size, typename Components, typename Low, typename High>
+void
+clamp(memory_vector_view<T*, Size, Components> const& buf, Low const& low, High const& high)
+{
+    transform(buf, [&low, &high](auto v) { return clamp(v, low, high); }, buf);
+}
+
+/**
+ * Component-wise minimum of all vectors in the buffer, e.g. the lower corner
+ * of the bounding box of a buffer of points.
+ *
+ * @param buf Buffer of vectors
+ * @throws std::runtime_error if the buffer is empty
+ */
+template <typename T, std::size_t Size, typename Components>
+vector<std::remove_const_t<T>, Size, Components>
+component_min(memory_vector_view<T*, Size, Components> const& buf)
+{
+    return detail::reduce_buffer(buf, expr::v::detail::minimum{});
+}
+
+/**
+ * Component-wise maximum of all vectors in the buffer, e.g. the upper corner
+ * of the bounding box of a buffer of points.
+ *
+ * @param buf Buffer of vectors
+ * @throws std::runtime_error if the buffer is empty
+ */
+template <typename T, std::size_t Size, typename Components>
+vector<std::remove_const_t<T>, Size, Components>
+component_max(memory_vector_view<T*, Size, Components> const& buf)
+{
+    return detail::reduce_buffer(buf, expr::v::detail::maximum{});
+}
+
+}    // namespace math
+}    // namespace psst
+
+#endif /* PSST_MATH_VECTOR_TRANSFORM_HPP_ */
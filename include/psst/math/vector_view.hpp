@@ -9,6 +9,7 @@
 #ifndef PSST_MATH_VECTOR_VIEW_HPP_
 #define PSST_MATH_VECTOR_VIEW_HPP_
 
+#include <psst/math/detail/alignment.hpp>
 #include <psst/math/detail/vector_expressions.hpp>
 
 #include <iterator>
@@ -16,8 +17,6 @@
 namespace psst {
 namespace math {
 
-// TODO Deal with alignment stuff
-
 // Mutating vector_view
 template <typename T, std::size_t Size, typename Components>
 struct vector_view<T*, Size, Components>
@@ -65,6 +64,15 @@ struct vector_view<T*, Size, Components>
     {
         return data_;
     }
+    /**
+     * Alignment of the memory the view refers to
+     * @see utils::pointer_alignment
+     */
+    std::size_t
+    alignment() const
+    {
+        return utils::pointer_alignment(data_);
+    }
 
     template <std::size_t N>
     typename value_policy<N>::accessor_type
@@ -190,6 +198,15 @@ struct vector_view<T const*, Size, Components>
     {
         return data_;
     }
+    /**
+     * Alignment of the memory the view refers to
+     * @see utils::pointer_alignment
+     */
+    std::size_t
+    alignment() const
+    {
+        return utils::pointer_alignment(data_);
+    }
 
     template <std::size_t N>
     constexpr const_reference
@@ -259,12 +276,12 @@ struct memory_vector_view<T*, Size, Components> {
     static constexpr std::size_t element_size    = sizeof(T) * component_count;
 
     template <typename P>
-    struct base_iterator : std::iterator<std::random_access_iterator_tag, view_type, std::ptrdiff_t,
-                                         view_type, view_type> {
-        using base_type = std::iterator<std::random_access_iterator_tag, view_type, std::ptrdiff_t,
-                                        view_type, view_type>;
-        using difference_type = typename base_type::difference_type;
-        using value_type      = typename base_type::value_type;
+    struct base_iterator {
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = view_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = utils::arrow_proxy<value_type>;
+        using reference         = value_type;
 
         base_iterator(P p) : p_{p} {}
 
@@ -340,7 +357,7 @@ struct memory_vector_view<T*, Size, Components> {
         }
 
         value_type operator*() const { return value_type{p_}; }
-        value_type operator->() const { return value_type{p_}; }
+        pointer operator->() const { return pointer{value_type{p_}}; }
 
     private:
         P p_;
@@ -356,6 +373,25 @@ struct memory_vector_view<T*, Size, Components> {
             throw std::runtime_error{"The size of buffer is not a multiple of components"};
     }
 
+    /**
+     * Alignment of all vectors in the buffer, detected from the address of
+     * the buffer and the element stride. Is a power of two not greater than
+     * utils::max_alignment.
+     */
+    std::size_t
+    alignment() const
+    {
+        return utils::array_alignment(buffer_, element_size);
+    }
+    /**
+     * All vectors in the buffer are aligned to the alignment
+     */
+    bool
+    is_aligned(std::size_t alignment) const
+    {
+        return this->alignment() >= alignment;
+    }
+
     /**
      * Is the memory empty
      * @return
@@ -378,7 +414,16 @@ struct memory_vector_view<T*, Size, Components> {
 
     constexpr view_type operator[](std::size_t index) const
     {
-        return view_type{buffer_ + index * element_size};
+        return view_type{buffer_ + index * component_count};
+    }
+
+    /**
+     * Pointer to the beginning of the buffer
+     */
+    constexpr pointer_type
+    data() const
+    {
+        return buffer_;
     }
 
     constexpr iterator
@@ -0,0 +1,120 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * affine_matrix_tests.cpp
+ *
+ *  Created on: Feb 11, 2019
+ *      Author: ser-fedorov
+ */
+
+#include "test_printing.hpp"
+#include <psst/math/affine_matrix.hpp>
+
+#include <gtest/gtest.h>
+
+namespace psst {
+namespace math {
+namespace test {
+
+using affinef    = affine_matrix<float>;
+using affined    = affine_matrix<double>;
+using vector3f   = vector<float, 3>;
+using vector3d   = vector<double, 3>;
+using vector4d   = vector<double, 4>;
+using matrix3x3d = matrix<double, 3, 3>;
+using matrix4x4f = matrix<float, 4, 4>;
+using matrix4x4d = matrix<double, 4, 4>;
+
+namespace {
+
+// Rotate 90 degrees around z, scale by (2, 4, 0.5) and translate by
+// (1, 2, 3)
+// clang-format off
+affined const transform{
+    { 0, -4, 0,   1 },
+    { 2,  0, 0,   2 },
+    { 0,  0, 0.5, 3 }
+};
+affined const rigid{
+    { 0, -1, 0,  1 },
+    { 1,  0, 0, -2 },
+    { 0,  0, 1,  5 }
+};
+// clang-format on
+
+}    // namespace
+
+TEST(AffineMatrix, Construct)
+{
+    static_assert(sizeof(affinef) == sizeof(float) * 12, "Affine matrix stores 3x4 elements");
+
+    EXPECT_EQ(affinef::identity().to_matrix(), matrix4x4f::identity());
+
+    matrix4x4d full = transform;
+    EXPECT_EQ((vector4d{0, 0, 0, 1}), full[3]);
+    EXPECT_EQ(transform, affined{full});
+    EXPECT_EQ(transform, affined{transform.compact()});
+    EXPECT_EQ(transform, (affined{transform.linear(), transform.translation()}));
+    EXPECT_EQ((matrix3x3d{{0, -4, 0}, {2, 0, 0}, {0, 0, 0.5}}), transform.linear());
+    EXPECT_EQ((vector3d{1, 2, 3}), transform.translation());
+    EXPECT_EQ(transform.data(), transform.compact().data());
+
+    // From a matrix expression
+    EXPECT_EQ(transform, affined{full * matrix4x4d::identity()});
+}
+
+TEST(AffineMatrix, Compose)
+{
+    matrix4x4d const full_t = transform;
+    matrix4x4d const full_r = rigid;
+    matrix4x4d const tr     = full_t * full_r;
+    matrix4x4d const rt     = full_r * full_t;
+    EXPECT_EQ(affined{tr}, transform * rigid);
+    EXPECT_EQ(affined{rt}, rigid * transform);
+    EXPECT_EQ(tr, static_cast<matrix4x4d>(transform * rigid));
+
+    auto m = transform;
+    m *= affined::identity();
+    EXPECT_EQ(transform, m);
+    m *= rigid;
+    EXPECT_EQ(transform * rigid, m);
+    EXPECT_NE(transform, m);
+}
+
+TEST(AffineMatrix, Transform)
+{
+    vector3d const p{1, 2, 3};
+    EXPECT_EQ((vector3d{-7, 4, 4.5}), transform_point(transform, p));
+    EXPECT_EQ((vector3d{-8, 2, 1.5}), transform_vector(transform, p));
+
+    matrix4x4d const full = transform;
+    vector4d const   hp   = as_vector(full * vector4d{1, 2, 3, 1});
+    EXPECT_EQ((vector3d{hp[0], hp[1], hp[2]}), transform_point(transform, p));
+}
+
+TEST(AffineMatrix, Inverse)
+{
+    auto const inv = inverse(transform);
+    EXPECT_EQ(affined::identity(), inv * transform);
+    EXPECT_EQ(affined{affine_inverse(matrix4x4d{transform})}, inv);
+    vector3d const p{1, 2, 3};
+    EXPECT_EQ(p, transform_point(inv, transform_point(transform, p)));
+
+    auto const rinv = rigid_inverse(rigid);
+    EXPECT_EQ(affined::identity(), rinv * rigid);
+    EXPECT_EQ(inverse(rigid), rinv);
+
+    auto singular  = transform;
+    singular[2][2] = 0;
+    EXPECT_THROW(inverse(singular), std::runtime_error);
+
+    // The determinant of the linear part is a rounding error, not zero
+    affined const near_singular{matrix3x3d{{.1, .2, .3}, {.4, .5, .6}, {.7, .8, .9}},
+                                vector3d{1, 2, 3}};
+    EXPECT_THROW(inverse(near_singular), std::runtime_error);
+    EXPECT_THROW(affine_inverse(matrix4x4d{near_singular}), std::runtime_error);
+    EXPECT_THROW(inverse(matrix4x4d{near_singular}), std::runtime_error);
+}
+
+}    // namespace test
+}    // namespace math
+}    // namespace psst
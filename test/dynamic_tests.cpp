@@ -0,0 +1,201 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * dynamic_tests.cpp
+ *
+ *  Created on: Feb 8, 2019
+ *      Author: ser-fedorov
+ */
+
+#include "test_printing.hpp"
+#include <psst/math/dynamic_matrix.hpp>
+
+#include <gtest/gtest.h>
+
+#include <tuple>
+
+namespace psst {
+namespace math {
+namespace test {
+
+using dvector = dynamic_vector<double>;
+using dmatrix = dynamic_matrix<double>;
+
+static_assert(traits::is_dynamic_vector_expression_v<dvector>, "");
+static_assert(traits::is_dynamic_matrix_expression_v<dmatrix>, "");
+static_assert(!traits::is_vector_expression_v<dvector>, "");
+static_assert(!traits::is_scalar_v<dvector>, "");
+
+// Element-wise dynamic expressions are the fixed size expression templates
+template <typename T>
+struct is_vector_sum : std::false_type {};
+template <typename LHS, typename RHS>
+struct is_vector_sum<expr::vector_sum<LHS, RHS>> : std::true_type {};
+template <typename T>
+struct is_matrix_scalar_multiply : std::false_type {};
+template <typename LHS, typename RHS>
+struct is_matrix_scalar_multiply<expr::matrix_scalar_multiply<LHS, RHS>> : std::true_type {};
+
+static_assert(is_vector_sum<decltype(std::declval<dvector>() + std::declval<dvector>())>::value,
+              "");
+static_assert(is_matrix_scalar_multiply<decltype(std::declval<dmatrix>() * 2.0)>::value, "");
+static_assert(traits::is_dynamic_vector_expression_v<decltype(std::declval<dvector>() * 2.0)>,
+              "");
+
+TEST(DynamicVector, Construct)
+{
+    dvector v1(5);
+    EXPECT_EQ(5, v1.size());
+    for (auto v : v1) {
+        EXPECT_EQ(0, v);
+    }
+    dvector v2{1, 2, 3};
+    EXPECT_EQ(3, v2.size());
+    EXPECT_EQ(2, v2[1]);
+
+    dvector v3{vector<double, 3>{1, 2, 3}};
+    EXPECT_EQ(v2, v3);
+    EXPECT_NE(v1, v2);
+}
+
+TEST(DynamicVector, Expressions)
+{
+    dvector a{1, 2, 3, 4};
+    dvector b{4, 3, 2, 1};
+
+    EXPECT_EQ((dvector{5, 5, 5, 5}), a + b);
+    EXPECT_EQ((dvector{-3, -1, 1, 3}), a - b);
+    EXPECT_EQ((dvector{-1, -2, -3, -4}), -a);
+    EXPECT_EQ((dvector{2, 4, 6, 8}), a * 2);
+    EXPECT_EQ((dvector{2, 4, 6, 8}), 2 * a);
+    EXPECT_EQ((dvector{0.5, 1, 1.5, 2}), a / 2);
+    EXPECT_EQ((dvector{7, 7, 7, 7}), a + b * 2 - a * 0 + dvector(4, -3) - (-a));
+    EXPECT_EQ(20, dot_product(a, b));
+    EXPECT_EQ(20, a | b);
+    EXPECT_EQ(30, magnitude_square(a));
+    EXPECT_DOUBLE_EQ(1, magnitude(normalize(a)));
+
+    dvector c = eval(a + b);
+    c += a;
+    EXPECT_EQ((dvector{6, 7, 8, 9}), c);
+    c = c - a * 2;
+    EXPECT_EQ((dvector{4, 3, 2, 1}), c);
+
+    EXPECT_THROW(a + dvector(3), std::runtime_error);
+    EXPECT_THROW(dot_product(a, dvector(5)), std::runtime_error);
+
+    // Sizes that are not a multiple of the number of accumulators
+    dvector d(7, 2);
+    dvector e{1, 2, 3, 4, 5, 6, 7};
+    EXPECT_EQ(56, dot_product(d, e));
+    EXPECT_EQ(140, magnitude_square(e));
+    EXPECT_EQ(1, magnitude_square(dvector(1, 1)));
+}
+
+TEST(DynamicMatrix, Construct)
+{
+    dmatrix m1(2, 3);
+    EXPECT_EQ(2, m1.rows());
+    EXPECT_EQ(3, m1.cols());
+    EXPECT_EQ(0, m1[1][2]);
+
+    dmatrix m2{{1, 2, 3}, {4, 5, 6}};
+    EXPECT_EQ(6, m2[1][2]);
+    EXPECT_EQ(6, m2.element(1, 2));
+
+    dmatrix m3{matrix<double, 2, 3>{{1, 2, 3}, {4, 5, 6}}};
+    EXPECT_EQ(m2, m3);
+    EXPECT_NE(m1, m2);
+    EXPECT_THROW((dmatrix{{1, 2}, {3}}), std::runtime_error);
+
+    EXPECT_EQ((dmatrix{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}), dmatrix::identity(3));
+}
+
+TEST(DynamicMatrix, Expressions)
+{
+    dmatrix a{{1, 2, 3}, {4, 5, 6}};
+    dmatrix b{{6, 5, 4}, {3, 2, 1}};
+
+    EXPECT_EQ((dmatrix{{7, 7, 7}, {7, 7, 7}}), a + b);
+    EXPECT_EQ((dmatrix{{-5, -3, -1}, {1, 3, 5}}), a - b);
+    EXPECT_EQ((dmatrix{{2, 4, 6}, {8, 10, 12}}), a * 2);
+    EXPECT_EQ((dmatrix{{2, 4, 6}, {8, 10, 12}}), 2 * a);
+    EXPECT_EQ((dmatrix{{0.5, 1, 1.5}, {2, 2.5, 3}}), a / 2);
+    EXPECT_EQ(-a, a * -1);
+    EXPECT_EQ((dmatrix{{1, 4}, {2, 5}, {3, 6}}), transpose(a));
+
+    EXPECT_EQ((dmatrix{{14, 32}, {32, 77}}), a * transpose(a));
+    EXPECT_EQ(a, dmatrix::identity(2) * a * dmatrix::identity(3));
+    EXPECT_EQ((dmatrix{{28, 64}, {64, 154}}), a * transpose(a) * 2);
+    EXPECT_EQ((dvector{14, 32}), a * dvector({1, 2, 3}));
+    EXPECT_EQ((dvector{28, 64}), (a + a) * dvector({1, 2, 3}));
+
+    dmatrix c = a;
+    c         = transpose(c) * c;
+    EXPECT_EQ(3, c.rows());
+    EXPECT_EQ(3, c.cols());
+    EXPECT_EQ((dmatrix{{17, 22, 27}, {22, 29, 36}, {27, 36, 45}}), c);
+
+    EXPECT_THROW(a * a, std::runtime_error);
+    EXPECT_THROW(a + transpose(a), std::runtime_error);
+    EXPECT_THROW(a * dvector(2), std::runtime_error);
+}
+
+TEST(DynamicMatrix, AliasedUpdate)
+{
+    dmatrix const n{{1, 1}, {1, 1}};
+
+    dmatrix m{{1, 2}, {3, 4}};
+    m += transpose(m);
+    EXPECT_EQ((dmatrix{{2, 5}, {5, 8}}), m);
+    m -= transpose(m);
+    EXPECT_EQ((dmatrix{{0, 0}, {0, 0}}), m);
+
+    dmatrix a{{1, 2}, {3, 4}};
+    a += a * n;
+    EXPECT_EQ((dmatrix{{4, 5}, {10, 11}}), a);
+    a += a * 2;
+    EXPECT_EQ((dmatrix{{12, 15}, {30, 33}}), a);
+
+    dvector v{1, 1};
+    v += n * v;
+    EXPECT_EQ((dvector{3, 3}), v);
+    v -= n * v;
+    EXPECT_EQ((dvector{-3, -3}), v);
+    v -= -v;
+    EXPECT_EQ((dvector{-6, -6}), v);
+}
+
+TEST(DynamicMatrix, BlockedProduct)
+{
+    // Sizes cross the block boundaries of the blocked multiply
+    for (auto [m, k, n] : {std::make_tuple(67, 260, 35), std::make_tuple(5, 3, 1030)}) {
+        dmatrix a(m, k);
+        dmatrix b(k, n);
+        for (std::size_t r = 0; r < a.rows(); ++r) {
+            for (std::size_t c = 0; c < a.cols(); ++c) {
+                a[r][c] = static_cast<double>((r * 5 + c * 3) % 11) - 5;
+            }
+        }
+        for (std::size_t r = 0; r < b.rows(); ++r) {
+            for (std::size_t c = 0; c < b.cols(); ++c) {
+                b[r][c] = static_cast<double>((r * 2 + c * 7) % 13) - 6;
+            }
+        }
+        dmatrix res = a * b;
+        ASSERT_EQ(m, res.rows());
+        ASSERT_EQ(n, res.cols());
+        for (std::size_t r = 0; r < res.rows(); ++r) {
+            for (std::size_t c = 0; c < res.cols(); ++c) {
+                double expected = 0;
+                for (std::size_t i = 0; i < a.cols(); ++i) {
+                    expected += a[r][i] * b[i][c];
+                }
+                ASSERT_EQ(expected, res[r][c]) << r << ", " << c;
+            }
+        }
+    }
+}
+
+}    // namespace test
+}    // namespace math
+}    // namespace psst
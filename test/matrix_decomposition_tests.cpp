@@ -0,0 +1,174 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * matrix_decomposition_tests.cpp
+ *
+ *  Created on: Feb 6, 2019
+ *      Author: ser-fedorov
+ */
+
+#include "test_printing.hpp"
+#include <psst/math/matrix_decomposition.hpp>
+
+#include <gtest/gtest.h>
+
+namespace psst {
+namespace math {
+namespace test {
+
+using vector3d  = vector<double, 3>;
+using matrix3x3 = matrix<double, 3, 3>;
+using matrix4x4 = matrix<double, 4, 4>;
+using matrix4x2 = matrix<double, 4, 2>;
+
+TEST(MatrixDecomposition, LU)
+{
+    // clang-format off
+    matrix4x4 a{
+        { 1, 0, 2, -1 },
+        { 3, 0, 0,  5 },
+        { 2, 1, 4, -3 },
+        { 1, 0, 5,  0 }
+    };
+    // clang-format on
+    lu_decomposition lu{a};
+    EXPECT_FALSE(lu.singular());
+    EXPECT_EQ(lu.p() * a, lu.lower() * lu.upper());
+    EXPECT_DOUBLE_EQ(det(a), lu.determinant());
+    EXPECT_EQ(inverse(a), lu.inverse());
+
+    vector<double, 4> b{1, 2, 3, 4};
+    auto              x = lu.solve(b);
+    EXPECT_EQ(as_col_matrix(b), a * x);
+
+    matrix<double, 4, 2> bm{{1, 0}, {2, 1}, {3, 0}, {4, 1}};
+    auto                 xm = lu.solve(bm);
+    EXPECT_EQ(bm, a * xm);
+
+    // Rows of a column-major matrix are swapped element by element
+    lu_decomposition col_lu{col_major_matrix<double, 4, 4>{a}};
+    EXPECT_EQ(lu.lower(), col_lu.lower());
+    EXPECT_EQ(lu.upper(), col_lu.upper());
+    EXPECT_EQ(x, col_lu.solve(b));
+
+    // Numerically singular, the last pivot is roundoff that depends on the
+    // floating point contraction
+    for (auto const& m : {matrix3x3{{11, 12, 13}, {21, 22, 23}, {31, 32, 33}},
+                          matrix3x3{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}}) {
+        lu_decomposition singular{m};
+        EXPECT_TRUE(singular.singular());
+        EXPECT_EQ(0, singular.determinant());
+        EXPECT_THROW(singular.solve(vector3d{1, 2, 4}), std::runtime_error);
+        EXPECT_THROW(singular.inverse(), std::runtime_error);
+        EXPECT_EQ(singular.p() * m, singular.lower() * singular.upper());
+    }
+
+    // The first column is negligible relative to the rows, it is still
+    // eliminated
+    matrix3x3 const negligible{{1e-14, 1e3, 0}, {1e-14, 0, 1e3}, {0, 1, 1}};
+    lu_decomposition singular{negligible};
+    EXPECT_TRUE(singular.singular());
+    EXPECT_EQ(0, singular.determinant());
+    EXPECT_EQ(singular.p() * negligible, singular.lower() * singular.upper());
+}
+
+TEST(MatrixDecomposition, ConstexprLU)
+{
+    constexpr matrix3x3        a{{0, 2, 0}, {4, 0, 0}, {0, 0, 1}};
+    constexpr lu_decomposition lu{a};
+    static_assert(!lu.singular());
+    static_assert(lu.permutation()[0] == 1);
+    static_assert(lu.determinant() == -8);
+    constexpr auto x = lu.solve(vector3d{2, 4, 1});
+    static_assert(x[0] == 1 && x[1] == 1 && x[2] == 1);
+    static_assert(expr::m::detail::lu_determinant(a) == -8);
+}
+
+TEST(MatrixDecomposition, ScaledRows)
+{
+    // A small row or column is not singular
+    auto m  = matrix<double, 5, 5>::identity();
+    m[1][1] = 1e-20;
+
+    lu_decomposition lu{m};
+    EXPECT_FALSE(lu.singular());
+    EXPECT_DOUBLE_EQ(1e-20, lu.determinant());
+    EXPECT_DOUBLE_EQ(1e20, lu.inverse()[1][1]);
+
+    lu_decomposition lu3{matrix3x3{{1, 0, 0}, {0, 1e-20, 0}, {0, 0, 1}}};
+    EXPECT_FALSE(lu3.singular());
+
+    qr_decomposition qr{m};
+    EXPECT_TRUE(qr.full_rank());
+    EXPECT_DOUBLE_EQ(1e20, qr.solve(vector<double, 5>{0, 1, 0, 0, 0})[1]);
+}
+
+TEST(MatrixDecomposition, QR)
+{
+    matrix3x3 a{{1, 2, 0}, {0, 1, 1}, {1, 0, 1}};
+    qr_decomposition qr{a};
+    EXPECT_TRUE(qr.full_rank());
+    auto q = qr.q();
+    auto r = qr.r();
+    EXPECT_EQ(a, q * r);
+    EXPECT_EQ(matrix3x3::identity(), transpose(q) * q);
+    EXPECT_EQ(0, r[1][0]);
+    EXPECT_EQ(0, r[2][0]);
+    EXPECT_EQ(0, r[2][1]);
+
+    vector3d b{1, 2, 3};
+    EXPECT_EQ(as_col_matrix(b), a * qr.solve(b));
+
+    // Least squares line fit through points that lie on y = 2x + 1
+    // clang-format off
+    matrix4x2 fit{
+        { 0, 1 },
+        { 1, 1 },
+        { 2, 1 },
+        { 3, 1 }
+    };
+    // clang-format on
+    qr_decomposition ls{fit};
+    auto             line = ls.solve(vector<double, 4>{1, 3, 5, 7});
+    EXPECT_NEAR(2, line[0], 1e-12);
+    EXPECT_NEAR(1, line[1], 1e-12);
+    EXPECT_EQ(fit, ls.q() * ls.r());
+
+    for (auto const& m : {matrix3x3{{1, 2, 3}, {2, 4, 6}, {1, 1, 1}},
+                          matrix3x3{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}}) {
+        qr_decomposition deficient{m};
+        EXPECT_FALSE(deficient.full_rank());
+        EXPECT_THROW(deficient.solve(b), std::runtime_error);
+    }
+}
+
+TEST(MatrixDecomposition, Cholesky)
+{
+    matrix3x3 a{{4, 12, -16}, {12, 37, -43}, {-16, -43, 98}};
+    cholesky_decomposition ch{a};
+    EXPECT_TRUE(ch.positive_definite());
+    EXPECT_EQ((matrix3x3{{2, 0, 0}, {6, 1, 0}, {-8, 5, 3}}), ch.lower());
+    EXPECT_EQ(a, ch.lower() * transpose(ch.lower()));
+    EXPECT_DOUBLE_EQ(det(a), ch.determinant());
+
+    vector3d b{0, 6, 39};
+    EXPECT_EQ((vector3d{1, 1, 1}), ch.solve(b));
+    EXPECT_EQ((matrix<double, 3, 2>{{1, 2}, {1, 2}, {1, 2}}),
+              ch.solve(matrix<double, 3, 2>{{0, 0}, {6, 12}, {39, 78}}));
+
+    cholesky_decomposition indefinite{matrix3x3{{1, 2, 0}, {2, 1, 0}, {0, 0, 1}}};
+    EXPECT_FALSE(indefinite.positive_definite());
+    EXPECT_THROW(indefinite.solve(b), std::runtime_error);
+    EXPECT_DOUBLE_EQ(-3, indefinite.determinant());
+
+    // Numerically semidefinite, the last pivot is roundoff
+    matrix3x3 const semidefinite{{.1, .2, .3}, {.2, .5, .7}, {.3, .7, 1}};
+    cholesky_decomposition singular{semidefinite};
+    EXPECT_FALSE(singular.positive_definite());
+    EXPECT_THROW(singular.solve(b), std::runtime_error);
+    EXPECT_EQ(lu_decomposition{semidefinite}.determinant(), singular.determinant());
+    EXPECT_EQ(0, singular.determinant());
+}
+
+}    // namespace test
+}    // namespace math
+}    // namespace psst
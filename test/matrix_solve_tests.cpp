@@ -0,0 +1,241 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * matrix_solve_tests.cpp
+ *
+ *  Created on: Feb 7, 2019
+ *      Author: ser-fedorov
+ */
+
+#include "test_printing.hpp"
+#include <psst/math/matrix_solve.hpp>
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <vector>
+
+namespace psst {
+namespace math {
+namespace test {
+
+using vector3d  = vector<double, 3>;
+using vector4f  = vector<float, 4>;
+using matrix3x3 = matrix<double, 3, 3>;
+using matrix4x4 = matrix<float, 4, 4>;
+
+TEST(MatrixSolve, Single)
+{
+    matrix3x3 a{{2, 1, -1}, {-3, -1, 2}, {-2, 1, 2}};
+    EXPECT_EQ((vector3d{2, 3, -1}), solve(a, vector3d{8, -11, -3}));
+    EXPECT_EQ((vector3d{2, 3, -1}), solve(transpose(transpose(a)), vector3d{4, -5.5, -1.5} * 2));
+    EXPECT_EQ((matrix<double, 3, 2>{{2, 1}, {3, 0}, {-1, 0}}),
+              solve(a, matrix<double, 3, 2>{{8, 2}, {-11, -3}, {-3, -2}}));
+
+    matrix<double, 2, 2> a2{{4, 3}, {6, 3}};
+    EXPECT_EQ((vector<double, 2>{1, 2}), solve(a2, vector<double, 2>{10, 12}));
+
+    matrix<double, 5, 5> a5;
+    for (std::size_t r = 0; r < 5; ++r) {
+        a5[r][r] = r + 1;
+    }
+    EXPECT_EQ((vector<double, 5>{1, 1, 1, 1, 1}), solve(a5, vector<double, 5>{1, 2, 3, 4, 5}));
+
+    // Numerically singular, the pivots are roundoff that depends on the
+    // floating point contraction
+    EXPECT_THROW(solve(matrix3x3{{11, 12, 13}, {21, 22, 23}, {31, 32, 33}}, vector3d{1, 2, 3}),
+                 std::runtime_error);
+    EXPECT_THROW(solve(matrix3x3{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}, vector3d{1, 2, 4}),
+                 std::runtime_error);
+    EXPECT_THROW(solve(matrix3x3{{.1, .2, .3}, {.4, .5, .6}, {.7, .8, .9}}, vector3d{1, 2, 4}),
+                 std::runtime_error);
+
+    // NaN and infinite elements, also off the diagonal where the
+    // elimination doesn't reach them
+    auto const nan = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_THROW(solve(matrix<double, 2, 2>{{1, nan}, {0, 1}}, vector<double, 2>{1, 1}),
+                 std::runtime_error);
+    EXPECT_THROW(solve(matrix3x3{{nan, 1, 0}, {0, 1, 0}, {0, 0, 1}}, vector3d{1, 2, 3}),
+                 std::runtime_error);
+    auto a5inf  = a5;
+    a5inf[4][0] = std::numeric_limits<double>::infinity();
+    EXPECT_THROW(solve(a5inf, vector<double, 5>{1, 2, 3, 4, 5}), std::runtime_error);
+}
+
+TEST(MatrixSolve, Batch)
+{
+    // clang-format off
+    matrix4x4 a{
+        { 1, 0, 2, -1 },
+        { 3, 0, 0,  5 },
+        { 2, 1, 4, -3 },
+        { 1, 0, 5,  0 }
+    };
+    // clang-format on
+    // Not a multiple of the lane count
+    constexpr std::size_t count = 13;
+    std::vector<matrix4x4> as;
+    std::vector<vector4f>  xs;
+    std::vector<vector4f>  bs;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const f = static_cast<float>(i);
+        as.push_back(a + matrix4x4::identity() * f);
+        xs.push_back(vector4f{f, 1, -f, 2});
+        vector4f b;
+        for (std::size_t r = 0; r < 4; ++r) {
+            b[r] = dot_product(as.back()[r], xs.back());
+        }
+        bs.push_back(b);
+    }
+    std::vector<vector4f> out(count);
+
+    auto const buf_size = vector4f::size * count;
+    auto out_view = make_memory_vector_view<vector4f>(out.data()->data(), buf_size);
+    auto b_view
+        = make_memory_vector_view<vector4f>(static_cast<float const*>(bs.data()->data()), buf_size);
+    solve(out_view, as, b_view);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const single = solve(as[i], bs[i]);
+        for (std::size_t r = 0; r < 4; ++r) {
+            EXPECT_NEAR(xs[i][r], out[i][r], 1e-4) << i;
+            EXPECT_NEAR(xs[i][r], single[r], 1e-4) << i;
+        }
+    }
+
+    std::vector<vector4f> small(1);
+    EXPECT_THROW(solve(make_memory_vector_view<vector4f>(small.data()->data(), 4), as, b_view),
+                 std::runtime_error);
+    std::vector<matrix4x4> fewer(as.begin(), as.end() - 1);
+    EXPECT_THROW(solve(out_view, fewer, b_view), std::runtime_error);
+    as[10] = matrix4x4{};
+    EXPECT_THROW(solve(out_view, as, b_view), std::runtime_error);
+}
+
+TEST(MatrixSolve, BatchSingular)
+{
+    // The closed form determinant of a numerically singular matrix is
+    // roundoff, not zero
+    std::vector<matrix3x3> as(5, matrix3x3{{2, 1, -1}, {-3, -1, 2}, {-2, 1, 2}});
+    std::vector<vector3d>  bs(as.size(), vector3d{8, -11, -3});
+    std::vector<vector3d>  out(as.size());
+    auto out_view = make_memory_vector_view<vector3d>(out.data()->data(), out.size() * 3);
+    auto b_view   = make_memory_vector_view<vector3d>(static_cast<double const*>(bs.data()->data()),
+                                                    bs.size() * 3);
+    solve(out_view, as, b_view);
+    for (auto const& x : out) {
+        EXPECT_NEAR(2, x[0], 1e-12);
+        EXPECT_NEAR(3, x[1], 1e-12);
+        EXPECT_NEAR(-1, x[2], 1e-12);
+    }
+
+    for (auto const& m : {matrix3x3{{11, 12, 13}, {21, 22, 23}, {31, 32, 33}},
+                          matrix3x3{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}},
+                          matrix3x3{{.1, .2, .3}, {.4, .5, .6}, {.7, .8, .9}}}) {
+        as[3] = m;
+        EXPECT_THROW(solve(out_view, as, b_view), std::runtime_error);
+    }
+
+    // A NaN or an infinite element doesn't pass as a pivot
+    auto const nan = std::numeric_limits<double>::quiet_NaN();
+    auto const inf = std::numeric_limits<double>::infinity();
+    for (auto const& m : {matrix3x3{{2, 1, -1}, {-3, nan, 2}, {-2, 1, 2}},
+                          matrix3x3{{nan, 1, -1}, {-3, -1, 2}, {-2, 1, 2}},
+                          matrix3x3{{2, 1, -1}, {-3, -1, 2}, {-2, 1, inf}}}) {
+        as[3] = m;
+        EXPECT_THROW(solve(out_view, as, b_view), std::runtime_error);
+    }
+}
+
+TEST(MatrixSolve, IllConditioned)
+{
+    // Hilbert matrix, the condition number is about 1.5e4
+    using matrix4x4d = matrix<double, 4, 4>;
+    using vector4d   = vector<double, 4>;
+    matrix4x4d a;
+    for (std::size_t r = 0; r < 4; ++r) {
+        for (std::size_t c = 0; c < 4; ++c) {
+            a[r][c] = 1.0 / (r + c + 1);
+        }
+    }
+    vector4d const expected{1, -2, 3, -4};
+    vector4d       b;
+    for (std::size_t r = 0; r < 4; ++r) {
+        b[r] = dot_product(a[r], expected);
+    }
+
+    auto const x = solve(a, b);
+    for (std::size_t r = 0; r < 4; ++r) {
+        EXPECT_NEAR(expected[r], x[r], 1e-10) << r;
+    }
+
+    std::vector<matrix4x4d> as(3, a);
+    std::vector<vector4d>   bs(as.size(), b);
+    std::vector<vector4d>   out(as.size());
+    auto out_view = make_memory_vector_view<vector4d>(out.data()->data(), out.size() * 4);
+    auto b_view   = make_memory_vector_view<vector4d>(static_cast<double const*>(bs.data()->data()),
+                                                    bs.size() * 4);
+    solve(out_view, as, b_view);
+    for (auto const& v : out) {
+        for (std::size_t r = 0; r < 4; ++r) {
+            EXPECT_NEAR(expected[r], v[r], 1e-10) << r;
+        }
+    }
+}
+
+TEST(MatrixSolve, IllConditionedBatch)
+{
+    // Hilbert matrix in single precision, the batch pivots as the single
+    // system solve does and is as accurate
+    matrix4x4 a;
+    for (std::size_t r = 0; r < 4; ++r) {
+        for (std::size_t c = 0; c < 4; ++c) {
+            a[r][c] = 1.0f / (r + c + 1);
+        }
+    }
+    vector4f const expected{1, -2, 3, -4};
+    vector4f       b;
+    for (std::size_t r = 0; r < 4; ++r) {
+        b[r] = dot_product(a[r], expected);
+    }
+    auto const single = solve(a, b);
+
+    // A full block and a partial one
+    std::vector<matrix4x4> as(detail::solve_batch_block_size + 3, a);
+    std::vector<vector4f>  bs(as.size(), b);
+    std::vector<vector4f>  out(as.size());
+    auto out_view = make_memory_vector_view<vector4f>(out.data()->data(), out.size() * 4);
+    auto b_view   = make_memory_vector_view<vector4f>(static_cast<float const*>(bs.data()->data()),
+                                                    bs.size() * 4);
+    solve(out_view, as, b_view);
+    for (auto const& v : out) {
+        for (std::size_t r = 0; r < 4; ++r) {
+            EXPECT_NEAR(single[r], v[r], 1e-5) << r;
+            EXPECT_NEAR(expected[r], v[r], 1e-3) << r;
+        }
+    }
+}
+
+TEST(MatrixSolve, BatchLU)
+{
+    using matrix5x5 = matrix<double, 5, 5, components::none>;
+    using vector5d  = vector<double, 5, components::none>;
+    std::vector<matrix5x5> as(3);
+    std::vector<vector5d>  bs(3);
+    for (std::size_t i = 0; i < as.size(); ++i) {
+        for (std::size_t r = 0; r < 5; ++r) {
+            as[i][r][r] = r + i + 1;
+            bs[i][r]    = r + i + 1;
+        }
+    }
+    std::vector<vector5d> out(as.size());
+    auto out_view = make_memory_vector_view<vector5d>(out.data()->data(), out.size() * 5);
+    auto b_view   = make_memory_vector_view<vector5d>(static_cast<double const*>(bs.data()->data()),
+                                                    bs.size() * 5);
+    solve(out_view, as, b_view);
+    for (auto const& x : out) {
+        EXPECT_EQ((vector5d{1, 1, 1, 1, 1}), x);
+    }
+}
+
+}    // namespace test
+}    // namespace math
+}    // namespace psst
@@ -165,6 +165,13 @@ TEST(Matrix, IO)
     is >> m2;
     EXPECT_TRUE(is.good());
     EXPECT_EQ(m1, m2) << "Failed to read value from " << os.str();
+
+    col_major_matrix<double, 3, 3> m3;
+    is.clear();
+    is.str(os.str());
+    is >> m3;
+    EXPECT_TRUE(is.good());
+    EXPECT_EQ(m1, m3) << "Failed to read value from " << os.str();
 }
 
 TEST(Matrix, Iteration)
@@ -209,6 +216,96 @@ TEST(Matrix, Add)
     EXPECT_EQ(matrix3x3{}, m1 - m2);
 }
 
+TEST(Matrix, Negate)
+{
+    matrix3x3 const m{{1, -2, 3}, {-4, 5, -6}, {7, -8, 9}};
+    matrix3x3 const expected{{-1, 2, -3}, {4, -5, 6}, {-7, 8, -9}};
+    static_assert(!math::traits::is_matrix_v<decltype(-m)>, "Negation is an expression");
+    static_assert(std::is_same<decltype(-(-m)), matrix3x3 const&>::value,
+                  "Double negation is the argument");
+    EXPECT_EQ(expected, -m);
+    EXPECT_EQ(m, -(-m));
+    EXPECT_EQ(expected * 2, -(m + m));
+}
+
+TEST(Matrix, CompoundAssign)
+{
+    matrix3x3 const a{{1, 2, 3}, {4, 5, 6}, {7, 8, 10}};
+    matrix3x3 const b{{1, 0, 1}, {0, 2, 0}, {1, 0, 3}};
+
+    static_assert(expr::is_elementwise_v<decltype(a + b * 2.0)>);
+    static_assert(expr::is_elementwise_v<decltype(-a - b / 2.0)>);
+    static_assert(!expr::is_elementwise_v<decltype(transpose(a))>);
+    static_assert(!expr::is_elementwise_v<decltype(a * b)>);
+    static_assert(!expr::is_elementwise_v<decltype(a + a * b)>);
+    static_assert(!expr::is_elementwise_v<decltype(a * det(a))>);
+
+    matrix3x3 m{a};
+    m += b;
+    EXPECT_EQ(matrix3x3{a + b}, m);
+    m -= b;
+    EXPECT_EQ(a, m);
+    m *= 2;
+    EXPECT_EQ(matrix3x3{a * 2}, m);
+    m /= 2;
+    EXPECT_EQ(a, m);
+
+    // The right hand side refers to the matrix
+    m += m * 2.0;
+    EXPECT_EQ(matrix3x3{a * 3}, m);
+    m = a;
+    m += transpose(m);
+    EXPECT_EQ(matrix3x3{a + transpose(a)}, m);
+    m = a;
+    m = m * b;
+    EXPECT_EQ(matrix3x3{a * b}, m);
+    m = a;
+    m *= b;
+    EXPECT_EQ(matrix3x3{a * b}, m);
+    m = a;
+    m -= m * det(b);
+    EXPECT_EQ(matrix3x3{a * (1 - det(b))}, m);
+    m = a;
+    m = rotate_cw(m);
+    EXPECT_EQ(matrix3x3{rotate_cw(a)}, m);
+
+    // Different value type and layout
+    col_major_matrix<float, 3, 3> f{a};
+    f += b;
+    EXPECT_EQ((col_major_matrix<float, 3, 3>{a + b}), f);
+    f = -a;
+    EXPECT_EQ((col_major_matrix<float, 3, 3>{a * -1.0}), f);
+}
+
+TEST(Matrix, NoAlias)
+{
+    matrix3x3 const a{{1, 2, 3}, {4, 5, 6}, {7, 8, 10}};
+    matrix3x3 const b{{1, 0, 1}, {0, 2, 0}, {1, 0, 3}};
+    matrix3x3       m;
+    noalias(m) = a * b;
+    EXPECT_EQ(matrix3x3{a * b}, m);
+    noalias(m) += a * b;
+    EXPECT_EQ(matrix3x3{a * b * 2.0}, m);
+    noalias(m) -= a * b;
+    EXPECT_EQ(matrix3x3{a * b}, m);
+    // Element-wise expressions can refer to the matrix
+    noalias(m) += m;
+    EXPECT_EQ(matrix3x3{a * b * 2.0}, m);
+
+    using matrix20x20 = matrix<double, 20, 20>;
+    matrix20x20 l;
+    matrix20x20 r;
+    for (std::size_t i = 0; i < l.rows; ++i) {
+        for (std::size_t j = 0; j < l.cols; ++j) {
+            l[i][j] = static_cast<double>((i + j) % 7) - 3;
+            r[i][j] = static_cast<double>((i * 3 + j) % 5) - 2;
+        }
+    }
+    matrix20x20 big;
+    noalias(big) = l * r;
+    EXPECT_EQ(matrix20x20{l * r}, big);
+}
+
 TEST(Matrix, ScalarMultiply)
 {
     // clang-format off
@@ -269,6 +366,241 @@ TEST(Matrix, MatrixMultiply)
     EXPECT_EQ(expected, mul) << "Invalid result " << mul;
 }
 
+TEST(Matrix, Eval)
+{
+    matrix3x3 m{{1, 2, 3}, {4, 5, 6}, {7, 8, 10}};
+    auto      res = eval(m * m);
+    static_assert((std::is_same<matrix3x3, decltype(res)>::value), "Eval must return a matrix");
+    EXPECT_EQ((matrix3x3{{30, 36, 45}, {66, 81, 102}, {109, 134, 169}}), res);
+}
+
+TEST(Matrix, NestedProduct)
+{
+    matrix3x3 a{{1, 2, 3}, {4, 5, 6}, {7, 8, 10}};
+    matrix3x3 b{{1, 0, 1}, {0, 2, 0}, {1, 0, 3}};
+
+    static_assert(!expr::materialize_product_operand_v<matrix3x3>);
+    static_assert(!expr::materialize_product_operand_v<decltype(a + b)>);
+    static_assert(expr::materialize_product_operand_v<decltype(a * b)>);
+    static_assert(expr::materialize_product_operand_v<decltype(transpose(a * b))>);
+    static_assert(expr::materialize_product_operand_v<decltype(a * b + b)>);
+
+    // The inner product is stored as a matrix
+    auto abc = a * b * a;
+    static_assert((std::is_same<matrix3x3, std::decay_t<decltype(abc.lhs())>>::value),
+                  "Nested product must be materialized");
+    matrix3x3 ab = a * b;
+    EXPECT_EQ(ab * a, abc);
+    EXPECT_EQ(a * (b * a), abc);
+    EXPECT_EQ(ab * ab, a * b * (a * b));
+    EXPECT_EQ(transpose(ab) * a, transpose(a * b) * a);
+
+    vector<double, 3> v{1, 2, 3};
+    EXPECT_EQ(ab * v, a * b * v);
+
+    // Products under expressions with index parameters
+    static_assert(expr::materialize_product_operand_v<decltype(expr::minor<0, 0>(a * b))>);
+    static_assert(
+        expr::materialize_product_operand_v<decltype(expr::as_row_matrix(expr::row<1>(a * b)))>);
+    matrix<double, 2, 2> c{{1, 2}, {3, 4}};
+    auto                 mc = expr::minor<0, 0>(a * b) * c;
+    static_assert((std::is_same<matrix<double, 2, 2>, std::decay_t<decltype(mc.lhs())>>::value),
+                  "Product under a minor must be materialized");
+    EXPECT_EQ((expr::minor<0, 0>(ab) * c), mc);
+}
+
+TEST(Matrix, BlockedProduct)
+{
+    matrix<double, 17, 19> a;
+    matrix<double, 19, 13> b;
+    for (std::size_t r = 0; r < 19; ++r) {
+        for (std::size_t c = 0; c < 17; ++c) {
+            a[c][r] = static_cast<double>((r * 5 + c * 3) % 11) - 5;
+        }
+        for (std::size_t c = 0; c < 13; ++c) {
+            b[r][c] = static_cast<double>((r * 2 + c * 7) % 13) - 6;
+        }
+    }
+    static_assert(expr::use_blocked_product_v<decltype(a * b)>);
+    static_assert(!expr::use_blocked_product_v<decltype(matrix3x3{} * matrix3x3{})>);
+
+    matrix<double, 17, 13> res = a * b;
+    for (std::size_t r = 0; r < 17; ++r) {
+        for (std::size_t c = 0; c < 13; ++c) {
+            double expected = 0;
+            for (std::size_t k = 0; k < 19; ++k) {
+                expected += a[r][k] * b[k][c];
+            }
+            EXPECT_EQ(expected, res[r][c]) << r << ", " << c;
+        }
+    }
+    // Operands that are not matrices are evaluated first
+    EXPECT_EQ(res * 2, eval((a + a) * b));
+    EXPECT_EQ(transpose(res), eval(transpose(b) * transpose(a)));
+
+    // A matrix of a different size is initialized element by element, the
+    // elements outside of the product are zero
+    matrix<double, 20, 16> const large = a * b;
+    matrix<double, 10, 8> const  small = a * b;
+    for (std::size_t r = 0; r < 20; ++r) {
+        for (std::size_t c = 0; c < 16; ++c) {
+            EXPECT_EQ(r < 17 && c < 13 ? res[r][c] : 0.0, large[r][c]) << r << ", " << c;
+            if (r < 10 && c < 8) {
+                EXPECT_EQ(res[r][c], small[r][c]) << r << ", " << c;
+            }
+        }
+    }
+}
+
+TEST(Matrix, Product4x4)
+{
+    using matrix4x4f = matrix<float, 4, 4>;
+    using vector4f   = vector<float, 4>;
+    matrix4x4f a;
+    matrix4x4f b;
+    for (std::size_t r = 0; r < 4; ++r) {
+        for (std::size_t c = 0; c < 4; ++c) {
+            a[r][c] = static_cast<float>(r * 4 + c + 1);
+            b[r][c] = static_cast<float>((r + 1) * (c + 2) % 7) - 3;
+        }
+    }
+    vector4f v{1, -2, 3, 0.5};
+#if defined(PSST_MATH_SIMD_SSE2)
+    static_assert(expr::use_simd_product_v<decltype(a * b)>);
+    static_assert(expr::use_simd_product_v<decltype(a * v)>);
+    static_assert(expr::simd_evaluable_v<decltype(as_vector(a * v))>);
+    static_assert(!expr::use_simd_product_v<decltype(matrix3x3{} * matrix3x3{})>);
+#endif
+
+    matrix4x4f           ab  = a * b;
+    matrix<double, 4, 4> abd = a * b;
+    matrix<float, 4, 1>  av  = a * v;
+    vector4f             avv = as_vector(a * v);
+    for (std::size_t r = 0; r < 4; ++r) {
+        float expected_v = 0;
+        for (std::size_t k = 0; k < 4; ++k) {
+            expected_v += a[r][k] * v[k];
+        }
+        EXPECT_EQ(expected_v, av[r][0]) << r;
+        EXPECT_EQ(expected_v, avv[r]) << r;
+        for (std::size_t c = 0; c < 4; ++c) {
+            float expected = 0;
+            for (std::size_t k = 0; k < 4; ++k) {
+                expected += a[r][k] * b[k][c];
+            }
+            EXPECT_EQ(expected, ab[r][c]) << r << ", " << c;
+            EXPECT_EQ(expected, abd[r][c]) << r << ", " << c;
+        }
+    }
+    // The product as a part of a vector expression
+    vector4f sum = as_vector(a * v) + v;
+    EXPECT_EQ(avv + v, sum);
+    // The operand is replaced with the result
+    a = a * b;
+    EXPECT_EQ(ab, a);
+}
+
+TEST(Matrix, ColumnMajor)
+{
+    using col_matrix3x4 = col_major_matrix<double, 3, 4>;
+    // clang-format off
+    col_matrix3x4 m{
+        { 11, 12, 13, 14 },
+        { 21, 22, 23, 24 },
+        { 31, 32, 33, 34 }
+    };
+    // clang-format on
+    matrix3x4 const rm = m;
+    EXPECT_EQ(rm, m);
+    EXPECT_EQ(m, col_matrix3x4{rm});
+
+    // The storage is by columns, rows are views with a stride
+    double const stored[]{11, 21, 31, 12, 22, 32, 13, 23, 33, 14, 24, 34};
+    EXPECT_TRUE(std::equal(std::begin(stored), std::end(stored), m.data()));
+    EXPECT_EQ(m, col_matrix3x4{stored});
+    EXPECT_EQ(23, m[1][2]);
+    EXPECT_EQ(23, (m.element<1, 2>()));
+    EXPECT_EQ(rm[2], m[2]);
+    EXPECT_EQ((vector<double, 3>{13, 23, 33}), expr::col<2>(m));
+
+    // Expressions of column-major matrices are column-major
+    static_assert(std::is_same<col_matrix3x4, decltype(m + m)::matrix_type>::value);
+    static_assert(std::is_same<col_matrix3x4, decltype(m * 2.0)::matrix_type>::value);
+    static_assert(std::is_same<matrix3x4, decltype(m + rm)::matrix_type>::value);
+    EXPECT_EQ(rm * 2, m * 2 - m + rm);
+
+    m[0][3] = 0;
+    EXPECT_EQ(0, m.data()[9]);
+    m[1] = m[2] * 2;
+    EXPECT_EQ((vector<double, 4>{62, 64, 66, 68}), m[1]);
+    m[2] = m[0];
+    EXPECT_EQ((vector<double, 4>{11, 12, 13, 0}), m[2]);
+    EXPECT_EQ(11, m.data()[2]);
+
+    // clang-format off
+    col_major_matrix<double, 3, 3> sq{
+        { 2, 0, 1 },
+        { 0, 4, 0 },
+        { 1, 0, 1 }
+    };
+    // clang-format on
+    EXPECT_DOUBLE_EQ(4, det(sq));
+    col_major_matrix<double, 3, 3> const inv = inverse(sq);
+    EXPECT_EQ(decltype(sq)::identity(), eval(inv * sq));
+    EXPECT_EQ(inverse(matrix3x3{sq}), inv);
+}
+
+TEST(Matrix, ColumnMajorProduct)
+{
+    using matrix4x4f     = matrix<float, 4, 4>;
+    using col_matrix4x4f = col_major_matrix<float, 4, 4>;
+    using vector4f       = vector<float, 4>;
+    matrix4x4f a;
+    matrix4x4f b;
+    for (std::size_t r = 0; r < 4; ++r) {
+        for (std::size_t c = 0; c < 4; ++c) {
+            a[r][c] = static_cast<float>(r * 4 + c + 1);
+            b[r][c] = static_cast<float>((r + 1) * (c + 2) % 7) - 3;
+        }
+    }
+    col_matrix4x4f const ca = a;
+    col_matrix4x4f const cb = b;
+    vector4f const       v{1, -2, 3, 0.5};
+#if defined(PSST_MATH_SIMD_SSE2)
+    static_assert(expr::use_simd_product_v<decltype(ca * cb)>);
+    static_assert(expr::use_simd_product_v<decltype(ca * v)>);
+    static_assert(!expr::use_simd_product_v<decltype(ca * b)>);
+#endif
+    matrix4x4f const ab = a * b;
+    col_matrix4x4f   cab = ca * cb;
+    EXPECT_EQ(ab, cab);
+    EXPECT_EQ(ab, (matrix4x4f{ca * b}));
+    EXPECT_EQ(as_vector(a * v), as_vector(ca * v));
+    vector4f const cav = as_vector(ca * v);
+    EXPECT_EQ(as_vector(a * v), cav);
+
+    // Blocked product
+    col_major_matrix<double, 17, 19> c;
+    col_major_matrix<double, 19, 13> d;
+    for (std::size_t r = 0; r < 19; ++r) {
+        for (std::size_t col = 0; col < 17; ++col) {
+            c[col][r] = static_cast<double>((r * 5 + col * 3) % 11) - 5;
+        }
+        for (std::size_t col = 0; col < 13; ++col) {
+            d[r][col] = static_cast<double>((r * 2 + col * 7) % 13) - 6;
+        }
+    }
+    static_assert(expr::use_blocked_product_v<decltype(c * d)>);
+    matrix<double, 17, 13> const expected
+        = matrix<double, 17, 19>{c} * matrix<double, 19, 13>{d};
+    col_major_matrix<double, 17, 13> const cd       = c * d;
+    EXPECT_EQ(expected, cd);
+    col_major_matrix<double, 17, 13> const mixed = matrix<double, 17, 19>{c} * d;
+    EXPECT_EQ(expected, mixed);
+    matrix<double, 17, 13> const rcd = c * d;
+    EXPECT_EQ(expected, rcd);
+}
+
 TEST(Matrix, RectMatrixAdd)
 {
     // clang-format off
@@ -321,6 +653,199 @@ TEST(Matrix, Determinant)
         // clang-format on
         EXPECT_EQ(0, det(m));
     }
+    {
+        // clang-format off
+        matrix3x3 m{
+            { 2, -3,  1 },
+            { 2,  0, -1 },
+            { 1,  4,  5 }
+        };
+        // clang-format on
+        EXPECT_EQ(49, det(m));
+        EXPECT_EQ(49, det(transpose(m)));
+        EXPECT_EQ(49 * 49, det(m * m));
+    }
+    {
+        // clang-format off
+        matrix<double, 4, 4> m{
+            { 1,  0,  2, -1 },
+            { 3,  0,  0,  5 },
+            { 2,  1,  4, -3 },
+            { 1,  0,  5,  0 }
+        };
+        matrix<int, 4, 4> mi{
+            { 1,  0,  2, -1 },
+            { 3,  0,  0,  5 },
+            { 2,  1,  4, -3 },
+            { 1,  0,  5,  0 }
+        };
+        // clang-format on
+        EXPECT_EQ(30, det(m));
+        EXPECT_EQ(30, det(mi));
+        EXPECT_EQ(30, det(flip_horizontally(m)));
+    }
+    {
+        // Triangular matrix, the determinant is the product of the diagonal
+        matrix<double, 6, 6> m;
+        for (std::size_t r = 0; r < 6; ++r) {
+            for (std::size_t c = r; c < 6; ++c) {
+                m[r][c] = r + c + 1;
+            }
+        }
+        EXPECT_EQ(1 * 3 * 5 * 7 * 9 * 11, det(m));
+        EXPECT_EQ(-1 * 3 * 5 * 7 * 9 * 11, det(flip_vertically(m)));
+        EXPECT_EQ(0, det(matrix<double, 6, 6>{}));
+    }
+    {
+        // LU and cofactor expansion agree
+        matrix<double, 5, 5> m;
+        matrix<int, 5, 5>    mi;
+        for (std::size_t r = 0; r < 5; ++r) {
+            for (std::size_t c = 0; c < 5; ++c) {
+                mi[r][c] = static_cast<int>((r * 7 + c * 3 + r * c) % 11) - 5;
+                m[r][c]  = mi[r][c];
+            }
+        }
+        EXPECT_NEAR(det(mi).value(), det(m).value(), 1e-9);
+    }
+    {
+        // Numerically singular, the LU pivots are roundoff
+        matrix<double, 5, 5> m;
+        for (std::size_t r = 0; r < 5; ++r) {
+            for (std::size_t c = 0; c < 5; ++c) {
+                m[r][c] = static_cast<double>(r * 5 + c + 1) / 10;
+            }
+        }
+        EXPECT_EQ(0, det(m));
+    }
+    {
+        // The closed forms of the same matrices are zero as well
+        matrix3x3 m3{{.1, .2, .3}, {.4, .5, .6}, {.7, .8, .9}};
+        EXPECT_EQ(0, det(m3).value());
+        matrix<double, 4, 4> m4;
+        for (std::size_t r = 0; r < 4; ++r) {
+            for (std::size_t c = 0; c < 4; ++c) {
+                m4[r][c] = static_cast<double>(r * 4 + c + 1) / 10;
+            }
+        }
+        EXPECT_EQ(0, det(m4).value());
+    }
+    {
+        // Integral determinants are exact, the row maximums are not
+        // multiplied
+        matrix<int, 4, 4> m{{300, 1, 0, 0}, {300, 0, 1, 0}, {300, 0, 0, 1}, {300, 0, 0, 0}};
+        EXPECT_EQ(-300, det(m).value());
+    }
+}
+
+TEST(Matrix, Inverse)
+{
+    {
+        matrix2x2 m{{4, 7}, {2, 6}};
+        EXPECT_EQ((matrix2x2{{0.6, -0.7}, {-0.2, 0.4}}), inverse(m));
+        EXPECT_EQ(matrix2x2::identity(), m * inverse(m));
+    }
+    {
+        matrix3x3 m{{2, -3, 1}, {2, 0, -1}, {1, 4, 5}};
+        EXPECT_EQ(matrix3x3::identity(), m * inverse(m));
+        EXPECT_EQ(matrix3x3::identity(), inverse(m) * m);
+        EXPECT_EQ(m, inverse(inverse(m)));
+        EXPECT_EQ(inverse(transpose(m)), transpose(inverse(m)));
+    }
+    {
+        using matrix4x4 = matrix<double, 4, 4>;
+        matrix4x4 m{{1, 0, 2, -1}, {3, 0, 0, 5}, {2, 1, 4, -3}, {1, 0, 5, 0}};
+        EXPECT_EQ(matrix4x4::identity(), m * inverse(m));
+        EXPECT_EQ(matrix4x4::identity(), inverse(m) * m);
+        EXPECT_EQ(matrix4x4::identity(), inverse(matrix4x4::identity()));
+    }
+    {
+        using matrix6x6 = matrix<double, 6, 6>;
+        matrix6x6 m;
+        for (std::size_t r = 0; r < 6; ++r) {
+            for (std::size_t c = 0; c < 6; ++c) {
+                m[r][c] = r == c ? 10.0 : static_cast<double>((r * 7 + c * 3 + r * c) % 5) - 2;
+            }
+        }
+        EXPECT_EQ(matrix6x6::identity(), m * inverse(m));
+    }
+    EXPECT_THROW(inverse(matrix3x3{{11, 12, 13}, {21, 22, 23}, {31, 32, 33}}),
+                 std::runtime_error);
+    EXPECT_THROW(inverse(matrix<double, 4, 4>{}), std::runtime_error);
+    EXPECT_THROW(inverse(matrix<double, 5, 5>{}), std::runtime_error);
+    EXPECT_THROW(inverse(matrix3x3{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}), std::runtime_error);
+    {
+        // Numerically singular, the Gauss-Jordan pivots are roundoff
+        matrix<double, 5, 5> m;
+        for (std::size_t r = 0; r < 5; ++r) {
+            for (std::size_t c = 0; c < 5; ++c) {
+                m[r][c] = static_cast<double>(r * 5 + c + 1) / 10;
+            }
+        }
+        EXPECT_THROW(inverse(m), std::runtime_error);
+    }
+}
+
+namespace {
+
+template <std::size_t N>
+matrix<double, N, N>
+scaled_row_diagonal()
+{
+    auto m  = matrix<double, N, N>::identity();
+    m[1][1] = 1e-20;
+    return m;
+}
+
+template <std::size_t N>
+void
+check_scaled_row_inverse()
+{
+    auto const m = scaled_row_diagonal<N>();
+    EXPECT_DOUBLE_EQ(1e-20, det(m).value()) << N << "x" << N;
+    auto const inv = inverse(m);
+    EXPECT_DOUBLE_EQ(1e20, inv[1][1]) << N << "x" << N;
+    EXPECT_DOUBLE_EQ(1, inv[0][0]) << N << "x" << N;
+}
+
+}    // namespace
+
+TEST(Matrix, ScaledRowInverse)
+{
+    // A small row is not singular, the closed forms and the LU agree for
+    // all sizes
+    check_scaled_row_inverse<3>();
+    check_scaled_row_inverse<4>();
+    check_scaled_row_inverse<5>();
+    check_scaled_row_inverse<6>();
+}
+
+TEST(Matrix, AffineInverse)
+{
+    using matrix4x4 = matrix<double, 4, 4>;
+    // Rotation by 90 degrees around z and translation
+    // clang-format off
+    matrix4x4 rigid{
+        { 0, -1, 0, 1 },
+        { 1,  0, 0, 2 },
+        { 0,  0, 1, 3 },
+        { 0,  0, 0, 1 }
+    };
+    matrix4x4 affine{
+        { 2, -1, 0, 1 },
+        { 1,  3, 0, 2 },
+        { 0,  0, 4, 3 },
+        { 0,  0, 0, 1 }
+    };
+    // clang-format on
+    EXPECT_EQ(inverse(rigid), rigid_inverse(rigid));
+    EXPECT_EQ(matrix4x4::identity(), rigid * rigid_inverse(rigid));
+    EXPECT_EQ(inverse(affine), affine_inverse(affine));
+    EXPECT_EQ(matrix4x4::identity(), affine * affine_inverse(affine));
+
+    vector<double, 4>    p{1, 1, 1, 1};
+    matrix<double, 4, 1> q = affine * p;
+    EXPECT_EQ(as_col_matrix(p), affine_inverse(affine) * q);
 }
 
 TEST(Matrix, Mutate)
@@ -388,6 +913,103 @@ TEST(Matrix, Mutate)
     EXPECT_EQ(r_180, rotate_180(m)) << "Rotate 180: " << rotate_180(m);
 }
 
+TEST(Matrix, RemapSimplification)
+{
+    matrix3x4 const m{{11, 21, 31, 41}, {12, 22, 32, 42}, {13, 23, 33, 43}};
+
+    // Involutions collapse to the argument
+    static_assert(std::is_same<decltype(transpose(transpose(m))), matrix3x4 const&>::value,
+                  "Double transpose is the argument");
+    static_assert(
+        std::is_same<decltype(flip_horizontally(flip_horizontally(m))), matrix3x4 const&>::value,
+        "Double flip is the argument");
+    static_assert(std::is_same<decltype(rotate_cw(rotate_cw(rotate_cw(rotate_cw(m))))),
+                               matrix3x4 const&>::value,
+                  "Four rotations are the argument");
+    static_assert(std::is_same<decltype(rotate_ccw(rotate_cw(m))), matrix3x4 const&>::value,
+                  "Opposite rotations are the argument");
+    EXPECT_EQ(m, transpose(transpose(m)));
+    EXPECT_EQ(m, flip_secondary(flip_secondary(m)));
+    EXPECT_EQ(m, flip_vertically(flip_vertically(m)));
+    EXPECT_EQ(m, rotate_180(rotate_180(m)));
+    // An rvalue argument is moved out of the expression
+    static_assert(std::is_same<decltype(transpose(transpose(matrix3x4{m}))), matrix3x4>::value,
+                  "Double transpose of a temporary is a value");
+    EXPECT_EQ(m, transpose(transpose(matrix3x4{m})));
+
+    // Other chains compose to a single remap
+    static_assert(std::is_same<std::decay_t<decltype(rotate_cw(rotate_cw(m)))>,
+                               expr::matrix_180_rotate<matrix3x4>>::value,
+                  "Two rotations are a rotation by 180°");
+    static_assert(std::is_same<std::decay_t<decltype(flip_vertically(flip_horizontally(m)))>,
+                               expr::matrix_180_rotate<matrix3x4>>::value,
+                  "Two flips are a rotation by 180°");
+    EXPECT_EQ(rotate_180(m), rotate_cw(rotate_cw(m)));
+    EXPECT_EQ(rotate_ccw(m), rotate_cw(rotate_180(m)));
+
+    // Every composition is the same as evaluating the inner remap
+    EXPECT_EQ(transpose(matrix4x3{rotate_cw(m)}), transpose(rotate_cw(m)));
+    EXPECT_EQ(rotate_cw(matrix4x3{transpose(m)}), rotate_cw(transpose(m)));
+    EXPECT_EQ(flip_secondary(matrix3x4{flip_vertically(m)}), flip_secondary(flip_vertically(m)));
+    EXPECT_EQ(flip_horizontally(matrix4x3{rotate_ccw(m)}), flip_horizontally(rotate_ccw(m)));
+    EXPECT_EQ(rotate_ccw(matrix4x3{flip_secondary(m)}), rotate_ccw(flip_secondary(m)));
+    EXPECT_EQ(flip_vertically(matrix4x3{transpose(m)}), flip_vertically(transpose(m)));
+    EXPECT_EQ(rotate_180(matrix4x3{rotate_ccw(m)}), rotate_180(rotate_ccw(m)));
+}
+
+TEST(Matrix, LoopEvaluation)
+{
+    using matrix20x20   = matrix<double, 20, 20>;
+    using matrix20x20cm = matrix<double, 20, 20, components::none, layout::col_major>;
+    static_assert(matrix20x20::size > expr::unroll_threshold, "The matrix is evaluated in loops");
+
+    matrix20x20 a;
+    matrix20x20 b;
+    for (std::size_t r = 0; r < a.rows; ++r) {
+        for (std::size_t c = 0; c < a.cols; ++c) {
+            a[r][c] = static_cast<double>(r * a.cols + c);
+            b[r][c] = static_cast<double>((r + c) % 7);
+        }
+    }
+    static_assert(expr::matrix_loop_evaluable_v<decltype(a + b * 2.0)>,
+                  "A sum of matrices is evaluated in a loop");
+    static_assert(!expr::matrix_loop_evaluable_v<decltype(transpose(a))>,
+                  "A transposition is evaluated by the unrolled code");
+    matrix20x20 const   sum  = a + b * 2.0;
+    matrix20x20cm const diff = a - b;
+    matrix20x20 const   neg  = -a;
+    for (std::size_t r = 0; r < a.rows; ++r) {
+        for (std::size_t c = 0; c < a.cols; ++c) {
+            EXPECT_EQ(a[r][c] + b[r][c] * 2, sum[r][c]);
+            EXPECT_EQ(a[r][c] - b[r][c], diff.element(r, c));
+            EXPECT_EQ(-a[r][c], neg[r][c]);
+        }
+    }
+    EXPECT_EQ(matrix20x20{transpose(a)}, transpose(a));
+    EXPECT_EQ(matrix20x20::identity(), expr::identity<matrix20x20>());
+
+    constexpr matrix20x20 c(1.0);
+    constexpr matrix20x20 c2 = c + c;
+    static_assert(c2.element(19, 19) == 2);
+    EXPECT_EQ(matrix20x20(2.0), c2);
+    matrix20x20::row_type diag;
+    for (std::size_t i = 0; i < a.rows; ++i) {
+        diag[i] = a[i][i];
+    }
+    EXPECT_EQ(a, lower_triangular(a) + upper_triangular(a) - diagonal(diag));
+
+    EXPECT_EQ(a, a);
+    EXPECT_NE(a, sum);
+    EXPECT_TRUE(a < sum);
+    EXPECT_FALSE(sum < a);
+    EXPECT_EQ(diff, a - b);
+
+    matrix20x20 m{a};
+    m += b;
+    m *= 2.0;
+    EXPECT_EQ(matrix20x20{(a + b) * 2.0}, m);
+}
+
 TEST(Matrix, BinaryIO)
 {
     // clang-format off
@@ -0,0 +1,120 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * padded_vector_tests.cpp
+ *
+ *  Created on: Feb 6, 2019
+ *      Author: ser-fedorov
+ */
+
+#include "test_printing.hpp"
+#include <psst/math/padded_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace psst {
+namespace math {
+namespace test {
+
+using vector3f = vector<float, 3>;
+using padded3f = padded_vector<float, 3>;
+using vector3d = vector<double, 3>;
+using padded3d = padded_vector<double, 3>;
+
+static_assert(sizeof(padded3f) == 16, "Padded vector of 3 floats must occupy 16 bytes");
+static_assert(alignof(padded3f) == 16, "Padded vector of 3 floats must be aligned to 16 bytes");
+static_assert(sizeof(padded3d) == 32, "Padded vector of 3 doubles must occupy 32 bytes");
+static_assert(padded3f::size == 3, "Padding is not a component of a vector");
+static_assert(traits::is_vector_expression_v<padded3f>, "Padded vector is a vector expression");
+#if defined(PSST_MATH_SIMD_SSE2)
+static_assert(expr::simd_evaluable_v<padded3f>);
+static_assert(expr::simd_padded_v<float, 3, padded3f::storage_size, padded3f::alignment>);
+static_assert(expr::simd_padded_v<double, 3, padded3d::storage_size, padded3d::alignment>);
+#endif
+
+TEST(PaddedVector, Construction)
+{
+    padded3f p0;
+    EXPECT_EQ((vector3f{0, 0, 0}), p0);
+
+    padded3f p1{1, 2, 3};
+    EXPECT_EQ(1, p1.x());
+    EXPECT_EQ(2, p1.y());
+    EXPECT_EQ(3, p1.z());
+    EXPECT_EQ(3, std::distance(p1.begin(), p1.end()));
+
+    padded3f p2(5);
+    EXPECT_EQ((vector3f{5, 5, 5}), p2);
+
+    vector3f v{4, 5, 6};
+    padded3f p3 = v;
+    EXPECT_EQ(v, p3);
+    vector3f v1 = p3;
+    EXPECT_EQ(v, v1);
+    EXPECT_EQ(v, p3.value());
+
+    p3.x() = 10;
+    p3[1]  = 20;
+    EXPECT_EQ((vector3f{10, 20, 6}), p3);
+}
+
+TEST(PaddedVector, ConstexprConstruction)
+{
+    constexpr padded3f p0{1, 2, 3};
+    constexpr padded3f p1 = p0 + p0;
+    static_assert(p1[2] == 6);
+    EXPECT_EQ((vector3f{2, 4, 6}), p1);
+}
+
+TEST(PaddedVector, Expressions)
+{
+    padded3f p1{1, 2, 3};
+    padded3f p2{4, 5, 6};
+    vector3f v1{1, 1, 1};
+
+    EXPECT_EQ((vector3f{5, 7, 9}), p1 + p2);
+    EXPECT_EQ((vector3f{0, 1, 2}), p1 - v1);
+    EXPECT_EQ((vector3f{2, 4, 6}), p1 * 2);
+    EXPECT_EQ(32, dot_product(p1, p2));
+    EXPECT_EQ(6, dot_product(p1, v1));
+    EXPECT_EQ((vector3f{1, 2, 3} * vector3f{4, 5, 6}), p1 * p2);
+
+    padded3f res = p1 * p2 + v1;
+    EXPECT_EQ((vector3f{-2, 7, -2}), res);
+
+    // Padding doesn't leak into horizontal operations
+    padded3f p3 = p1 * 2.0f + p2;
+    EXPECT_EQ(6 * 6 + 9 * 9 + 12 * 12, p3.magnitude_square());
+
+    p1 += p2;
+    EXPECT_EQ((vector3f{5, 7, 9}), p1);
+    p1 -= v1;
+    EXPECT_EQ((vector3f{4, 6, 8}), p1);
+    p1 *= 0.5f;
+    EXPECT_EQ((vector3f{2, 3, 4}), p1);
+    p1 /= 2;
+    EXPECT_EQ((vector3f{1, 1.5, 2}), p1);
+
+    padded3d d{3, 0, 4};
+    EXPECT_EQ(5, d.magnitude());
+    d.normalize();
+    EXPECT_EQ((vector3d{0.6, 0, 0.8}), d);
+    EXPECT_EQ((vector3d{-0.6, 0, -0.8}), -d);
+}
+
+TEST(PaddedVector, Array)
+{
+    std::vector<padded3f> points(8, padded3f{1, 2, 3});
+    vector3f              offset{1, 1, 1};
+    for (auto& p : points) {
+        p = p * 2 + offset;
+    }
+    for (auto const& p : points) {
+        EXPECT_EQ((vector3f{3, 5, 7}), p);
+    }
+}
+
+}    // namespace test
+}    // namespace math
+}    // namespace psst
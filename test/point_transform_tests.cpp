@@ -0,0 +1,133 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * point_transform_tests.cpp
+ *
+ *  Created on: Feb 10, 2019
+ *      Author: ser-fedorov
+ */
+
+#include "test_printing.hpp"
+#include <psst/math/point_transform.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace psst {
+namespace math {
+namespace test {
+
+using vector3f   = vector<float, 3>;
+using vector4f   = vector<float, 4>;
+using vector3d   = vector<double, 3>;
+using matrix3x3f = matrix<float, 3, 3>;
+using matrix4x4f = matrix<float, 4, 4>;
+using matrix4x4d = matrix<double, 4, 4>;
+
+namespace {
+
+template <typename Vector>
+auto
+make_view(std::vector<Vector>& v)
+{
+    return make_memory_vector_view<Vector>(v.data()->data(), v.size() * Vector::size);
+}
+
+// Scale by (2, 4, 0.5) and translate by (1, 2, 3)
+// clang-format off
+matrix4x4f const affine{
+    { 2, 0, 0,   1 },
+    { 0, 4, 0,   2 },
+    { 0, 0, 0.5, 3 },
+    { 0, 0, 0,   1 }
+};
+// clang-format on
+
+}    // namespace
+
+TEST(PointTransform, Points)
+{
+    std::vector<vector3f> in{{1, 2, 3}, {0, 0, 0}, {-1, 0.5, 4}};
+    std::vector<vector3f> out(in.size());
+    transform_points(affine, make_view(in), make_view(out));
+    EXPECT_EQ((vector3f{3, 10, 4.5}), out[0]);
+    EXPECT_EQ((vector3f{1, 2, 3}), out[1]);
+    EXPECT_EQ((vector3f{-1, 4, 5}), out[2]);
+
+    // In place
+    transform_points(affine, make_view(in), make_view(in));
+    EXPECT_EQ(out, in);
+
+    std::vector<vector3f> small(1);
+    EXPECT_THROW(transform_points(affine, make_view(in), make_view(small)), std::runtime_error);
+}
+
+TEST(PointTransform, Vectors)
+{
+    std::vector<vector3f> in{{1, 2, 3}, {0, 0, 0}};
+    std::vector<vector3f> out(in.size());
+    transform_vectors(affine, make_view(in), make_view(out));
+    EXPECT_EQ((vector3f{2, 8, 1.5}), out[0]);
+    EXPECT_EQ((vector3f{0, 0, 0}), out[1]);
+
+    // 3x3 matrix
+    matrix3x3f const rotate{{0, -1, 0}, {1, 0, 0}, {0, 0, 1}};
+    transform_points(rotate, make_view(in), make_view(out));
+    EXPECT_EQ((vector3f{-2, 1, 3}), out[0]);
+}
+
+TEST(PointTransform, Homogeneous)
+{
+    std::vector<vector4f> in{{1, 2, 3, 1}, {1, 2, 3, 0}, {1, 2, 3, 2}};
+    std::vector<vector4f> out(in.size());
+    transform_points(affine, make_view(in), make_view(out));
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        vector4f expected = as_vector(affine * in[i]);
+        EXPECT_EQ(expected, out[i]) << i;
+    }
+}
+
+TEST(PointTransform, Normals)
+{
+    // A normal of the plane x + y = 0 stays perpendicular to the plane after
+    // a non-uniform scale
+    std::vector<vector3f> in{{1, 1, 0}};
+    std::vector<vector3f> out(1);
+    transform_normals(affine, make_view(in), make_view(out));
+    EXPECT_EQ((vector3f{0.5, 0.25, 0}), out[0]);
+
+    std::vector<vector3f> tangent{{1, -1, 0}};
+    transform_vectors(affine, make_view(tangent), make_view(tangent));
+    EXPECT_FLOAT_EQ(0, dot_product(out[0], tangent[0]));
+
+    matrix4x4f singular{affine};
+    singular[2][2] = 0;
+    EXPECT_THROW(transform_normals(singular, make_view(in), make_view(out)), std::runtime_error);
+}
+
+TEST(PointTransform, Threads)
+{
+    std::size_t const     count = detail::transform_thread_block_size * 3 + 17;
+    std::vector<vector3d> in(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        in[i] = vector3d{static_cast<double>(i % 101), static_cast<double>(i % 7), -1.5};
+    }
+    matrix4x4d const m{affine};
+
+    std::vector<vector3d> single(count);
+    std::vector<vector3d> multi(count);
+    transform_points(m, make_view(in), make_view(single));
+    transform_points(m, make_view(in), make_view(multi), 4);
+    EXPECT_EQ(single, multi);
+    for (std::size_t i = 0; i < count; i += 1013) {
+        vector3d expected{in[i][0] * 2 + 1, in[i][1] * 4 + 2, in[i][2] * 0.5 + 3};
+        EXPECT_EQ(expected, single[i]) << i;
+    }
+
+    transform_points(m, make_view(in), make_view(in), 0);
+    EXPECT_EQ(single, in);
+}
+
+}    // namespace test
+}    // namespace math
+}    // namespace psst
@@ -54,6 +54,12 @@ TEST(Quat, Normalize)
     EXPECT_EQ((quaternion_d{0.5, 0.5, 0.5, 0.5}), normalize(q1))
         << "Normalized quat " << normalize(q1);
     EXPECT_EQ((quaternion_d{0, -1, 0, 0}), normalize(quaternion_d{0, 1, 0, 0}));
+
+    quaternion_d q2{2, 2, 2, 2};
+    auto         n = normalize(q2);
+    q2             = quaternion_d{0, 0, 0, 0};
+    EXPECT_EQ((quaternion_d{0.5, 0.5, 0.5, 0.5}), n);
+    EXPECT_THROW(normalize(q2), std::runtime_error);
 }
 
 TEST(Quat, ScalarMultiply)
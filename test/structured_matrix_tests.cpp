@@ -0,0 +1,312 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * structured_matrix_tests.cpp
+ *
+ *  Created on: Feb 13, 2019
+ *      Author: ser-fedorov
+ */
+
+#include "test_printing.hpp"
+#include <psst/math/matrix.hpp>
+
+#include <gtest/gtest.h>
+
+namespace psst {
+namespace math {
+namespace test {
+
+using vector3d     = vector<double, 3>;
+using vector4d     = vector<double, 4>;
+using vector4f     = vector<float, 4>;
+using matrix3x3d   = matrix<double, 3, 3>;
+using matrix4x4d   = matrix<double, 4, 4>;
+using matrix4x4f   = matrix<float, 4, 4>;
+using matrix20x20d = matrix<double, 20, 20>;
+
+namespace {
+
+// clang-format off
+matrix4x4d const m{
+    { 1,  2,  3,  4},
+    { 5,  6,  7,  8},
+    { 9, 10, 11, 12},
+    {13, 14, 15, 16}
+};
+// clang-format on
+
+template <typename Expr>
+expr::matrix_structure_t<Expr>
+structure_of(Expr const&)
+{
+    return {};
+}
+
+}    // namespace
+
+TEST(StructuredMatrix, Identity)
+{
+    auto const id = expr::identity<matrix4x4d>();
+    static_assert(std::is_same<std::decay_t<decltype(id * m)>, matrix4x4d>::value,
+                  "A product with the identity is the other operand");
+    static_assert(std::is_same<std::decay_t<decltype(m * id)>, matrix4x4d>::value,
+                  "A product with the identity is the other operand");
+    EXPECT_EQ(m, id * m);
+    EXPECT_EQ(m, m * id);
+    EXPECT_EQ(m * m, id * (m * m));
+    EXPECT_EQ(1, det(id));
+    EXPECT_EQ(matrix4x4d::identity(), inverse(id));
+    // Different value type
+    EXPECT_EQ((matrix4x4d{m}), expr::identity<matrix4x4f>() * m);
+}
+
+TEST(StructuredMatrix, Diagonal)
+{
+    auto const d = diagonal(vector4d{2, 3, 0.5, -1});
+    // clang-format off
+    matrix4x4d const full{
+        {2, 0, 0,    0},
+        {0, 3, 0,    0},
+        {0, 0, 0.5,  0},
+        {0, 0, 0,   -1}
+    };
+    // clang-format on
+    EXPECT_EQ(full, d);
+    EXPECT_EQ(full * m, d * m);
+    EXPECT_EQ(m * full, m * d);
+    EXPECT_EQ((vector4d{2, 6, 1.5, -4}), as_vector(d * vector4d{1, 2, 3, 4}));
+    EXPECT_EQ(full * m * full, d * m * d);
+
+    auto const dd = d * d;
+    static_assert(
+        std::is_same<std::decay_t<decltype(dd)>, expr::diagonal_matrix<matrix4x4d>>::value,
+        "A product of diagonal matrices is diagonal");
+    EXPECT_EQ((vector4d{4, 9, 0.25, 1}), dd.diagonal());
+
+    EXPECT_EQ(-3, det(d));
+    auto const inv = inverse(d);
+    static_assert(std::is_same<decltype(inv), expr::diagonal_matrix<matrix4x4d> const>::value,
+                  "Inverse of a diagonal matrix is diagonal");
+    EXPECT_EQ((vector4d{0.5, 1.0 / 3, 2, -1}), inv.diagonal());
+    EXPECT_EQ(matrix4x4d::identity(), inv * d);
+    EXPECT_THROW(inverse(diagonal(vector3d{1, 0, 1})), std::runtime_error);
+
+    // The diagonal and the full matrix paths agree on the same matrix
+    auto const small = diagonal(vector3d{1, 1e-20, 1});
+    EXPECT_EQ(inverse(matrix3x3d{small}), matrix3x3d{inverse(small)});
+    EXPECT_DOUBLE_EQ(1e20, inverse(small).diagonal()[1]);
+    EXPECT_THROW(inverse(matrix3x3d{diagonal(vector3d{1, 0, 1})}), std::runtime_error);
+    EXPECT_DOUBLE_EQ(1e20, (inverse(matrix<double, 1, 1>{1e-20})[0][0]));
+    EXPECT_THROW(inverse(matrix<double, 1, 1>{0.0}), std::runtime_error);
+}
+
+TEST(StructuredMatrix, Scaling)
+{
+    auto const s = scaling(vector3d{2, 4, 0.5});
+    static_assert(std::decay_t<decltype(s)>::rows == 4, "Homogeneous scaling is 4x4");
+    EXPECT_EQ((vector4d{2, 4, 0.5, 1}), s.diagonal());
+    EXPECT_EQ((vector4d{2, 8, 1.5, 1}), as_vector(s * vector4d{1, 2, 3, 1}));
+    EXPECT_EQ(matrix4x4d{s} * m, s * m);
+    EXPECT_EQ(4, det(s));
+}
+
+TEST(StructuredMatrix, Triangular)
+{
+    auto const l = lower_triangular(m);
+    auto const u = upper_triangular(m);
+    // clang-format off
+    matrix4x4d const lower{
+        { 1,  0,  0,  0},
+        { 5,  6,  0,  0},
+        { 9, 10, 11,  0},
+        {13, 14, 15, 16}
+    };
+    // clang-format on
+    EXPECT_EQ(lower, l);
+    EXPECT_EQ(transpose(lower), upper_triangular(transpose(m)));
+    EXPECT_EQ(m, l + u - diagonal(vector4d{1, 6, 11, 16}));
+
+    EXPECT_EQ(lower * m, l * m);
+    EXPECT_EQ(m * lower, m * l);
+    EXPECT_EQ(lower * matrix4x4d{u}, l * u);
+    EXPECT_EQ(matrix4x4d{u} * lower, u * l);
+    EXPECT_EQ(lower * lower * m, l * l * m);
+
+    namespace structure = expr::structure;
+    EXPECT_TRUE((std::is_same<structure::lower_triangular, decltype(structure_of(l * l))>::value));
+    EXPECT_TRUE((std::is_same<structure::upper_triangular, decltype(structure_of(u * u))>::value));
+    EXPECT_TRUE((std::is_same<structure::general, decltype(structure_of(l * u))>::value));
+
+    EXPECT_EQ(1 * 6 * 11 * 16, det(l));
+    EXPECT_EQ(1 * 6 * 11 * 16, det(u));
+
+    // clang-format off
+    matrix3x3d const t{
+        {2, 0, 0},
+        {1, 4, 0},
+        {3, 2, 8}
+    };
+    // clang-format on
+    auto const inv_l = inverse(lower_triangular(t));
+    EXPECT_TRUE((std::is_same<structure::lower_triangular, decltype(structure_of(inv_l))>::value));
+    EXPECT_EQ(matrix3x3d::identity(), inv_l * t);
+    EXPECT_EQ(inverse(t), inv_l);
+    auto const inv_u = inverse(upper_triangular(transpose(t)));
+    EXPECT_EQ(matrix3x3d::identity(), transpose(t) * inv_u);
+    EXPECT_EQ(transpose(inverse(t)), inv_u);
+    EXPECT_THROW(inverse(lower_triangular(matrix3x3d{})), std::runtime_error);
+}
+
+TEST(StructuredMatrix, LargeTriangular)
+{
+    matrix20x20d a;
+    matrix20x20d b;
+    for (std::size_t r = 0; r < a.rows; ++r) {
+        for (std::size_t c = 0; c < a.cols; ++c) {
+            a[r][c] = static_cast<double>((r * 7 + c * 3) % 11) - 5;
+            b[r][c] = static_cast<double>((r * 5 + c) % 13) - 6;
+        }
+    }
+    matrix20x20d const lower = lower_triangular(a);
+    matrix20x20d const upper = upper_triangular(b);
+    EXPECT_EQ(matrix20x20d{lower * b}, matrix20x20d{lower_triangular(a) * b});
+    EXPECT_EQ(matrix20x20d{lower * upper},
+              matrix20x20d{lower_triangular(a) * upper_triangular(b)});
+}
+
+TEST(StructuredMatrix, Permutation)
+{
+    auto const p = expr::permutation<matrix4x4d>({2, 0, 3, 1});
+    // clang-format off
+    matrix4x4d const full{
+        {0, 0, 1, 0},
+        {1, 0, 0, 0},
+        {0, 0, 0, 1},
+        {0, 1, 0, 0}
+    };
+    // clang-format on
+    EXPECT_EQ(full, p);
+    EXPECT_EQ(full * m, p * m);
+    EXPECT_EQ(m * full, m * p);
+    EXPECT_EQ(m[2], expr::row<0>(p * m));
+    EXPECT_EQ(full * (m + m), p * (m + m));
+    EXPECT_EQ((vector4d{3, 1, 4, 2}), as_vector(p * vector4d{1, 2, 3, 4}));
+
+    auto const pp = p * p;
+    static_assert(
+        std::is_same<std::decay_t<decltype(pp)>, expr::permutation_matrix<matrix4x4d>>::value,
+        "A product of permutations is a permutation");
+    EXPECT_EQ(full * full, pp);
+
+    // A 4-cycle is an odd permutation
+    EXPECT_EQ(-1, det(p));
+    EXPECT_EQ(1, det(pp));
+    EXPECT_EQ(1, det(expr::permutation<matrix4x4d>({0, 1, 2, 3})));
+    EXPECT_EQ(-1, det(expr::permutation<matrix4x4d>({1, 0, 2, 3})));
+
+    EXPECT_EQ(transpose(full), inverse(p));
+    EXPECT_EQ(matrix4x4d::identity(), inverse(p) * p);
+
+    EXPECT_THROW(expr::permutation<matrix4x4d>({0, 1, 1, 2}), std::runtime_error);
+    EXPECT_THROW(expr::permutation<matrix4x4d>({0, 1, 2, 4}), std::runtime_error);
+}
+
+TEST(StructuredMatrix, InverseConversion)
+{
+    // The inverse of a structured matrix is a structured type, it converts to
+    // the inverse of the full matrix
+    auto inv_id = inverse(expr::identity<matrix4x4d>());
+    static_assert(std::is_same<decltype(inv_id), expr::identity_matrix<matrix4x4d>>::value, "");
+    matrix4x4d const id = inv_id;
+    EXPECT_EQ(matrix4x4d::identity(), id);
+
+    auto const d     = diagonal(vector4d{2, 4, 0.5, -1});
+    auto       inv_d = inverse(d);
+    static_assert(std::is_same<decltype(inv_d), expr::diagonal_matrix<matrix4x4d>>::value, "");
+    matrix4x4d const d_full = inv_d;
+    EXPECT_EQ(inverse(matrix4x4d{d}), d_full);
+
+    auto const p     = expr::permutation<matrix4x4d>({2, 0, 3, 1});
+    auto       inv_p = inverse(p);
+    static_assert(std::is_same<decltype(inv_p), expr::permutation_matrix<matrix4x4d>>::value, "");
+    matrix4x4d const p_full = inv_p;
+    EXPECT_EQ(inverse(matrix4x4d{p}), p_full);
+
+    // clang-format off
+    matrix3x3d const t{
+        {2, 0, 0},
+        {1, 4, 0},
+        {3, 2, 8}
+    };
+    // clang-format on
+    auto             inv_l  = inverse(lower_triangular(t));
+    matrix3x3d const l_full = inv_l;
+    EXPECT_EQ(inverse(t), l_full);
+    auto             inv_u  = inverse(upper_triangular(transpose(t)));
+    matrix3x3d const u_full = inv_u;
+    EXPECT_EQ(inverse(matrix3x3d{transpose(t)}), u_full);
+}
+
+TEST(StructuredMatrix, Zero)
+{
+    auto const z = expr::zero<matrix4x4d>();
+    EXPECT_EQ(matrix4x4d{}, z);
+    static_assert(std::is_same<decltype(m + z), matrix4x4d const&>::value,
+                  "A sum with zero is the other operand");
+    static_assert(std::is_same<decltype(z + m), matrix4x4d const&>::value,
+                  "A sum with zero is the other operand");
+    static_assert(std::is_same<decltype(m - z), matrix4x4d const&>::value,
+                  "Subtracting zero is the minuend");
+    EXPECT_EQ(m, m + z);
+    EXPECT_EQ(m, z + m);
+    EXPECT_EQ(m, m - z);
+    EXPECT_EQ(matrix4x4d{m * -1.0}, z - m);
+
+    static_assert(std::is_same<std::decay_t<decltype(z * m)>, expr::zero_matrix<matrix4x4d>>::value,
+                  "A product with zero is zero");
+    static_assert(std::is_same<std::decay_t<decltype(m * z)>, expr::zero_matrix<matrix4x4d>>::value,
+                  "A product with zero is zero");
+    EXPECT_EQ(matrix4x4d{}, m * z);
+    EXPECT_EQ(0, det(z));
+
+    using matrix3x4d = matrix<double, 3, 4>;
+    using matrix4x3d = matrix<double, 4, 3>;
+    static_assert(std::is_same<decltype(transpose(expr::zero<matrix3x4d>())),
+                               expr::zero_matrix<matrix4x3d>>::value,
+                  "Transposed zero is zero");
+    EXPECT_EQ(matrix4x3d{}, transpose(expr::zero<matrix3x4d>()));
+}
+
+TEST(StructuredMatrix, SymmetricRemap)
+{
+    auto const id = expr::identity<matrix4x4d>();
+    auto const d  = diagonal(vector4d{1, 2, 3, 4});
+    static_assert(std::is_same<decltype(transpose(id)), decltype(id) const&>::value,
+                  "Transposed identity is the identity");
+    static_assert(std::is_same<decltype(rotate_180(id)), decltype(id) const&>::value,
+                  "Identity rotated by 180° is the identity");
+    static_assert(std::is_same<decltype(transpose(d)), decltype(d) const&>::value,
+                  "Transposed diagonal is the same matrix");
+    EXPECT_EQ(id, transpose(id));
+    EXPECT_EQ(matrix4x4d{d}, transpose(d));
+    // Flipping the identity is not a no-op
+    EXPECT_EQ(transpose(flip_horizontally(matrix4x4d::identity())), flip_horizontally(id));
+}
+
+TEST(StructuredMatrix, Mixed)
+{
+    auto const d = diagonal(vector4d{1, 2, 3, 4});
+    auto const p = expr::permutation<matrix4x4d>({3, 2, 1, 0});
+    auto const l = lower_triangular(m);
+    EXPECT_EQ(matrix4x4d{d} * matrix4x4d{l}, d * l);
+    EXPECT_EQ(matrix4x4d{p} * matrix4x4d{d}, p * d);
+    EXPECT_EQ(matrix4x4d{l} * matrix4x4d{p}, l * p);
+    EXPECT_EQ(det(matrix4x4d{d * l}), det(d * l));
+
+    matrix4x4f const f{m};
+    EXPECT_EQ(matrix4x4f{diagonal(vector4f{1, 2, 3, 4}) * f},
+              matrix4x4f{matrix4x4f{d} * f});
+}
+
+}    // namespace test
+}    // namespace math
+}    // namespace psst
@@ -0,0 +1,170 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * vector_soa_tests.cpp
+ *
+ *  Created on: Feb 3, 2019
+ *      Author: ser-fedorov
+ */
+
+#include "test_printing.hpp"
+#include <psst/math/vector_soa.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace psst {
+namespace math {
+namespace test {
+
+using vector3f     = vector<float, 3>;
+using vector3f_soa = vector_soa<float, 3>;
+
+TEST(VectorSoa, Construct)
+{
+    {
+        vector3f_soa soa;
+        EXPECT_TRUE(soa.empty());
+        EXPECT_EQ(0, soa.size());
+        EXPECT_EQ(soa.begin(), soa.end());
+    }
+    {
+        vector3f_soa soa(3, vector3f{1, 2, 3});
+        EXPECT_EQ(3, soa.size());
+        for (auto v : soa) {
+            EXPECT_EQ((vector3f{1, 2, 3}), v);
+        }
+        EXPECT_EQ(1, soa.lane<0>()[2]);
+        EXPECT_EQ(2, soa.lane<1>()[2]);
+        EXPECT_EQ(3, soa.lane(2)[2]);
+    }
+    {
+        vector3f_soa soa{{1, 2, 3}, {4, 5, 6}};
+        EXPECT_EQ(2, soa.size());
+        EXPECT_EQ((vector3f{1, 2, 3}), soa[0]);
+        EXPECT_EQ((vector3f{4, 5, 6}), soa[1]);
+    }
+}
+
+TEST(VectorSoa, ElementExpressions)
+{
+    vector3f_soa soa{{1, 2, 3}, {4, 5, 6}};
+    vector3f     sum = soa[0] + soa[1];
+    EXPECT_EQ((vector3f{5, 7, 9}), sum);
+    EXPECT_EQ((vector3f{-3, 6, -3}), soa[0] * soa[1]);
+    EXPECT_EQ(32, dot_product(soa[0], soa[1]));
+
+    soa[0] = soa[0] * 2;
+    EXPECT_EQ((vector3f{2, 4, 6}), soa[0]);
+    soa[1].x() = 42;
+    EXPECT_EQ(42, soa.lane<0>()[1]);
+    // Cross product refers to the target element
+    soa[0] = soa[0] * soa[1];
+    EXPECT_EQ((vector3f{2, 4, 6} * vector3f{42, 5, 6}), soa[0]);
+
+    soa.push_back(soa[1] - vector3f{1, 1, 1});
+    EXPECT_EQ(3, soa.size());
+    EXPECT_EQ((vector3f{41, 4, 5}), soa[2]);
+
+    soa[0] = soa[2];
+    EXPECT_EQ((vector3f{41, 4, 5}), soa[0]);
+    EXPECT_NE(soa.lane<0>(), soa.lane<1>());
+
+    auto const& csoa = soa;
+    EXPECT_EQ((vector3f{41, 4, 5}), csoa[0]);
+    EXPECT_EQ(3, csoa.end() - csoa.begin());
+
+    // Member access through the iterator
+    auto it     = soa.begin() + 1;
+    it->at<0>() = 1;
+    EXPECT_EQ(1, soa.lane<0>()[1]);
+    EXPECT_EQ(4, (csoa.begin() + 2)->at<1>());
+    static_assert(
+        std::is_same<std::iterator_traits<vector3f_soa::iterator>::iterator_category,
+                     std::random_access_iterator_tag>::value,
+        "");
+}
+
+TEST(VectorSoa, IteratorOrdering)
+{
+    vector3f_soa soa{{1, 0, 0}, {2, 0, 0}, {4, 0, 0}, {8, 0, 0}};
+    auto         b = soa.begin();
+    auto         e = soa.end();
+    EXPECT_TRUE(b < e);
+    EXPECT_TRUE(e > b);
+    EXPECT_TRUE(b <= b);
+    EXPECT_TRUE(b >= b);
+    EXPECT_FALSE(e <= b);
+    EXPECT_FALSE(b >= e);
+    EXPECT_TRUE(2 + b == b + 2);
+    EXPECT_EQ(4, (2 + b)->at<0>());
+
+    auto it = std::lower_bound(
+        b, e, 3.0f, [](vector3f_soa::reference v, float x) { return v.x() < x; });
+    EXPECT_EQ(2, it - b);
+    EXPECT_EQ(4, it->at<0>());
+}
+
+TEST(VectorSoa, MemoryViewConversion)
+{
+    std::vector<vector3f> vectors{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+
+    float const* float_const_buf = vectors.data()->data();
+    auto const   float_buf_size  = vector3f::size * vectors.size();
+    auto mem_const_view = make_memory_vector_view<vector3f>(float_const_buf, float_buf_size);
+
+    vector3f_soa soa{mem_const_view};
+    ASSERT_EQ(vectors.size(), soa.size());
+    for (std::size_t i = 0; i < vectors.size(); ++i) {
+        EXPECT_EQ(vectors[i], soa[i]);
+        EXPECT_EQ(vectors[i], mem_const_view[i]);
+    }
+
+    for (auto v : soa) {
+        v = v * 2;
+    }
+
+    std::vector<vector3f> out(vectors.size());
+    auto out_view = make_memory_vector_view<vector3f>(out.data()->data(), float_buf_size);
+    soa.copy_to(out_view);
+    for (std::size_t i = 0; i < vectors.size(); ++i) {
+        EXPECT_EQ(vectors[i] * 2, out[i]);
+    }
+
+    std::vector<vector3f> small(1);
+    EXPECT_THROW(soa.copy_to(make_memory_vector_view<vector3f>(small.data()->data(), 3)),
+                 std::runtime_error);
+}
+
+TEST(VectorSoa, Transform)
+{
+    vector3f_soa a{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    vector3f_soa b(a.size(), vector3f{1, 1, 1});
+    vector3f_soa out(a.size());
+
+    transform(out, [](auto x, auto y) { return x * 2.0f + y; }, a, b);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i] * 2.0f + b[i], out[i]);
+    }
+    // The lanes are written, not only the element references
+    EXPECT_EQ(15, out.lane<0>()[2]);
+    EXPECT_EQ(19, out.lane<2>()[2]);
+
+    // Each component of the cross product refers to the other components of
+    // the output element
+    transform(a, [](auto x, auto y) { return x * y; }, a, b);
+    EXPECT_EQ((vector3f{1, 2, 3} * vector3f{1, 1, 1}), a[0]);
+    EXPECT_EQ((vector3f{7, 8, 9} * vector3f{1, 1, 1}), a[2]);
+
+    vector3f_soa empty;
+    transform(empty, [](auto x) { return x * 2.0f; }, vector3f_soa{});
+    EXPECT_TRUE(empty.empty());
+
+    vector3f_soa small(1);
+    EXPECT_THROW(transform(small, [](auto x) { return x * 2.0f; }, a), std::runtime_error);
+}
+
+}    // namespace test
+}    // namespace math
+}    // namespace psst
@@ -14,6 +14,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <sstream>
 
 namespace psst {
@@ -239,6 +242,10 @@ TEST(Vector, Cross)
 {
     vector3d v1{1, 2, 3}, v2{4, 5, 6};
     EXPECT_EQ((vector3d{-3, 6, -3}), v1 * v2) << "Cross product " << v1 * v2;
+    EXPECT_EQ((vector3d{3, -6, 3}), v2 * v1);
+    EXPECT_EQ((vector3d{0, 0, 1}), (vector3d{1, 0, 0} * vector3d{0, 1, 0}));
+    EXPECT_EQ((vector3d{1, 0, 0}), (vector3d{0, 1, 0} * vector3d{0, 0, 1}));
+    EXPECT_EQ((vector3df{-3, 6, -3}), (vector3df{1, 2, 3} * vector3df{4, 5, 6}));
 }
 
 TEST(Vector, Magnitude)
@@ -256,6 +263,315 @@ TEST(Vector, Expression)
     EXPECT_EQ(expected, res);
 }
 
+TEST(Vector, SimdEvaluation)
+{
+    using vector4f = vector<float, 4>;
+    using vector4d = vector<double, 4>;
+#if defined(PSST_MATH_SIMD_SSE2)
+    static_assert(expr::simd_assignable_v<float, 4, components::xyzw,
+                                          decltype(vector4f{} + vector4f{} * 2)>);
+    static_assert(
+        expr::simd_assignable_v<double, 3, components::xyzw, decltype(vector3d{} * vector3d{})>);
+    static_assert(alignof(vector4f) == 16);
+#endif
+    {
+        vector4f v1{1, 2, 3, 4}, v2{4, 3, 2, 1};
+        EXPECT_EQ((vector4f{5, 5, 5, 5}), v1 + v2);
+        EXPECT_EQ((vector4f{-3, -1, 1, 3}), v1 - v2);
+        EXPECT_EQ((vector4f{10, 9, 8, 7}), (v1 * 2 + v2 * 3 - vector4f(5)) / 2 * 2 + vector4f(1));
+        EXPECT_EQ(20, dot_product(v1, v2));
+    }
+    {
+        vector4d v1{1, 2, 3, 4}, v2{4, 3, 2, 1};
+        EXPECT_EQ((vector4d{5, 5, 5, 5}), v1 + v2);
+        EXPECT_EQ((vector4d{2, 4, 6, 8}), v1 * 2);
+        EXPECT_EQ(20, dot_product(v1, v2));
+        EXPECT_EQ(30, v1.magnitude_square());
+    }
+    {
+        vector3df v1{1, 2, 3}, v2{4, 5, 6};
+        EXPECT_EQ((vector3df{-3, 6, -3}), v1 * v2);
+        EXPECT_EQ(32, dot_product(v1, v2));
+        EXPECT_EQ((vector3df{0.5, 1, 1.5}), v1 / 2);
+    }
+}
+
+TEST(Vector, ConstexprSimdEvaluation)
+{
+    using vector4f = vector<float, 4>;
+    // SIMD assignable expressions are evaluated component-wise in constant
+    // expressions
+    constexpr vector4f  a{1, 2, 3, 4};
+    constexpr vector4f  s = a + a;
+    constexpr vector3df b{1, 2, 3};
+    constexpr vector3df d = b - b;
+    static_assert(s[1] == 4);
+    static_assert(d[2] == 0);
+    EXPECT_EQ((vector4f{2, 4, 6, 8}), s);
+    EXPECT_EQ((vector3df{0, 0, 0}), d);
+    vector4f r = a + s;
+    EXPECT_EQ((vector4f{3, 6, 9, 12}), r);
+}
+
+TEST(Vector, MultiplyAdd)
+{
+    {
+        vector3df a{1, 2, 3}, b{4, 5, 6};
+        float     s = 2;
+        EXPECT_EQ((vector3df{6, 9, 12}), a * s + b);
+        EXPECT_EQ((vector3df{6, 9, 12}), b + a * s);
+        EXPECT_EQ((vector3df{-2, -1, 0}), a * s - b);
+        EXPECT_EQ((vector3df{2, 1, 0}), b - a * s);
+        EXPECT_EQ((vector3df{2.5, 3.5, 4.5}), lerp(a, b, 0.5f));
+        EXPECT_EQ(32, dot_product(a, b));
+        EXPECT_EQ(14, magnitude_square(a));
+    }
+    {
+        // x * x is not representable in a double, fused operations keep the
+        // lowest bits of the product
+        double const x  = 1 + std::ldexp(1.0, -30);
+        double const xx = 1 + std::ldexp(1.0, -29);
+        double const expected
+            = utils::fused_multiply_add_v<double> ? std::ldexp(1.0, -60) : 0.0;
+
+        vector3d a{x, x, x}, b{xx, xx, xx};
+        vector3d res = a * x - b;
+        EXPECT_EQ(expected, res.x());
+        EXPECT_EQ(expected, res.y());
+        EXPECT_EQ(expected, res.z());
+
+        using vector2d = vector<double, 2>;
+        EXPECT_EQ(expected, dot_product(vector2d{1, x}, vector2d{-xx, x}).value());
+        EXPECT_EQ(expected, (-xx + expr::make_scalar_constant(x) * x).value());
+    }
+}
+
+TEST(Vector, Eval)
+{
+    vector3df a{1, 2, 3}, b{4, 5, 6};
+
+    auto dot = eval(dot_product(a, b));
+    static_assert((std::is_same<float, decltype(dot)>::value), "Eval must return a value");
+    EXPECT_EQ(32, dot);
+    auto mag = eval(magnitude(vector3df{3, 0, 4}));
+    static_assert((std::is_same<float, decltype(mag)>::value), "Eval must return a value");
+    EXPECT_EQ(5, mag);
+    auto sum = eval(a + b * 2);
+    static_assert((std::is_same<vector3df, decltype(sum)>::value), "Eval must return a vector");
+    EXPECT_EQ((vector3df{9, 12, 15}), sum);
+
+    // The value of an expression is not cached, an expression can be evaluated
+    // again after it's arguments change
+    auto const expr = dot_product(a, b);
+    EXPECT_EQ(32, expr.value());
+    a = vector3df{0, 0, 0};
+    EXPECT_EQ(0, expr.value());
+    // Value that was used as a "not computed" marker
+    auto const min = std::numeric_limits<float>::min();
+    EXPECT_EQ(min, dot_product(vector3df{min, 0, 0}, vector3df{1, 0, 0}).value());
+}
+
+TEST(Vector, LoopEvaluation)
+{
+    using vector32d = vector<double, 32>;
+    using vector40f = vector<float, 40>;
+    static_assert(vector32d::size > expr::unroll_threshold, "The vector is evaluated in loops");
+
+    vector32d a;
+    vector32d b;
+    for (std::size_t i = 0; i < vector32d::size; ++i) {
+        a[i] = static_cast<double>(i);
+        b[i] = static_cast<double>(i % 5);
+    }
+    static_assert(expr::vector_loop_evaluable_v<decltype(a + b * 2.0)>,
+                  "A sum of vectors is evaluated in a loop");
+    vector32d const sum  = a + b * 2.0;
+    vector32d const diff = a - b / 2.0;
+    for (std::size_t i = 0; i < vector32d::size; ++i) {
+        EXPECT_EQ(a[i] + b[i] * 2, sum[i]);
+        EXPECT_EQ(a[i] - b[i] / 2, diff[i]);
+    }
+    EXPECT_EQ(vector32d(3.0), vector32d(1.0) + vector32d(2.0));
+
+    EXPECT_EQ(a, a);
+    EXPECT_NE(a, sum);
+    EXPECT_TRUE(a < sum);
+    EXPECT_FALSE(sum < a);
+    EXPECT_EQ(0, cmp(a, vector32d{a}));
+
+    // Conversion to a larger vector of another type fills the rest with zeros
+    vector40f const f{sum};
+    EXPECT_EQ(static_cast<float>(sum[31]), f[31]);
+    EXPECT_EQ(0, f[39]);
+
+    // Loop evaluation is usable in constant expressions
+    constexpr vector32d c(2.0);
+    constexpr vector32d c2 = c + c;
+    static_assert(c2[31] == 4);
+    EXPECT_EQ(vector32d(4.0), c2);
+}
+
+TEST(Vector, Reduction)
+{
+    // Sums and products are evaluated as trees, the values are exact here
+    EXPECT_EQ(28, expr::sum(1, 2, 3, 4, 5, 6, 7).value());
+    EXPECT_EQ(5040, expr::product(1, 2, 3, 4, 5, 6, 7).value());
+    EXPECT_EQ(6.5, expr::sum(0.5, 1, 2, 3).value());
+
+    using vector10d = vector<double, 10>;
+    using vector10f = vector<float, 10>;
+    vector10d a;
+    vector10d b;
+    double    expected = 0;
+    for (std::size_t i = 0; i < vector10d::size; ++i) {
+        a[i] = static_cast<double>(i) + 1;
+        b[i] = 10 - static_cast<double>(i) * 3;
+        expected += a[i] * b[i];
+    }
+    EXPECT_EQ(expected, dot_product(a, b));
+    EXPECT_EQ(385, magnitude_square(a));
+    EXPECT_EQ(expected, (dot_product(vector10f{a}, vector10f{b})));
+
+    // Results of different summation orders differ only in rounding
+    double naive = 0;
+    for (std::size_t i = 0; i < vector10d::size; ++i) {
+        a[i] = 1 / (static_cast<double>(i) + 3);
+        b[i] = std::sqrt(static_cast<double>(i) + 2);
+        naive += a[i] * b[i];
+    }
+    EXPECT_DOUBLE_EQ(naive, dot_product(a, b));
+}
+
+TEST(Vector, ElementWise)
+{
+    using vector4f  = vector<float, 4>;
+    using vector4i  = vector<int, 4>;
+    using vector20d = vector<double, 20>;
+#if defined(PSST_MATH_SIMD_SSE2)
+    static_assert(expr::simd_assignable_v<float, 4, components::xyzw,
+                                          decltype(min(vector4f{}, vector4f{}))>);
+    static_assert(expr::simd_assignable_v<double, 3, components::xyzw,
+                                          decltype(clamp(abs(vector3d{}), 0.0, 1.0))>);
+    static_assert(expr::simd_assignable_v<float, 4, components::xyzw,
+                                          decltype(select(vector4f{}, vector4f{}, vector4f{}))>);
+#endif
+    {
+        vector4f const a{1, -2, 3.5, -4.5};
+        vector4f const b{0, 3, 3.5, -5};
+        EXPECT_EQ((vector4f{0, -2, 3.5, -5}), min(a, b));
+        EXPECT_EQ((vector4f{1, 3, 3.5, -4.5}), max(a, b));
+        EXPECT_EQ((vector4f{1, 0, 1, 0}), clamp(a, 0, 1));
+        EXPECT_EQ((vector4f{1, 3, 3, -4.5}), clamp(a, b, 3));
+        EXPECT_EQ((vector4f{1, 2, 3.5, 4.5}), abs(a));
+        EXPECT_EQ((vector4f{1, -2, 3, -5}), floor(a));
+        EXPECT_EQ((vector4f{0, -6, 12.25, 22.5}), hadamard_product(a, b));
+        EXPECT_EQ((vector4f{1, 3, 3.5, -5}), select(vector4f{1, 0, -1, 0}, a, b));
+        EXPECT_EQ((vector4f{2, 2, 3.5, 4.5}), max(abs(a), vector4f{2, 2, 2, 2}) + min(a, b) * 0);
+    }
+    {
+        vector3df const a{-0.5, 1.5, 2};
+        EXPECT_EQ((vector3df{-1, 1, 2}), floor(a));
+        EXPECT_EQ((vector3df{0.5, 1.5, 2}), abs(a));
+        EXPECT_EQ((vector3df{-0.5, 1, 1}), min(a, 1));
+    }
+    {
+        vector3d const a{-0.5, 1.5, 2};
+        EXPECT_EQ((vector3d{-1, 1, 2}), floor(a));
+        EXPECT_EQ((vector3d{0, 1, 1}), clamp(a, 0, 1));
+        EXPECT_EQ((vector3d{-0.5, 3.75, 6}),
+                  select(vector3d{0, 1, 1}, hadamard_product(a, a + vector3d(1)), a));
+    }
+    {
+        vector4i const a{-3, 5, 0, 7};
+        EXPECT_EQ((vector4i{3, 5, 0, 7}), abs(a));
+        EXPECT_EQ((vector4i{-1, 1, 0, 1}), clamp(a, -1, 1));
+        EXPECT_EQ(a, floor(a));
+    }
+    {
+        // Usable in constant expressions
+        constexpr vector<int, 3> a = abs(vector<int, 3>{-1, 2, -3});
+        static_assert(a[0] == 1 && a[1] == 2 && a[2] == 3);
+        constexpr vector3d b = abs(vector3d{-0.5, 0, 2});
+        static_assert(b[0] == 0.5 && b[2] == 2);
+#if defined(PSST_MATH_IS_CONSTANT_EVALUATED)
+        constexpr vector4f f = floor(vector4f{-0.5, 1.5, -2, 1e20f});
+        static_assert(f[0] == -1 && f[1] == 1 && f[2] == -2 && f[3] == 1e20f);
+        EXPECT_EQ((vector4f{-1, 1, -2, 1e20f}), f);
+#endif
+        EXPECT_EQ((vector<int, 3>{1, 2, 3}), a);
+    }
+    {
+        // Evaluated in loops
+        vector20d a;
+        vector20d b;
+        for (std::size_t i = 0; i < vector20d::size; ++i) {
+            a[i] = static_cast<double>(i) - 9.5;
+            b[i] = 10 - static_cast<double>(i);
+        }
+        vector20d const lo  = min(a, b);
+        vector20d const hi  = max(a, b);
+        vector20d const c   = clamp(a, -2, 2);
+        vector20d const f   = floor(abs(a));
+        vector20d const sel = select(hadamard_product(a, b), a, b);
+        for (std::size_t i = 0; i < vector20d::size; ++i) {
+            EXPECT_EQ(std::min(a[i], b[i]), lo[i]);
+            EXPECT_EQ(std::max(a[i], b[i]), hi[i]);
+            EXPECT_EQ(std::clamp(a[i], -2.0, 2.0), c[i]);
+            EXPECT_EQ(std::floor(std::abs(a[i])), f[i]);
+            EXPECT_EQ(a[i] * b[i] != 0 ? a[i] : b[i], sel[i]);
+        }
+    }
+}
+
+TEST(Vector, ComponentReduction)
+{
+    using vector4f  = vector<float, 4>;
+    using vector4i  = vector<int, 4>;
+    using vector20d = vector<double, 20>;
+    {
+        vector4f const v{3, -1, 7, -1};
+        EXPECT_EQ(-1, min_component(v));
+        EXPECT_EQ(7, max_component(v));
+        // The first component if there are several
+        EXPECT_EQ(1u, argmin(v).value());
+        EXPECT_EQ(2u, argmax(v).value());
+        EXPECT_EQ(0u, argmax(vector4f{2, 2, 2, 2}).value());
+        EXPECT_EQ(-2, min_component(v * 2));
+    }
+    {
+        // The unused register lane doesn't affect the result
+        vector3df const v{3, 2, 1};
+        EXPECT_EQ(1, min_component(v));
+        EXPECT_EQ(2u, argmin(v).value());
+        EXPECT_EQ(-1, max_component(v * -1));
+        EXPECT_EQ(2u, argmax(v * -1).value());
+    }
+    {
+        vector3d const v{-2, 5, 5};
+        EXPECT_EQ(-2, min_component(v));
+        EXPECT_EQ(5, max_component(v));
+        EXPECT_EQ(0u, argmin(v).value());
+        EXPECT_EQ(1u, argmax(v).value());
+    }
+    {
+        vector4i const v{4, -8, 15, 15};
+        EXPECT_EQ(-8, min_component(v));
+        EXPECT_EQ(15, max_component(v));
+        EXPECT_EQ(1u, argmin(v).value());
+        EXPECT_EQ(2u, argmax(v).value());
+    }
+    {
+        vector20d v;
+        for (std::size_t i = 0; i < vector20d::size; ++i) {
+            v[i] = static_cast<double>((i * 7) % 20);
+        }
+        EXPECT_EQ(0, min_component(v));
+        EXPECT_EQ(19, max_component(v));
+        EXPECT_EQ(0u, argmin(v).value());
+        EXPECT_EQ(17u, argmax(v).value());
+    }
+}
+
 TEST(Vector, Normalize)
 {
     vector3d v1{10, 0, 0};
@@ -266,6 +582,24 @@ TEST(Vector, Normalize)
                               << " mag_sq=" << v1.magnitude_square();
 }
 
+TEST(Vector, NormalizeExpression)
+{
+    vector3d v1{3, 0, 4};
+    vector3d v2{0, 4, 0};
+    auto     n = normalize(v1 + v2);
+    EXPECT_EQ((vector3d{3, 4, 4} / std::sqrt(41.0)), n);
+    EXPECT_TRUE(vector3d{n}.is_unit());
+    EXPECT_EQ((vector<float, 3>{0.6, 0, 0.8}), normalize(vector<float, 3>{3, 0, 4}));
+
+    // The operand is modified after the normalized vector is built
+    vector3d v3{3, 0, 4};
+    auto     n3 = normalize(v3);
+    v3          = vector3d{0, 10, 0};
+    vector3d r  = n3;
+    EXPECT_EQ((vector3d{0.6, 0, 0.8}), r);
+    EXPECT_TRUE(r.is_unit());
+}
+
 TEST(Vector, Unit)
 {
     {
@@ -0,0 +1,142 @@
+/**
+ * Copyright 2019 Sergei A. Fedorov
+ * vector_transform_tests.cpp
+ *
+ *  Created on: Feb 4, 2019
+ *      Author: ser-fedorov
+ */
+
+#include "test_printing.hpp"
+#include <psst/math/vector_transform.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace psst {
+namespace math {
+namespace test {
+
+using vector3f = vector<float, 3>;
+using vector4f = vector<float, 4>;
+using vector4d = vector<double, 4>;
+
+TEST(VectorTransform, Expression)
+{
+    std::vector<vector3f> a{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    std::vector<vector3f> b{{1, 1, 1}, {2, 2, 2}, {3, 3, 3}};
+    std::vector<vector3f> out(a.size());
+
+    auto const buf_size = vector3f::size * a.size();
+    auto a_view = make_memory_vector_view<vector3f>(a.data()->data(), buf_size);
+    auto b_view
+        = make_memory_vector_view<vector3f>(static_cast<float const*>(b.data()->data()), buf_size);
+    auto out_view = make_memory_vector_view<vector3f>(out.data()->data(), buf_size);
+
+    float s = 2;
+    transform(out_view, [s](auto a, auto b) { return a * s + b; }, a_view, b_view);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i] * s + b[i], out[i]);
+    }
+
+    // In place cross product
+    transform(a_view, [](auto a, auto b) { return a * b; }, a_view, b_view);
+    EXPECT_EQ((vector3f{1, 2, 3} * vector3f{1, 1, 1}), a[0]);
+    EXPECT_EQ((vector3f{4, 5, 6} * vector3f{2, 2, 2}), a[1]);
+    EXPECT_EQ((vector3f{7, 8, 9} * vector3f{3, 3, 3}), a[2]);
+
+    std::vector<vector3f> small(1);
+    EXPECT_THROW(transform(make_memory_vector_view<vector3f>(small.data()->data(), 3),
+                           [](auto a) { return a; }, a_view),
+                 std::runtime_error);
+}
+
+TEST(VectorTransform, Assign)
+{
+    std::vector<vector4d> out(4);
+    auto out_view = make_memory_vector_view<vector4d>(out.data()->data(), out.size() * 4);
+    assign(out_view, vector4d{1, 2, 3, 4} * 2);
+    for (auto const& v : out) {
+        EXPECT_EQ((vector4d{2, 4, 6, 8}), v);
+    }
+    transform(out_view, [](auto v) { return v * -1; }, out_view);
+    for (auto const& v : out) {
+        EXPECT_EQ((vector4d{-2, -4, -6, -8}), v);
+    }
+}
+
+TEST(VectorTransform, InPlaceAlignment)
+{
+    alignas(32) float buffer[17]{};
+    for (auto offset : {0, 1}) {
+        // Aligned to the register and misaligned output buffer
+        auto view = make_memory_vector_view<vector4f>(buffer + offset, 16);
+        assign(view, vector4f{1, 2, 3, 4});
+        transform(view, [](auto v) { return v * 2 + v; }, view);
+        for (auto v : view) {
+            EXPECT_EQ((vector4f{3, 6, 9, 12}), v);
+        }
+    }
+}
+
+TEST(VectorTransform, Normalize)
+{
+    std::vector<vector3f> vecs{{3, 0, 4}, {0, 2, 0}, {1, 1, 1}};
+    normalize(make_memory_vector_view<vector3f>(vecs.data()->data(), vecs.size() * 3));
+    EXPECT_EQ((vector3f{0.6, 0, 0.8}), vecs[0]);
+    EXPECT_EQ((vector3f{0, 1, 0}), vecs[1]);
+    EXPECT_EQ((vector3f{1, 1, 1}.normalize()), vecs[2]);
+    for (auto const& v : vecs) {
+        EXPECT_TRUE(v.is_unit());
+    }
+}
+
+TEST(VectorTransform, Clamp)
+{
+    std::vector<vector4d> vecs{{-1, 0.5, 2, 3}, {1, -2, 0.25, 4}};
+    auto view = make_memory_vector_view<vector4d>(vecs.data()->data(), vecs.size() * 4);
+    clamp(view, 0, 1);
+    EXPECT_EQ((vector4d{0, 0.5, 1, 1}), vecs[0]);
+    EXPECT_EQ((vector4d{1, 0, 0.25, 1}), vecs[1]);
+    clamp(view, vector4d{0.5, 0, 0, 0}, vector4d{1, 1, 1, 0.5});
+    EXPECT_EQ((vector4d{0.5, 0.5, 1, 0.5}), vecs[0]);
+    EXPECT_EQ((vector4d{1, 0, 0.25, 0.5}), vecs[1]);
+}
+
+TEST(VectorTransform, ComponentMinMax)
+{
+    std::vector<vector3f> points{{1, 5, -2}, {-3, 2, 0}, {4, 8, -7}, {0, -1, 3}};
+    auto view = make_memory_vector_view<vector3f>(
+        static_cast<float const*>(points.data()->data()), points.size() * 3);
+    EXPECT_EQ((vector3f{-3, -1, -7}), component_min(view));
+    EXPECT_EQ((vector3f{4, 8, 3}), component_max(view));
+
+    // Blocks of elements and the tail
+    points.insert(points.end(), {{2, 9, 1}, {-5, 0, 0}, {1, 1, 4}});
+    view = make_memory_vector_view<vector3f>(static_cast<float const*>(points.data()->data()),
+                                             points.size() * 3);
+    EXPECT_EQ((vector3f{-5, -1, -7}), component_min(view));
+    EXPECT_EQ((vector3f{4, 9, 4}), component_max(view));
+
+    auto first = make_memory_vector_view<vector3f>(points.data()->data(), 3);
+    EXPECT_EQ(points[0], component_min(first));
+    EXPECT_THROW(component_max(make_memory_vector_view<vector3f>(points.data()->data(), 0)),
+                 std::runtime_error);
+}
+
+TEST(VectorTransform, ReduceNotIdempotent)
+{
+    // Every element is folded exactly once, whatever the number of elements
+    std::vector<vector3f> points;
+    for (std::size_t n = 1; n <= 11; ++n) {
+        points.push_back(vector3f{1, 2, 3} * static_cast<float>(n));
+        auto view = make_memory_vector_view<vector3f>(
+            static_cast<float const*>(points.data()->data()), points.size() * 3);
+        auto const sum = static_cast<float>(n * (n + 1) / 2);
+        EXPECT_EQ((vector3f{1, 2, 3} * sum), detail::reduce_buffer(view, std::plus<>{})) << n;
+    }
+}
+
+}    // namespace test
+}    // namespace math
+}    // namespace psst
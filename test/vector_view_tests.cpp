@@ -7,16 +7,26 @@
  */
 
 #include "test_printing.hpp"
+#include <psst/math/matrix.hpp>
 #include <psst/math/vector.hpp>
 #include <psst/math/vector_view.hpp>
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
 #include <sstream>
 #include <vector>
 
 namespace psst {
 namespace math {
+
+// The value type is not used by other tests, a specialization changes the
+// layout of the type and must be visible wherever the type is used
+template <>
+struct alignment_policy<vector<std::int16_t, 4>> : utils::size_constant<8> {};
+template <>
+struct alignment_policy<matrix<std::int16_t, 2, 2>> : utils::size_constant<64> {};
+
 namespace test {
 
 using vector3d            = vector<double, 3>;
@@ -168,7 +178,72 @@ TEST(VectorView, AccessBuffers)
             EXPECT_EQ(42, vectors[i].y());
             ++i;
         }
+
+        // Member access through the iterator
+        auto it = mem_view.begin() + 1;
+        it->x() = 24;
+        EXPECT_EQ(24, vectors[1].x());
+    }
+}
+
+TEST(VectorView, AlignmentPolicy)
+{
+    using vector4s   = vector<std::int16_t, 4>;
+    using matrix2x2s = matrix<std::int16_t, 2, 2>;
+    static_assert(vector4s::alignment == 8);
+    static_assert(alignof(vector4s) == 8);
+    static_assert(sizeof(vector4s) == sizeof(std::int16_t) * 4);
+    static_assert(matrix2x2s::alignment == 64);
+    static_assert(alignof(matrix2x2s) == 64);
+    static_assert(alignof(vector<std::int16_t, 3>) == alignof(std::int16_t));
+
+    std::vector<vector4s> vectors{{1, 2, 3, 4}, {5, 6, 7, 8}};
+    EXPECT_TRUE(utils::is_aligned(vectors.data(), 8));
+
+    matrix2x2s m{{1, 2}, {3, 4}};
+    EXPECT_EQ(64, utils::pointer_alignment(m.data()));
+    EXPECT_EQ(m, (matrix2x2s{{1, 2}, {3, 4}}));
+}
+
+TEST(VectorView, AlignmentDetection)
+{
+    alignas(64) float buffer[16]{};
+
+    EXPECT_EQ(64, utils::pointer_alignment(buffer));
+    EXPECT_EQ(4, utils::pointer_alignment(buffer + 1));
+    EXPECT_EQ(8, utils::pointer_alignment(buffer + 2));
+    EXPECT_EQ(16, utils::pointer_alignment(buffer + 4));
+
+    EXPECT_EQ(16, (make_vector_view<vector<float, 4>>(buffer + 4).alignment()));
+
+    {
+        auto mem_view = make_memory_vector_view<vector<float, 4>>(buffer, 16);
+        EXPECT_EQ(16, mem_view.alignment());
+        EXPECT_TRUE(mem_view.is_aligned(16));
+        EXPECT_FALSE(mem_view.is_aligned(32));
     }
+    {
+        auto mem_view = make_memory_vector_view<vector<float, 4>>(buffer + 1, 12);
+        EXPECT_EQ(4, mem_view.alignment());
+        EXPECT_FALSE(mem_view.is_aligned(16));
+    }
+    {
+        // Stride of 12 bytes, only the first element is aligned to 16 bytes
+        auto mem_view = make_memory_vector_view<vector<float, 3>>(buffer, 12);
+        EXPECT_EQ(4, mem_view.alignment());
+    }
+}
+
+namespace {
+alignas(64) float static_buffer[16]{};
+}    // namespace
+
+TEST(VectorView, ConstexprMemoryView)
+{
+    constexpr auto mem_view = make_memory_vector_view<vector<float, 4>>(static_buffer, 16);
+    static_assert(mem_view.size() == 4, "");
+    static_assert(mem_view.data() == static_buffer, "");
+    EXPECT_EQ(16, mem_view.alignment());
 }
 
 }    // namespace test